@@ -27,12 +27,22 @@
 // level direction or so.
 typedef std::vector<std::pair<std::string, std::string>> notif_list_t;
 
+// Completion callback of a transfer, called with the final status of the transfer
+typedef void (*nixl_xfer_cb_t)(void* arg, nixl_status_t status);
 
 class nixlBackendOptionalArgs {
     public:
         // During postXfer, user might ask for a notification if supported
         nixl_blob_t notifMsg;
         bool        hasNotif = false;
+
+        // During postXfer, if supportsXferCb() is true, agent might ask to be called
+        // back when a transfer that returned NIXL_IN_PROG is completed
+        nixl_xfer_cb_t xferCb    = nullptr;
+        void*          xferCbArg = nullptr;
+
+        // During prepXfer, the completion semantics asked for the transfer
+        nixl_xfer_compl_t completion = nixl_xfer_compl_t::NIXL_XFER_COMPL_DEFAULT;
 };
 
 typedef nixlBackendOptionalArgs nixl_opt_b_args_t;
@@ -111,4 +121,19 @@ class nixlMetaDesc : public nixlBasicDesc {
 
 typedef nixlDescList<nixlMetaDesc> nixl_meta_dlist_t;
 
+// Arguments of a single transfer within a batched backend call, same as the ones
+// passed to postXfer/checkXfer. The backend sets the status of each element.
+class nixlBackendXferArgs {
+    public:
+        nixl_xfer_op_t           operation;
+        const nixl_meta_dlist_t* local       = nullptr;
+        const nixl_meta_dlist_t* remote      = nullptr;
+        const std::string*       remoteAgent = nullptr;
+        nixlBackendReqH*         handle      = nullptr;
+        const nixl_opt_b_args_t* optArgs     = nullptr;
+        nixl_status_t            status      = NIXL_ERR_NOT_POSTED;
+};
+
+typedef std::vector<nixlBackendXferArgs> nixl_xfer_batch_t;
+
 #endif
@@ -85,8 +85,39 @@ class nixlBackendEngine {
         // Determines if a backend supports progress thread.
         virtual bool supportsProgTh () const = 0;
 
+        // Determines if prepXfer/postXfer/checkXfer/releaseReqH and getNotifs can be called
+        // concurrently from different threads for different requests. If not, the agent
+        // serializes these calls per engine when it is in NIXL_THREAD_SYNC_STRICT mode.
+        virtual bool supportsConcurrentXfer () const { return false; }
+
+        // Determines if registerMem, loadLocalMD and getPublicData, and deregisterMem and
+        // unloadMD on error, can be called concurrently from different threads for different
+        // descriptors. If so, the agent spreads the descriptors of a registerMem call over
+        // the regThreads of its config.
+        virtual bool supportsConcurrentReg () const { return false; }
+
+        // Determines if a backend can report completion of transfers through xferCb of
+        // the opt_args passed to postXfer. If so, the callback is called exactly once for
+        // each post that returned NIXL_IN_PROG, possibly from a backend thread and even
+        // before postXfer returns. The agent doesn't call checkXfer or releaseReqH for such
+        // transfers until the callback is called, and the handle might be reposted or
+        // released within the callback, so backend locks shouldn't be held while calling it.
+        virtual bool supportsXferCb () const { return false; }
+
+        // Relative transfer capacity of the backend, e.g., its number of rails, which is
+        // used to weight its share when a transfer is striped across several backends.
+        virtual uint64_t getStripeWeight () const { return 1; }
+
+        // Max descriptor size the backend handles efficiently, 0 for no limit. Longer
+        // descriptors are split by the agent at this size before prepXfer is called.
+        virtual size_t getChunkSize () const { return 0; }
+
         virtual nixl_mem_list_t getSupportedMems () const = 0;
 
+        // Backend specific counters, reported by getAgentStats prefixed with
+        // "backend.<type>.". Can be called concurrently with any other method.
+        virtual void getStats (nixl_stats_t &stats) const { }
+
 
         // *** Pure virtual methods that need to be implemented by any backend *** //
 
@@ -129,6 +160,23 @@ class nixlBackendEngine {
         //Backend aborts the transfer if necessary, and destructs the relevant objects
         virtual nixl_status_t releaseReqH(nixlBackendReqH* handle) = 0;
 
+        // Batched versions of postXfer and checkXfer, where the agent groups the requests of
+        // a batch per engine. The status of each transfer is set in its element, and return
+        // value is only for errors of the call itself. Backends can override them to amortize
+        // the per call costs, by default they loop over the single request methods.
+        virtual nixl_status_t postXferBatch(nixl_xfer_batch_t &batch) {
+            for (auto &elm : batch)
+                elm.status = postXfer(elm.operation, *elm.local, *elm.remote,
+                                      *elm.remoteAgent, elm.handle, elm.optArgs);
+            return NIXL_SUCCESS;
+        }
+
+        virtual nixl_status_t checkXferBatch(nixl_xfer_batch_t &batch) {
+            for (auto &elm : batch)
+                elm.status = checkXfer(elm.handle);
+            return NIXL_SUCCESS;
+        }
+
 
         // *** Needs to be implemented if supportsRemote() is true *** //
 
@@ -129,6 +129,50 @@ class nixlAgent {
         deregisterMem (const nixl_reg_dlist_t &descs,
                        const nixl_opt_args_t* extra_params = nullptr);
 
+        /**
+         * @brief  Register a memory/storage with NIXL without blocking, as registerMem does.
+         *         The descriptors are registered in the background in batches, and each batch
+         *         can be used in transfers and is part of the local metadata as soon as it is
+         *         registered. If the registration fails, the descriptors already registered
+         *         by it are deregistered. The handle should be released by releaseRegH.
+         *         As the registration runs alongside the other calls, the agent has to be in
+         *         the NIXL_THREAD_SYNC_STRICT mode.
+         *
+         * @param  descs         Descriptor list of the buffers to be registered
+         * @param  reg_hndl[out] Handle to track the registration
+         * @param  extra_params  Optional additional parameters used in registering memory
+         * @return nixl_status_t NIXL_IN_PROG if the registration was started,
+         *                       NIXL_ERR_NOT_ALLOWED in other thread sync modes
+         */
+        nixl_status_t
+        registerMemAsync (const nixl_reg_dlist_t &descs,
+                          nixlRegH* &reg_hndl,
+                          const nixl_opt_args_t* extra_params = nullptr);
+
+        /**
+         * @brief  Get the status of a registration started by registerMemAsync.
+         *
+         * @param  reg_hndl      Handle of the registration
+         * @param  wait          Block until the registration is done
+         * @param  registered    Optional number of descriptors registered so far
+         * @return nixl_status_t NIXL_IN_PROG while in progress, otherwise the result,
+         *                       same as registerMem
+         */
+        nixl_status_t
+        getRegStatus (nixlRegH* reg_hndl,
+                      const bool wait = false,
+                      int* registered = nullptr) const;
+
+        /**
+         * @brief  Release a registration handle, waiting for the registration to finish.
+         *         Its descriptors stay registered, until deregisterMem is called.
+         *
+         * @param  reg_hndl      Handle of the registration
+         * @return nixl_status_t Result of the registration
+         */
+        nixl_status_t
+        releaseRegH (nixlRegH* reg_hndl);
+
         /**
          * @brief  Make connection proactively, instead of at the time of the first transfer
          *         towards the target agent. If a list of backends hints is provided
@@ -192,6 +236,28 @@ class nixlAgent {
                      const std::vector<int> &remote_indices,
                      nixlXferReqH* &req_hndl,
                      const nixl_opt_args_t* extra_params = nullptr) const;
+        /**
+         * @brief  Same as makeXferReq with indices lists, where the indices are given as
+         *         ranges, e.g., blocks [a, a+n) at stride s. Bounds are validated per range,
+         *         and consecutive descriptors are merged without expanding the indices.
+         *
+         * @param  operation        Operation for transfer (e.g., NIXL_WRITE)
+         * @param  local_side       Local prepared descriptor list handle
+         * @param  local_ranges     Index ranges to the local prepared descriptor list handle
+         * @param  remote_side      Remote (or loopback) prepared descriptor list handle
+         * @param  remote_ranges    Index ranges to the remote prepared descriptor list handle
+         * @param  req_handle [out] Transfer request handle output
+         * @param  extra_params     Optional additional parameters used in making a transfer request
+         * @return nixl_status_t    Error code if call was not successful
+         */
+        nixl_status_t
+        makeXferReq (const nixl_xfer_op_t &operation,
+                     const nixlDlistH* local_side,
+                     const nixl_idx_ranges_t &local_ranges,
+                     const nixlDlistH* remote_side,
+                     const nixl_idx_ranges_t &remote_ranges,
+                     nixlXferReqH* &req_hndl,
+                     const nixl_opt_args_t* extra_params = nullptr) const;
         /**
          * @brief  A combined API, to create a transfer request from two descriptor lists.
          *         NIXL will prepare each side and create a transfer handle `req_hndl`.
@@ -237,7 +303,8 @@ class nixlAgent {
          *         In case of small transfers that are completed within the call, return value
          *         will be NIXL_SUCCESS. Otherwise, the output status will be NIXL_IN_PROG until
          *         completion. Notification  message  can be preovided through the extra_params,
-         *         and can be updated per re-post.
+         *         and can be updated per re-post. Instead of checking the status, completion can
+         *         be reported to a completion queue or callback given in extra_params.
          *
          * @param  req_hndl      Transfer request handle obtained from makeXferReq/createXferReq
          * @param  extra_params  Optional extra parameters used in posting a transfer request
@@ -258,7 +325,8 @@ class nixlAgent {
 
         /**
          * @brief  Query the backend associated with `req_hndl`. E.g., if for genNotif
-         *         the same backend as a transfer is desired.
+         *         the same backend as a transfer is desired, or to see the choice of
+         *         the backend selection policy of the agent config.
          *
          * @param  req_hndl      Transfer request handle obtained from makeXferReq/createXferReq
          * @param  backend [out] Output backend handle chosen for the transfer request
@@ -278,6 +346,117 @@ class nixlAgent {
         nixl_status_t
         releaseXferReq (nixlXferReqH* req_hndl);
 
+        /**
+         * @brief  Submit a batch of transfer requests in a single call. Requests are grouped
+         *         per backend, so each backend is called once for its part of the batch.
+         *         As in postXferReq, a notification in extra_params replaces the one of
+         *         each request, and extra_params without one clears it. Without
+         *         extra_params, the one set at creation or the last post is kept.
+         *         The request handles are not released on errors.
+         *
+         * @param  req_hndls     Transfer request handles obtained from makeXferReq/createXferReq
+         * @param  status [out]  Status of each request, same as postXferReq would return
+         * @param  extra_params  Optional extra parameters used in posting the transfer requests
+         * @return nixl_status_t First error code among the requests if any, otherwise
+         *                       NIXL_IN_PROG if any request is in progress, or NIXL_SUCCESS
+         */
+        nixl_status_t
+        postXferReqBatch (const std::vector<nixlXferReqH*> &req_hndls,
+                          std::vector<nixl_status_t> &status,
+                          const nixl_opt_args_t* extra_params = nullptr) const;
+
+        /**
+         * @brief  Check the status of a batch of transfer requests in a single call.
+         *
+         * @param  req_hndls     Transfer request handles after postXferReq/postXferReqBatch
+         * @param  status [out]  Status of each request, same as getXferStatus would return
+         * @return nixl_status_t First error code among the requests if any, otherwise
+         *                       NIXL_IN_PROG if any request is in progress, or NIXL_SUCCESS
+         */
+        nixl_status_t
+        getXferStatusBatch (const std::vector<nixlXferReqH*> &req_hndls,
+                            std::vector<nixl_status_t> &status);
+
+        /**
+         * @brief  Release a batch of transfer requests, same as calling releaseXferReq on
+         *         each of them. Requests that cannot be released are left untouched.
+         *
+         * @param  req_hndls     Transfer request handles to be released
+         * @return nixl_status_t First error code among the requests if any
+         */
+        nixl_status_t
+        releaseXferReqBatch (const std::vector<nixlXferReqH*> &req_hndls);
+
+        /**
+         * @brief  Check the posted transfer requests with a completion callback, on backends
+         *         that don't report completions from their own thread, and call the callback
+         *         of the ones that are done. Should be called periodically if such requests
+         *         are used, e.g., backends without a progress thread.
+         *
+         * @return nixl_status_t NIXL_IN_PROG if such requests are still in progress,
+         *                       NIXL_SUCCESS if there are none left, or error code
+         */
+        nixl_status_t
+        progressXfers ();
+
+        /*** Completion queues of transfer requests ***/
+
+        /**
+         * @brief  Create a completion queue. Transfer requests are associated with it by
+         *         passing it in extra_params of postXferReq/postXferReqBatch, and once they
+         *         are done they can be retrieved in bulk through pollXferCQ. While a request
+         *         is associated with a queue, getXferStatus does not check the backend and
+         *         returns the last known status, and the request cannot be reposted or
+         *         released until it is returned by pollXferCQ. Completion callbacks that
+         *         are given through extra_params->completionCb follow the same rules, until
+         *         they're called.
+         *
+         * @param  cq [out]      Completion queue handle
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        createXferCQ (nixlXferCQ* &cq) const;
+
+        /**
+         * @brief  Release a completion queue. Fails if requests are still associated with it.
+         *
+         * @param  cq            Completion queue handle to be released
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        releaseXferCQ (nixlXferCQ* cq);
+
+        /**
+         * @brief  Get an eventfd for the completion queue, to be used in a poll/epoll loop.
+         *         It is readable while there are done requests to be retrieved. Requests
+         *         on backends without completion callbacks are only found done by
+         *         pollXferCQ, so while there are such requests the loop should also call
+         *         it periodically, e.g., on a wait timeout. Reading it is done by
+         *         pollXferCQ, the user should only wait on it.
+         *
+         * @param  cq            Completion queue handle
+         * @param  fd [out]      File descriptor of the completion queue
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getXferCQFd (const nixlXferCQ* cq, int &fd) const;
+
+        /**
+         * @brief  Retrieve the requests of the completion queue that are done, successfully
+         *         or with an error. Their status can be read with getXferStatus, and they are
+         *         no longer associated with the queue.
+         *
+         * @param  cq              Completion queue handle
+         * @param  req_hndls [out] Requests that are done, appended to the vector
+         * @param  max_reqs        Maximum number of requests to return, 0 for no limit
+         * @return nixl_status_t   NIXL_SUCCESS if any request is returned, NIXL_IN_PROG
+         *                         if none is done yet, or error code
+         */
+        nixl_status_t
+        pollXferCQ (nixlXferCQ* cq,
+                    std::vector<nixlXferReqH*> &req_hndls,
+                    const size_t max_reqs = 0);
+
         /**
          * @brief  Release the prepared descriptor list handle `dlist_hndl`
          *
@@ -331,6 +510,32 @@ class nixlAgent {
         nixl_status_t
         getLocalMD (nixl_blob_t &str) const;
 
+        /**
+         * @brief  Get the changes to the metadata of this agent since a generation, to be
+         *         given to agents that already loaded that generation. The registrations
+         *         removed and added since then are included, and loadRemoteMD applies them
+         *         to the metadata loaded before. If the changes since `since_gen` are no
+         *         longer kept, e.g. after creating a backend, the full metadata is given
+         *         as a reset record, which replaces the metadata loaded before.
+         *
+         * @param  since_gen     Generation the other agent has, from getRemoteMDGen
+         * @param  str [out]     The serialized metadata blob
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getLocalMDDelta (const uint64_t since_gen, nixl_blob_t &str) const;
+
+        /**
+         * @brief  Get the generation of the metadata loaded from a remote agent, to ask
+         *         it for the changes since then through getLocalMDDelta.
+         *
+         * @param  remote_agent  Remote agent name as string
+         * @param  gen [out]     Generation of the loaded metadata
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getRemoteMDGen (const std::string &remote_agent, uint64_t &gen) const;
+
         /**
          * @brief  Get partial metadata blob for this agent, to be given to other agents.
          *         If `descs` is empty, only backends' connection info is included in the metadata,
@@ -353,7 +558,11 @@ class nixlAgent {
 
         /**
          * @brief  Load other agent's metadata and unpack it internally. Now the local
-         *         agent can initiate transfers towards the remote agent.
+         *         agent can initiate transfers towards the remote agent. Loading the same
+         *         blob as the last one from that agent returns right away. A blob from
+         *         getLocalMDDelta is applied to the loaded metadata, and NIXL_ERR_MISMATCH
+         *         is returned if that's not the generation it was made from. A reset record
+         *         from getLocalMDDelta replaces the loaded metadata.
          *
          * @param  remote_metadata  Serialized metadata blob to be loaded
          * @param  agent_name [out] Agent name extracted from the loaded metadata blob
@@ -363,6 +572,18 @@ class nixlAgent {
         loadRemoteMD (const nixl_blob_t &remote_metadata,
                       std::string &agent_name);
 
+        /**
+         * @brief  Wait for the background thread of preResolveRemoteMD to load the metadata
+         *         of the agents loaded so far. Entries it fails to load are left for their
+         *         first use in a transfer, which reports the error.
+         *
+         * @param  timeout_us    Max time to wait, in us
+         * @return nixl_status_t NIXL_IN_PROG on timeout, NIXL_ERR_NOT_SUPPORTED if the
+         *                       background thread is not used
+         */
+        nixl_status_t
+        waitRemoteMDResolved (const uint64_t timeout_us) const;
+
         /**
          * @brief  Invalidate the remote agent metadata cached locally. This will
          *         disconnect from that agent if already connected, and no more
@@ -449,6 +670,19 @@ class nixlAgent {
         checkRemoteMD (const std::string remote_name,
                        const nixl_xfer_dlist_t &descs) const;
 
+        /**
+         * @brief  Get internal counters of the agent, such as the hits and misses of the
+         *         transfer request pool. Counters are cumulative from agent creation.
+         *         Backend selection reports the requests created on each backend, and
+         *         with the cost policy the measured model per backend and remote agent:
+         *         "xfer_cost.<backend>.<agent>.samples/desc_ns/bytes_per_us".
+         *
+         * @param  stats [out]   Map of counter names to their values
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getAgentStats (nixl_stats_t &stats) const;
+
 };
 
 #endif
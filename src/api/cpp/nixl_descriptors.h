@@ -294,6 +294,18 @@ class nixlDescList {
          * @brief Empty the descriptors list
          */
         inline void clear() { descs.clear(); }
+        /**
+         * @brief Empty the descriptors list and set its memory type and sorted flag,
+         *        while keeping the allocated storage to be reused.
+         *
+         * @param type   NIXL memory type of descriptor list
+         * @param sorted Flag to set sorted option (default = false)
+         */
+        inline void reset(const nixl_mem_t &type, const bool &sorted=false) {
+            this->type   = type;
+            this->sorted = sorted;
+            descs.clear();
+        }
         /**
          * @brief     Add Descriptors to descriptor list
          *               If nixlDescList object is sorted, this method keeps it sorted
@@ -54,6 +54,64 @@ class nixlAgentConfig {
          *      These will be combined into a unified NIXL Thread API in a future version.
          */
         uint64_t lthrDelay;
+        /**
+         * @var Policy to choose the backend of a transfer, among the ones that can carry it,
+         *      in createXferReq and makeXferReq. The backends option limits the candidates.
+         */
+        nixl_backend_select_t backendSelect;
+        /**
+         * @var Max bytes in flight of each transfer priority class while transfers of a
+         *      higher class are in flight or held, 0 to disable. Posts over the limit are
+         *      held by the agent and return NIXL_IN_PROG, they are issued from the later
+         *      datapath calls, i.e., posts, status checks, queue polls and progressXfers.
+         */
+        uint64_t prioHoldBytes;
+        /**
+         * @var Max bytes and requests in flight to each remote agent, and in total, 0 for
+         *      no limit. Posts over a limit are held like the ones of prioHoldBytes, and a
+         *      post is always admitted when nothing is in flight to its agent or in total.
+         */
+        uint64_t remoteMaxBytes;
+        uint64_t remoteMaxReqs;
+        uint64_t totalMaxBytes;
+        uint64_t totalMaxReqs;
+        /**
+         * @var Max number of transfer plans cached by createXferReq, 0 to disable. A plan
+         *      keeps the backend and populated descriptors of a pair of descriptor lists
+         *      to a remote agent, and is dropped on deregisterMem, createBackend and when
+         *      the metadata of the remote agent is invalidated. Plans are not used with
+         *      striping, or when the backend selection policy measures the transfers.
+         */
+        uint64_t planCacheSize;
+        /**
+         * @var Load the backend metadata of remote descriptors on their first use in a
+         *      transfer, instead of for all of them in loadRemoteMD. With preResolveRemoteMD
+         *      a background thread loads them after each loadRemoteMD meanwhile, which needs
+         *      the NIXL_THREAD_SYNC_STRICT mode, as it runs alongside the other calls.
+         */
+        bool     lazyRemoteMD;
+        bool     preResolveRemoteMD;
+        /**
+         * @var Max number of remote agents, and bytes of the metadata held for them, kept
+         *      by the agent, 0 for no limit. Over a limit, loadRemoteMD drops the metadata
+         *      of the least recently used agents, as invalidateRemoteMD does. The next use
+         *      of a dropped agent fetches its metadata again, as fetchRemoteMD does with the
+         *      address it was last fetched from, or etcd. Until then it is not found.
+         */
+        uint64_t remoteMaxAgents;
+        uint64_t remoteMaxMDBytes;
+        /**
+         * @var Max number of threads registering the descriptors of a registerMem call,
+         *      for backends that support concurrent registration, 0 or 1 to register them
+         *      one by one. The registration time of each backend is reported in the stats.
+         */
+        uint64_t regThreads;
+        /**
+         * @var Serialize the metadata blobs of getLocalMD, getLocalMDDelta and
+         *      getLocalPartialMD in the tagged string format, which agents from before
+         *      the binary format can load. loadRemoteMD reads both formats.
+         */
+        bool     taggedStrMD;
 
 
         /**
@@ -64,19 +122,35 @@ class nixlAgentConfig {
          * @param sync_mode          Thread synchronization mode
          * @param pthr_delay_us      Optional delay for pthread in us
          * @param lthr_delay_us      Optional delay for listener thread in us
+         * @param backend_select     Optional backend selection policy
          */
         nixlAgentConfig (const bool use_prog_thread,
                          const bool use_listen_thread=false,
                          const int port=0,
                          nixl_thread_sync_t sync_mode=nixl_thread_sync_t::NIXL_THREAD_SYNC_DEFAULT,
                          const uint64_t pthr_delay_us=0,
-                         const uint64_t lthr_delay_us = 100000) :
+                         const uint64_t lthr_delay_us = 100000,
+                         nixl_backend_select_t backend_select =
+                             nixl_backend_select_t::NIXL_BACKEND_SELECT_DEFAULT) :
                          useProgThread(use_prog_thread),
                          useListenThread(use_listen_thread),
                          listenPort(port),
                          syncMode(sync_mode),
                          pthrDelay(pthr_delay_us),
-                         lthrDelay(lthr_delay_us) { }
+                         lthrDelay(lthr_delay_us),
+                         backendSelect(backend_select),
+                         prioHoldBytes(0),
+                         remoteMaxBytes(0),
+                         remoteMaxReqs(0),
+                         totalMaxBytes(0),
+                         totalMaxReqs(0),
+                         planCacheSize(0),
+                         lazyRemoteMD(false),
+                         preResolveRemoteMD(false),
+                         remoteMaxAgents(0),
+                         remoteMaxMDBytes(0),
+                         regThreads(0),
+                         taggedStrMD(false) { }
 
         /**
          * @brief Copy constructor for nixlAgentConfig object
@@ -26,6 +26,8 @@ class nixlSerDes;
 class nixlDlistH;
 class nixlBackendH;
 class nixlXferReqH;
+class nixlRegH;
+class nixlXferCQ;
 class nixlAgentData;
 
 
@@ -64,7 +66,10 @@ enum nixl_status_t {
 
 /**
  * @enum nixl_thread_sync_t
- * @brief An enumeration of supported synchronization modes for NIXL
+ * @brief An enumeration of supported synchronization modes for NIXL.
+ *        In strict mode control path calls (backend creation, memory registration
+ *        and remote metadata load/invalidate) are serialized, while datapath calls
+ *        on independent transfer requests can run concurrently.
  */
 enum class nixl_thread_sync_t {
     NIXL_THREAD_SYNC_NONE,
@@ -72,6 +77,50 @@ enum class nixl_thread_sync_t {
     NIXL_THREAD_SYNC_DEFAULT = NIXL_THREAD_SYNC_NONE,
 };
 
+/**
+ * @enum nixl_backend_select_t
+ * @brief An enumeration of policies to choose the backend of a transfer, when several
+ *        backends can carry it. First match takes them in their creation order, while
+ *        cost predicts the completion time of the transfer on each backend, based on
+ *        the latency and bandwidth measured from previous transfers to the same agent.
+ *        Transfers are measured when their completion is reported by the backend, or
+ *        when they're checked often enough to tell when they were done.
+ */
+enum class nixl_backend_select_t {
+    NIXL_BACKEND_SELECT_FIRST,
+    NIXL_BACKEND_SELECT_COST,
+    NIXL_BACKEND_SELECT_DEFAULT = NIXL_BACKEND_SELECT_FIRST,
+};
+
+/**
+ * @enum nixl_xfer_prio_t
+ * @brief An enumeration of priority classes of transfer requests. When the agent config
+ *        limits the bytes in flight of lower classes, their posts are held back while
+ *        transfers of a higher class are in flight or held.
+ */
+enum class nixl_xfer_prio_t {
+    NIXL_XFER_PRIO_HIGH,
+    NIXL_XFER_PRIO_NORMAL,
+    NIXL_XFER_PRIO_BULK,
+    NIXL_XFER_PRIO_DEFAULT = NIXL_XFER_PRIO_NORMAL,
+};
+
+/**
+ * @enum nixl_xfer_compl_t
+ * @brief An enumeration of the completion semantics of transfer requests, for backends
+ *        that can tell them apart. Local completion reports a transfer done once its
+ *        local buffers can be reused, while the remote ones wait for the written data to
+ *        reach the target, through one flush of all the backend connections, or a flush
+ *        of each connection the transfer used. A notification is always sent after the
+ *        data of its transfer reached the target.
+ */
+enum class nixl_xfer_compl_t {
+    NIXL_XFER_COMPL_LOCAL,
+    NIXL_XFER_COMPL_REMOTE_ALL,
+    NIXL_XFER_COMPL_REMOTE_TARGETS,
+    NIXL_XFER_COMPL_DEFAULT = NIXL_XFER_COMPL_REMOTE_TARGETS,
+};
+
 /**
  * @namespace nixlEnumStrings
  * @brief     This namespace to get string representation
@@ -116,6 +165,40 @@ using nixl_b_params_t = std::unordered_map<std::string, std::string>;
  */
 using nixl_notifs_t = std::unordered_map<std::string, std::vector<nixl_blob_t>>;
 
+/**
+ * @brief A typedef for a  std::unordered_map<std::string, uint64_t>
+ *        to hold nixl_stats_t (named agent counters)
+ */
+using nixl_stats_t = std::unordered_map<std::string, uint64_t>;
+
+/**
+ * @brief A typedef for the completion callback of a transfer request, which is called
+ *        with the request, its final status and the user context given with the callback.
+ */
+typedef void (*nixl_completion_cb_t)(nixlXferReqH* req_hndl, nixl_status_t status, void* ctx);
+
+/**
+ * @class nixlIdxRange
+ * @brief A run of `count` descriptor indices starting from `start`, `stride` apart,
+ *        to select descriptors in makeXferReq without listing each of their indices.
+ *        The stride must be positive.
+ */
+class nixlIdxRange {
+    public:
+        int start;
+        int count;
+        int stride;
+
+        nixlIdxRange(const int start, const int count, const int stride = 1) :
+                     start(start), count(count), stride(stride) { }
+};
+
+/**
+ * @brief A typedef for a std::vector<nixlIdxRange>, where the ranges are concatenated
+ *        in order, e.g., to describe a run-length list of indices.
+ */
+using nixl_idx_ranges_t = std::vector<nixlIdxRange>;
+
 /**
  * @brief A constant to define the default communication port.
  */
@@ -146,10 +229,67 @@ class nixlAgentOptionalArgs {
         bool hasNotif = false;
 
         /**
-         * @var makeXferReq boolean to skip merging consecutive descriptors, used in makeXferReq.
+         * @var skipDescMerge boolean to skip merging consecutive descriptors, used in
+         *                    makeXferReq / createXferReq.
          */
         bool skipDescMerge = false;
 
+        /**
+         * @var mergeDescs boolean to merge consecutive descriptors in createXferReq, which
+         *                 keeps them as given by default. makeXferReq merges them unless
+         *                 skipDescMerge is set.
+         */
+        bool mergeDescs = false;
+
+        /**
+         * @var sortDescs boolean to sort the descriptors by their remote address before they
+         *                are passed to the backend, used in makeXferReq / createXferReq.
+         *                When merging, consecutive descriptors are then merged regardless of
+         *                the given order.
+         */
+        bool sortDescs = false;
+
+        /**
+         * @var striping boolean to split the transfer across all the backends that can carry
+         *               it, weighted by their capacity, used in createXferReq. The resulting
+         *               request does not support notifications, completion queues or callbacks.
+         */
+        bool striping = false;
+
+        /**
+         * @var priority Priority class of the transfer, used in createXferReq / makeXferReq.
+         *               Striped transfers are not scheduled by their priority.
+         */
+        nixl_xfer_prio_t priority = nixl_xfer_prio_t::NIXL_XFER_PRIO_DEFAULT;
+
+        /**
+         * @var completion Completion semantics of the transfer, used in createXferReq /
+         *                 makeXferReq.
+         */
+        nixl_xfer_compl_t completion = nixl_xfer_compl_t::NIXL_XFER_COMPL_DEFAULT;
+
+        /**
+         * @var xferCQ Completion queue to report the transfer completion to, used in
+         *             postXferReq / postXferReqBatch.
+         */
+        nixlXferCQ* xferCQ = nullptr;
+
+        /**
+         * @var completionCb Callback to be called once when the transfer is done, used in
+         *                   postXferReq / postXferReqBatch instead of a completion queue.
+         *                   It is called from a backend progress thread, from progressXfers,
+         *                   or within the post if the transfer is done immediately. Agent
+         *                   datapath methods, e.g. to post the next transfer, can be called
+         *                   from it. The request should not be accessed until it's called.
+         *                   Callbacks of transfers posted from within a callback are called
+         *                   after it returns, rather than nested in it.
+         */
+        nixl_completion_cb_t completionCb = nullptr;
+        /**
+         * @var completionCtx User context to be passed to completionCb.
+         */
+        void* completionCtx = nullptr;
+
         /**
          * @var includeConnInfo boolean to include connection information in the metadata,
          *                      used in getLocalPartialMD.
@@ -14,7 +14,7 @@
 # limitations under the License.
 
 import pickle
-from typing import Optional
+from typing import Optional, Union
 
 import torch
 
@@ -26,6 +26,7 @@ DEFAULT_COMM_PORT = nixlBind.DEFAULT_COMM_PORT
 nixl_backend_handle = int
 nixl_prepped_dlist_handle = int
 nixl_xfer_handle = int
+nixl_reg_handle = int
 
 """
 @brief Configuration class for NIXL agent.
@@ -266,6 +267,63 @@ class nixl_agent:
 
         return reg_descs
 
+    """
+    @brief Register memory regions without blocking. The regions are registered in the
+            background, and each can be used in transfers and in the agent metadata as soon
+            as it is registered. The handle should be released by release_reg_handle.
+            Requires the agent to be created with the strict thread sync mode.
+
+    @param reg_list List of either memory regions, tensors, or nixlRegDList to register.
+    @param mem_type Optional memory type necessary for list of memory regions.
+    @param is_sorted Optional bool for whether reg_list is sorted.
+    @param backends Optional list of backend names for registration.
+    @return nixlRegDList of the registered memory, and the handle of the registration.
+    """
+
+    def register_memory_async(
+        self,
+        reg_list,
+        mem_type: Optional[str] = None,
+        is_sorted: bool = False,
+        backends: list[str] = [],
+    ) -> tuple[nixlBind.nixlRegDList, nixl_reg_handle]:
+        reg_descs = self.get_reg_descs(reg_list, mem_type, is_sorted)
+
+        handle_list = []
+        for backend_string in backends:
+            handle_list.append(self.backends[backend_string])
+        handle = self.agent.registerMemAsync(reg_descs, handle_list)
+
+        return reg_descs, handle
+
+    """
+    @brief Check the state of a registration from register_memory_async.
+
+    @param handle Handle to the registration.
+    @param wait Optional bool to block until the registration is done.
+    @return Status of the registration ("DONE", "PROC", or "ERR"). After "ERR", the regions
+            registered by it were deregistered, and release_reg_handle raises the error.
+    """
+
+    def check_reg_state(self, handle: nixl_reg_handle, wait: bool = False) -> str:
+        status = self.agent.getRegStatus(handle, wait)
+        if status == nixlBind.NIXL_SUCCESS:
+            return "DONE"
+        elif status == nixlBind.NIXL_IN_PROG:
+            return "PROC"
+        else:
+            return "ERR"
+
+    """
+    @brief Release a registration handle, waiting for the registration to finish.
+            The memory stays registered until deregister_memory.
+
+    @param handle Handle to the registration.
+    """
+
+    def release_reg_handle(self, handle: nixl_reg_handle):
+        self.agent.releaseRegH(handle)
+
     """
     @brief Deregister memory regions from the specified backends.
 
@@ -349,9 +407,12 @@ class nixl_agent:
     @param local_xfer_side Handle to the local transfer descriptor list,
             received from prep_xfer_dlist.
     @param local_indices List of indices for selecting local descriptors.
+            Can also be a python range, or a list of nixlIdxRange, so the
+            indices are not expanded one by one.
     @param remote_xfer_side Handle to the remote (or loopback) transfer descriptor list,
             received from prep_xfer_dlist.
-    @param remote_indices List of indices for selecting remote descriptors.
+    @param remote_indices List of indices for selecting remote descriptors,
+            in any of the forms accepted for local_indices.
     @param notif_msg Optional notification message to send after transfer is done.
            notif_msg should be bytes, as that is what will be returned to the target, but will work with str too.
     @param backends Optional list of backend names to limit which backends NIXL can use.
@@ -363,9 +424,9 @@ class nixl_agent:
         self,
         operation: str,
         local_xfer_side: nixl_prepped_dlist_handle,
-        local_indices: list[int],
+        local_indices: Union[list[int], range, list[nixlBind.nixlIdxRange]],
         remote_xfer_side: nixl_prepped_dlist_handle,
-        remote_indices: list[int],
+        remote_indices: Union[list[int], range, list[nixlBind.nixlIdxRange]],
         notif_msg: bytes = b"",
         backends: list[str] = [],
         skip_desc_merge: bool = False,
@@ -376,6 +437,13 @@ class nixl_agent:
             for backend_string in backends:
                 handle_list.append(self.backends[backend_string])
 
+            # Both sides are passed as ranges if either of them is
+            if self._is_idx_ranges(local_indices) or self._is_idx_ranges(
+                remote_indices
+            ):
+                local_indices = self._to_idx_ranges(local_indices)
+                remote_indices = self._to_idx_ranges(remote_indices)
+
             handle = self.agent.makeXferReq(
                 op,
                 local_xfer_side,
@@ -621,6 +689,29 @@ class nixl_agent:
             handle_list.append(self.backends[backend_string])
         return self.agent.getLocalPartialMD(descs, inc_conn_info, handle_list)
 
+    """
+    @brief Get the changes to the metadata of the local agent since a generation.
+            The full metadata is returned if the changes are no longer kept.
+
+    @param since_gen Generation the remote agent has loaded, see get_remote_metadata_gen.
+
+    @return Metadata changes of the local agent, in bytes.
+    """
+
+    def get_agent_metadata_delta(self, since_gen: int) -> bytes:
+        return self.agent.getLocalMDDelta(since_gen)
+
+    """
+    @brief Get the generation of the metadata loaded from a remote agent.
+
+    @param agent Name of the remote agent.
+
+    @return Generation of the loaded metadata.
+    """
+
+    def get_remote_metadata_gen(self, agent: str) -> int:
+        return self.agent.getRemoteMDGen(agent)
+
     """
     @brief Add a remote agent using its metadata. After this call, current agent can
             initiate transfers towards the remote agent.
@@ -887,3 +978,27 @@ class nixl_agent:
 
     def deserialize_descs(self, serialized_descs: bytes):
         return pickle.loads(serialized_descs)
+
+    """
+    @brief Check if indices are given as a python range or a list of nixlIdxRange.
+    """
+
+    def _is_idx_ranges(self, indices) -> bool:
+        return isinstance(indices, range) or (
+            len(indices) > 0 and isinstance(indices[0], nixlBind.nixlIdxRange)
+        )
+
+    """
+    @brief Convert indices to a list of nixlIdxRange, a python range becomes a
+            single strided range, and a list of indices a run of single ones.
+
+    @param indices Indices in any of the forms accepted by make_prepped_xfer.
+    @return List of nixlIdxRange.
+    """
+
+    def _to_idx_ranges(self, indices) -> list[nixlBind.nixlIdxRange]:
+        if isinstance(indices, range):
+            return [nixlBind.nixlIdxRange(indices.start, len(indices), indices.step)]
+        if len(indices) > 0 and isinstance(indices[0], nixlBind.nixlIdxRange):
+            return indices
+        return [nixlBind.nixlIdxRange(idx, 1) for idx in indices]
@@ -129,6 +129,12 @@ PYBIND11_MODULE(_bindings, m) {
         .value("NIXL_THREAD_SYNC_DEFAULT", nixl_thread_sync_t::NIXL_THREAD_SYNC_DEFAULT)
         .export_values();
 
+    py::enum_<nixl_backend_select_t>(m, "nixl_backend_select_t")
+        .value("NIXL_BACKEND_SELECT_FIRST", nixl_backend_select_t::NIXL_BACKEND_SELECT_FIRST)
+        .value("NIXL_BACKEND_SELECT_COST", nixl_backend_select_t::NIXL_BACKEND_SELECT_COST)
+        .value("NIXL_BACKEND_SELECT_DEFAULT", nixl_backend_select_t::NIXL_BACKEND_SELECT_DEFAULT)
+        .export_values();
+
     py::enum_<nixl_mem_t>(m, "nixl_mem_t")
         .value("DRAM_SEG", DRAM_SEG)
         .value("VRAM_SEG", VRAM_SEG)
@@ -284,12 +290,20 @@ PYBIND11_MODULE(_bindings, m) {
             }
         ));
 
+    py::class_<nixlIdxRange>(m, "nixlIdxRange")
+        .def(py::init<int, int, int>(), py::arg("start"), py::arg("count"), py::arg("stride")=1)
+        .def_readwrite("start", &nixlIdxRange::start)
+        .def_readwrite("count", &nixlIdxRange::count)
+        .def_readwrite("stride", &nixlIdxRange::stride);
+
     py::class_<nixlAgentConfig>(m, "nixlAgentConfig")
         //implicit constructor
         .def(py::init<bool>())
         .def(py::init<bool, bool>())
         .def(py::init<bool, bool, int>())
-        .def(py::init<bool, bool, int, nixl_thread_sync_t>());
+        .def(py::init<bool, bool, int, nixl_thread_sync_t>())
+        .def(py::init<bool, bool, int, nixl_thread_sync_t, uint64_t, uint64_t,
+                      nixl_backend_select_t>());
 
     //note: pybind will automatically convert notif_map to python types:
     //so, a Dictionary of string: List<string>
@@ -344,6 +358,27 @@ PYBIND11_MODULE(_bindings, m) {
                     throw_nixl_exception(ret);
                     return ret;
                 }, py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}))
+        .def("registerMemAsync", [](nixlAgent &agent, nixl_reg_dlist_t descs, std::vector<uintptr_t> backends) -> uintptr_t {
+                    nixl_opt_args_t extra_params;
+                    nixlRegH* handle = nullptr;
+                    for(uintptr_t backend: backends)
+                        extra_params.backends.push_back((nixlBackendH*) backend);
+
+                    nixl_status_t ret = agent.registerMemAsync(descs, handle, &extra_params);
+                    throw_nixl_exception(ret);
+                    return (uintptr_t) handle;
+                }, py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}))
+        // A failed registration is reported in the status, only a bad handle throws
+        .def("getRegStatus", [](nixlAgent &agent, uintptr_t handle, bool wait) -> nixl_status_t {
+                    if (!handle)
+                        throw_nixl_exception(NIXL_ERR_INVALID_PARAM);
+                    return agent.getRegStatus((nixlRegH*) handle, wait);
+                }, py::arg("handle"), py::arg("wait") = false)
+        .def("releaseRegH", [](nixlAgent &agent, uintptr_t handle) -> nixl_status_t {
+                    nixl_status_t ret = agent.releaseRegH((nixlRegH*) handle);
+                    throw_nixl_exception(ret);
+                    return ret;
+                })
         .def("makeConnection", [](nixlAgent &agent,
                                   const std::string &remote_agent,
                                   std::vector<uintptr_t> backends) {
@@ -401,6 +436,37 @@ PYBIND11_MODULE(_bindings, m) {
                    py::arg("remote_indices"), py::arg("notif_msg") = std::string(""),
                    py::arg("backend") = std::vector<uintptr_t>({}),
                    py::arg("skip_desc_merg") = false)
+        .def("makeXferReq", [](nixlAgent &agent,
+                               const nixl_xfer_op_t &operation,
+                               uintptr_t local_side,
+                               const nixl_idx_ranges_t &local_ranges,
+                               uintptr_t remote_side,
+                               const nixl_idx_ranges_t &remote_ranges,
+                               const std::string &notif_msg,
+                               std::vector<uintptr_t> backends,
+                               bool skip_desc_merge) -> uintptr_t {
+                    nixlXferReqH* handle = nullptr;
+                    nixl_opt_args_t extra_params;
+
+                    for(uintptr_t backend: backends)
+                        extra_params.backends.push_back((nixlBackendH*) backend);
+
+                    if (notif_msg.size()>0) {
+                        extra_params.notifMsg = notif_msg;
+                        extra_params.hasNotif = true;
+                    }
+                    extra_params.skipDescMerge = skip_desc_merge;
+                    throw_nixl_exception(agent.makeXferReq(operation,
+                                                           (nixlDlistH*) local_side, local_ranges,
+                                                           (nixlDlistH*) remote_side, remote_ranges,
+                                                           handle, &extra_params));
+
+                    return (uintptr_t) handle;
+                }, py::arg("operation"), py::arg("local_side"),
+                   py::arg("local_ranges"), py::arg("remote_side"),
+                   py::arg("remote_ranges"), py::arg("notif_msg") = std::string(""),
+                   py::arg("backend") = std::vector<uintptr_t>({}),
+                   py::arg("skip_desc_merg") = false)
         .def("createXferReq", [](nixlAgent &agent,
                                  const nixl_xfer_op_t &operation,
                                  const nixl_xfer_dlist_t &local_descs,
@@ -499,6 +565,16 @@ PYBIND11_MODULE(_bindings, m) {
                     throw_nixl_exception(agent.getLocalMD(ret_str));
                     return py::bytes(ret_str);
                 })
+        .def("getLocalMDDelta", [](nixlAgent &agent, uint64_t since_gen) -> py::bytes {
+                    std::string ret_str("");
+                    throw_nixl_exception(agent.getLocalMDDelta(since_gen, ret_str));
+                    return py::bytes(ret_str);
+                })
+        .def("getRemoteMDGen", [](nixlAgent &agent, const std::string &remote_agent) -> uint64_t {
+                    uint64_t gen = 0;
+                    throw_nixl_exception(agent.getRemoteMDGen(remote_agent, gen));
+                    return gen;
+                })
         .def("getLocalPartialMD", [](nixlAgent &agent, nixl_reg_dlist_t descs, bool inc_conn_info, std::vector<uintptr_t> backends) -> py::bytes {
                     std::string ret_str("");
 
@@ -17,8 +17,15 @@
 #ifndef __AGENT_DATA_H_
 #define __AGENT_DATA_H_
 
+#include <condition_variable>
+#include <unordered_set>
 #include "common/str_tools.h"
+#include "common/obj_pool.h"
+#include "serdes/serdes.h"
 #include "mem_section.h"
+#include "backend_select.h"
+#include "xfer_sched.h"
+#include "xfer_plan.h"
 #include "stream/metadata_stream.h"
 #include "sync.h"
 
@@ -32,6 +39,18 @@ namespace etcd {
 #define NIXL_ETCD_NAMESPACE_DEFAULT "/nixl/agents/"
 #endif // HAVE_ETCD
 
+// Max number of released transfer requests kept for reuse
+#define NIXL_XFER_REQ_POOL_SIZE 1024
+
+// Max number of remote descriptors loaded at a time by the background resolver
+#define NIXL_RESOLVE_BATCH 256
+
+// Min time between fetches of the metadata of a dropped agent on its uses
+#define NIXL_REFETCH_INTERVAL_US 1000000
+
+// Min size of each part of a striped transfer
+#define NIXL_STRIPE_MIN_SIZE (256 * 1024)
+
 using backend_list_t = std::vector<nixlBackendEngine*>;
 
 //Internal typedef to define metadata communication request types
@@ -70,6 +89,9 @@ class nixlAgentData {
         backend_map_t                          backendEngines;
         std::array<backend_list_t, FILE_SEG+1> memToBackend;
 
+        // Policy to choose the backend of a transfer among the candidates
+        std::unique_ptr<nixlBackendSelector>   selector;
+
         // Bookkeping for local connection metadata and user handles per backend
         std::unordered_map<nixl_backend_t, nixlBackendH*> backendHandles;
         std::unordered_map<nixl_backend_t, nixl_blob_t>   connMD;
@@ -83,6 +105,144 @@ class nixlAgentData {
         std::unordered_map<std::string, nixlRemoteSection*,
                            std::hash<std::string>, strEqual>     remoteSections;
 
+        // Datapath calls only take the agent lock shared, engines that can't
+        // handle concurrent requests are serialized by their own lock instead
+        std::unordered_map<nixlBackendEngine*,
+                           std::unique_ptr<std::mutex>>          engineLocks;
+
+        std::unique_lock<std::mutex> lockEngine(nixlBackendEngine* engine);
+
+        // Transfer requests are recycled with their descriptor lists, so
+        // creating and releasing them doesn't allocate in steady state
+        nixlObjPool<nixlXferReqH>                                xferReqPool;
+
+        nixlXferReqH* getXferReqH();
+        void          putXferReqH(nixlXferReqH* req_hndl);
+
+        // Posted requests with a user callback that are checked in progressXfers,
+        // when their backend doesn't report the completion itself
+        std::vector<nixlXferReqH*>                               cbPending;
+        std::mutex                                               cbPendingLock;
+
+        // Held posts with a user callback that were issued by the agent, whose
+        // callback is called from progressXfers
+        std::vector<nixlXferReqH*>                               cbDone;
+
+        // Completion reporting setup before the post of a request, and bookkeeping
+        // after it, given the opt_args of the post. Called with the engine lock of
+        // the request held.
+        nixl_status_t trackXfer(nixlXferReqH* req_hndl,
+                                const nixl_opt_args_t* extra_params,
+                                nixl_opt_b_args_t &opt_args);
+        void          trackedPost(nixlXferReqH* req_hndl, const nixl_status_t ret,
+                                  const nixl_opt_b_args_t &opt_args);
+
+        // Posts a request to its engine, called with the engine lock held
+        nixl_status_t issueXfer(nixlXferReqH* req_hndl, const nixl_opt_b_args_t &opt_args);
+
+        // Admission of posts, if enabled by the config. issueHeld is called with the
+        // agent lock held and no engine lock, to issue the posts admitted meanwhile.
+        std::unique_ptr<nixlXferSched>                           sched;
+
+        void          issueHeld();
+
+        // Cached createXferReq outcomes, if enabled by the config
+        std::unique_ptr<nixlXferPlanCache>                       plans;
+
+        // Common part of the makeXferReq variants, for each form of the indices
+        template <class idx_list_t>
+        nixl_status_t makeXferReq(const nixl_xfer_op_t &operation,
+                                  const nixlDlistH* local_side,
+                                  idx_list_t &local_idx,
+                                  const nixlDlistH* remote_side,
+                                  idx_list_t &remote_idx,
+                                  nixlXferReqH* &req_hndl,
+                                  const nixl_opt_args_t* extra_params);
+
+        // Descriptor lists of a request are optimized for its engine before prepXfer:
+        // optionally sorted by remote address, merged when consecutive in memory, and
+        // split at the engine chunk size. The counters are reported in the stats.
+        std::atomic<uint64_t>                                    descsMerged{0};
+        std::atomic<uint64_t>                                    descsSplit{0};
+
+        void          optimizeDescs(nixlXferReqH* req_hndl, const bool merge,
+                                    const bool sort);
+
+        // Background loading of lazily loaded remote metadata, per remote agent
+        std::thread                        resolveThread;
+        std::vector<std::string>           resolveQueue;
+        std::mutex                         resolveQueueLock;
+        std::condition_variable            resolveCV;
+        std::condition_variable            resolveIdleCV;
+        bool                               resolveBusy;
+        std::atomic<bool>                  resolveStop;
+
+        void resolveWorker();
+        void enqueueResolve(const std::string &remote_agent);
+
+        // Bounded remote metadata, by remoteMaxAgents and remoteMaxMDBytes of the config.
+        // Dropped agents are fetched again on their next use, from the address they were
+        // last fetched from, or etcd, until loaded. The time of the last fetch is kept.
+        uint64_t                                          remoteMDBytes;
+        uint64_t                                          remoteEvictions;
+        std::unordered_map<std::string, nixlTime::us_t>   evictedAgents;
+        std::unordered_map<std::string, nixl_socket_peer_t> mdSources;
+        std::mutex                                        evictLock;
+
+        // Sections dropped while handles still used them, kept until they are released.
+        // Set by the last release of a section with retired metadata.
+        std::vector<nixlRemoteSection*>                   retiredSections;
+        std::atomic<bool>                                 reapPending;
+
+        // Called with the agent lock held exclusively
+        void          reapRetired();
+        void          dropRemoteSection(const std::string &remote_agent);
+        nixl_status_t dropRemoteMD(const std::string &remote_agent);
+        void          evictRemoteMD(const std::string &keep_agent);
+        // Called on a use of an agent whose metadata is not loaded
+        void          refetchRemoteMD(const std::string &remote_agent);
+
+        // The remote of the handle was not dropped or replaced since it was created
+        inline bool remoteValid(const std::string &remote_agent,
+                                const nixlSectionUse &use) const {
+            return (remoteSections.count(remote_agent) != 0) && !use.stale();
+        }
+
+        // Time spent in registerMem, and descriptors registered, per backend
+        std::unordered_map<nixlBackendEngine*, std::pair<uint64_t, uint64_t>> regTimes;
+
+        // Registers the descs with each of the backends, best effort, called with
+        // the agent lock held exclusively
+        nixl_status_t addRegistrations(const nixl_reg_dlist_t &descs,
+                                       const backend_list_t &backends);
+
+        // Registrations of registerMemAsync that are not released yet
+        std::unordered_set<nixlRegH*>      regHandles;
+        std::mutex                         regHandlesLock;
+
+        void regWorker(nixlRegH* reg_hndl);
+
+        inline nixlSerDes::ser_fmt_t mdFormat() const {
+            return config.taggedStrMD ? nixlSerDes::TAGGED_STR : nixlSerDes::BINARY;
+        }
+
+        // Full local metadata blob, called with the agent lock held. A reset record
+        // replaces the metadata a loader already has from this agent.
+        nixl_status_t getLocalMD(nixl_blob_t &str, const bool reset = false) const;
+
+        // Striped transfers, called with the agent lock held. When a single stripe
+        // is left, createStripes keeps it in stripes without setting req_hndl.
+        nixl_status_t createStripes(std::vector<nixlXferReqH*> &stripes,
+                                    const nixl_xfer_op_t &operation,
+                                    const std::string &remote_agent,
+                                    const nixl_opt_args_t* extra_params,
+                                    nixlXferReqH* &req_hndl);
+        nixl_status_t postStripes(nixlXferReqH* req_hndl);
+        nixl_status_t checkStripes(nixlXferReqH* req_hndl);
+        nixl_status_t releaseStripes(nixlXferReqH* req_hndl);
+        // Releases a request that is not tracked, with the agent lock held shared
+        nixl_status_t releaseReq(nixlXferReqH* req_hndl);
+
         // State/methods for listener thread
         nixlMDStreamListener               *listener;
         std::map<nixl_socket_peer_t, int>  remoteSockets;
@@ -124,4 +284,29 @@ class nixlBackendH {
     friend class nixlAgent;
 };
 
+// Registration running in the background for registerMemAsync. The descs are
+// registered in batches, each becoming visible as soon as it is registered.
+class nixlRegH {
+    private:
+        nixl_reg_dlist_t         descs;
+        backend_list_t           backends;
+        std::thread              worker;
+
+        // Number of descs registered so far, and the batches for a rollback
+        std::atomic<int>         registered;
+        std::vector<nixl_reg_dlist_t> batches;
+
+        nixl_status_t            status;
+        std::mutex               statusLock;
+        std::condition_variable  statusCV;
+
+        nixlRegH(const nixl_reg_dlist_t &reg_descs, const backend_list_t &reg_backends) :
+                 descs(reg_descs), backends(reg_backends), registered(0),
+                 status(NIXL_IN_PROG) {}
+        ~nixlRegH() {}
+
+    friend class nixlAgentData;
+    friend class nixlAgent;
+};
+
 #endif
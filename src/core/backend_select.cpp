@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include "backend/backend_engine.h"
+#include "backend_select.h"
+
+/*** nixlXferCostModel implementation ***/
+void nixlXferCostModel::addSample(const double bytes, const double descs,
+                                  const double time_ns) {
+    sumDD = sumDD * NIXL_XFER_COST_DECAY + descs * descs;
+    sumDB = sumDB * NIXL_XFER_COST_DECAY + descs * bytes;
+    sumBB = sumBB * NIXL_XFER_COST_DECAY + bytes * bytes;
+    sumDT = sumDT * NIXL_XFER_COST_DECAY + descs * time_ns;
+    sumBT = sumBT * NIXL_XFER_COST_DECAY + bytes * time_ns;
+    samples++;
+}
+
+bool nixlXferCostModel::getCoeffs(double &desc_ns, double &byte_ns) const {
+    if (samples < NIXL_XFER_COST_MIN_SAMPLES)
+        return false;
+
+    // Normal equations of the two variable fit. If all the samples had the same
+    // shape they're singular, and any split of the time predicts that shape.
+    double det = sumDD * sumBB - sumDB * sumDB;
+    if (std::fabs(det) > 1e-9 * sumDD * sumBB) {
+        desc_ns = (sumDT * sumBB - sumBT * sumDB) / det;
+        byte_ns = (sumBT * sumDD - sumDT * sumDB) / det;
+    } else {
+        desc_ns = -1;
+        byte_ns = -1;
+    }
+
+    // Noise can make one of them negative, then the other explains it all
+    if ((desc_ns < 0) || (byte_ns < 0)) {
+        if ((desc_ns < 0) && (sumBB > 0)) {
+            desc_ns = 0;
+            byte_ns = sumBT / sumBB;
+        } else {
+            desc_ns = sumDT / sumDD;
+            byte_ns = 0;
+        }
+    }
+    return true;
+}
+
+/*** nixlBackendSelector implementation ***/
+std::unique_ptr<nixlBackendSelector>
+nixlBackendSelector::create(const nixl_backend_select_t &policy) {
+    switch (policy) {
+        case nixl_backend_select_t::NIXL_BACKEND_SELECT_COST:
+            return std::make_unique<nixlCostSelector>();
+        default:
+            return std::make_unique<nixlBackendSelector>();
+    }
+}
+
+void nixlBackendSelector::getStats(nixl_stats_t &stats) const {
+    for (auto &elm : chosenCnt)
+        stats["backend_select." + elm.first->getType() + ".chosen"] = elm.second;
+}
+
+/*** nixlCostSelector implementation ***/
+void nixlCostSelector::order(std::vector<nixlBackendEngine*> &engines,
+                             const std::string &remote_agent,
+                             const size_t bytes, const int descs) {
+    std::vector<std::pair<double, nixlBackendEngine*>> costs;
+    double desc_ns, byte_ns;
+
+    if (engines.size() < 2)
+        return;
+
+    {
+        const std::lock_guard<std::mutex> guard(lock);
+        remoteCosts &remote = remotes[remote_agent];
+        remote.selections++;
+
+        for (auto &engine : engines) {
+            auto it = remote.models.find(engine);
+            // Unmeasured or stale backends get a zero cost to be tried next
+            if ((it == remote.models.end()) ||
+                (remote.selections - it->second.lastSample > NIXL_XFER_COST_STALE) ||
+                !it->second.getCoeffs(desc_ns, byte_ns))
+                costs.emplace_back(0, engine);
+            else
+                costs.emplace_back(desc_ns * descs + byte_ns * bytes, engine);
+        }
+    }
+
+    // Stable, so ties keep the creation order
+    std::stable_sort(costs.begin(), costs.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    for (size_t i = 0; i < engines.size(); ++i)
+        engines[i] = costs[i].second;
+}
+
+void nixlCostSelector::addSample(nixlBackendEngine* engine,
+                                 const std::string &remote_agent,
+                                 const size_t bytes, const int descs,
+                                 const nixlTime::ns_t time_ns) {
+    const std::lock_guard<std::mutex> guard(lock);
+    remoteCosts &remote = remotes[remote_agent];
+    nixlXferCostModel &model = remote.models[engine];
+
+    model.addSample(bytes, descs, time_ns);
+    model.lastSample = remote.selections;
+}
+
+void nixlCostSelector::getStats(nixl_stats_t &stats) const {
+    double desc_ns, byte_ns;
+
+    nixlBackendSelector::getStats(stats);
+
+    const std::lock_guard<std::mutex> guard(lock);
+    for (auto &remote : remotes) {
+        for (auto &elm : remote.second.models) {
+            const std::string prefix = "xfer_cost." + elm.first->getType() +
+                                       "." + remote.first + ".";
+            stats[prefix + "samples"] = elm.second.getSamples();
+            if (!elm.second.getCoeffs(desc_ns, byte_ns))
+                continue;
+            stats[prefix + "desc_ns"] = (uint64_t) desc_ns;
+            // Bytes per us is also MB/s
+            stats[prefix + "bytes_per_us"] = (byte_ns > 0) ? (uint64_t) (1000 / byte_ns) : 0;
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __BACKEND_SELECT_H_
+#define __BACKEND_SELECT_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "nixl_types.h"
+#include "common/nixl_time.h"
+
+class nixlBackendEngine;
+
+// Weight of the previous samples of a model when a new one is added
+#define NIXL_XFER_COST_DECAY 0.98
+// Samples needed before a prediction is trusted
+#define NIXL_XFER_COST_MIN_SAMPLES 4
+// Selections to the same agent after which a backend that was not used is measured again
+#define NIXL_XFER_COST_STALE 256
+
+// Least squares fit of the completion time of transfers of an engine to an agent,
+// as latency per descriptor plus time per byte. With a fixed descriptor count, the
+// first term is the latency of the transfer and the second its inverse bandwidth.
+class nixlXferCostModel {
+    private:
+        double   sumDD = 0, sumDB = 0, sumBB = 0;
+        double   sumDT = 0, sumBT = 0;
+        uint64_t samples = 0;
+
+    public:
+        // Selection count of the agent at the last sample
+        uint64_t lastSample = 0;
+
+        void addSample(const double bytes, const double descs, const double time_ns);
+
+        // Time per descriptor and per byte, false if there are not enough samples
+        bool getCoeffs(double &desc_ns, double &byte_ns) const;
+
+        uint64_t getSamples() const { return samples; }
+};
+
+// Policy to choose the backend of a transfer among the ones that can carry it.
+// The base policy keeps the candidates in their given (creation) order.
+class nixlBackendSelector {
+    private:
+        std::unordered_map<nixlBackendEngine*, std::atomic<uint64_t>> chosenCnt;
+
+    public:
+        static std::unique_ptr<nixlBackendSelector> create(const nixl_backend_select_t &policy);
+
+        virtual ~nixlBackendSelector() { }
+
+        // Called when an engine is created, with the agent lock held exclusively
+        void addEngine(nixlBackendEngine* engine) { chosenCnt[engine] = 0; }
+
+        // Called for the backend of every created transfer request
+        void chosen(nixlBackendEngine* engine) { chosenCnt.at(engine)++; }
+
+        // Whether the policy needs the sizes and completion times of transfers
+        virtual bool measures() const { return false; }
+
+        // Reorders the candidates by preference, the first one is used
+        virtual void order(std::vector<nixlBackendEngine*> &engines,
+                           const std::string &remote_agent,
+                           const size_t bytes, const int descs) { }
+
+        // A transfer posted to the engine was completed in time_ns
+        virtual void addSample(nixlBackendEngine* engine,
+                               const std::string &remote_agent,
+                               const size_t bytes, const int descs,
+                               const nixlTime::ns_t time_ns) { }
+
+        virtual void getStats(nixl_stats_t &stats) const;
+};
+
+// Orders the candidates by their predicted completion time. Backends without a
+// trusted prediction for the agent are tried first, so all of them get measured.
+class nixlCostSelector : public nixlBackendSelector {
+    private:
+        class remoteCosts {
+            public:
+                uint64_t selections = 0;
+                std::unordered_map<nixlBackendEngine*, nixlXferCostModel> models;
+        };
+
+        // Samples come from any thread that observes a completion
+        mutable std::mutex lock;
+        std::unordered_map<std::string, remoteCosts> remotes;
+
+    public:
+        bool measures() const override { return true; }
+
+        void order(std::vector<nixlBackendEngine*> &engines,
+                   const std::string &remote_agent,
+                   const size_t bytes, const int descs) override;
+
+        void addSample(nixlBackendEngine* engine,
+                       const std::string &remote_agent,
+                       const size_t bytes, const int descs,
+                       const nixlTime::ns_t time_ns) override;
+
+        void getStats(nixl_stats_t &stats) const override;
+};
+
+#endif
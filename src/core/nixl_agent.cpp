@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <iostream>
 #include "nixl.h"
 #include "serdes/serdes.h"
@@ -61,7 +62,10 @@ std::string nixlEnumStrings::statusStr (const nixl_status_t &status) {
 /*** nixlAgentData constructor/destructor, as part of nixlAgent's ***/
 nixlAgentData::nixlAgentData(const std::string &name,
                              const nixlAgentConfig &cfg) :
-                                   name(name), config(cfg), lock(cfg.syncMode)
+                                   name(name), config(cfg), lock(cfg.syncMode),
+                                   selector(nixlBackendSelector::create(cfg.backendSelect)),
+                                   xferReqPool(NIXL_XFER_REQ_POOL_SIZE,
+                                               lock.isStrict())
 {
 #if HAVE_ETCD
     if (getenv("NIXL_ETCD_ENDPOINTS")) {
@@ -75,14 +79,50 @@ nixlAgentData::nixlAgentData(const std::string &name,
     if (name.empty())
         throw std::invalid_argument("Agent needs a name");
 
-    memorySection = new nixlLocalSection();
+    memorySection = new nixlLocalSection(cfg.regThreads);
+
+    if (nixlXferSched::enabled(cfg))
+        sched = std::make_unique<nixlXferSched>(cfg);
+
+    if (cfg.planCacheSize > 0)
+        plans = std::make_unique<nixlXferPlanCache>(cfg.planCacheSize);
+
+    remoteMDBytes   = 0;
+    remoteEvictions = 0;
+    reapPending     = false;
+
+    // The background thread relies on the agent lock against the other calls
+    resolveBusy = false;
+    resolveStop = false;
+    if (cfg.lazyRemoteMD && cfg.preResolveRemoteMD) {
+        if (!lock.isStrict())
+            throw std::invalid_argument("preResolveRemoteMD needs NIXL_THREAD_SYNC_STRICT");
+        resolveThread = std::thread(&nixlAgentData::resolveWorker, this);
+    }
 }
 
 nixlAgentData::~nixlAgentData() {
+    // Registrations that were not released are let finish, before the backends go
+    for (auto &reg_hndl : regHandles) {
+        reg_hndl->worker.join();
+        delete reg_hndl;
+    }
+
+    if (resolveThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(resolveQueueLock);
+            resolveStop = true;
+        }
+        resolveCV.notify_one();
+        resolveThread.join();
+    }
+
     delete memorySection;
 
     for (auto & elm: remoteSections)
         delete elm.second;
+    for (auto &section : retiredSections)
+        delete section;
 
     for (auto & elm: backendEngines) {
         auto& plugin_manager = nixlPluginManager::getInstance();
@@ -99,6 +139,705 @@ nixlAgentData::~nixlAgentData() {
 
 }
 
+void nixlAgentData::enqueueResolve(const std::string &remote_agent) {
+    {
+        std::lock_guard<std::mutex> guard(resolveQueueLock);
+        resolveQueue.push_back(remote_agent);
+    }
+    resolveCV.notify_one();
+}
+
+void nixlAgentData::resolveWorker() {
+    std::unique_lock<std::mutex> guard(resolveQueueLock);
+
+    while (!resolveStop) {
+        if (resolveQueue.empty()) {
+            resolveBusy = false;
+            resolveIdleCV.notify_all();
+            resolveCV.wait(guard);
+            continue;
+        }
+        std::string remote_agent = std::move(resolveQueue.front());
+        resolveQueue.erase(resolveQueue.begin());
+        resolveBusy = true;
+        guard.unlock();
+
+        // In batches, so transfers to the agent don't wait for all of them
+        bool done = false;
+        while (!done && !resolveStop) {
+            NIXL_SHARED_LOCK_GUARD(lock);
+            auto it = remoteSections.find(remote_agent);
+            done = (it == remoteSections.end()) ||
+                   it->second->resolvePending(NIXL_RESOLVE_BATCH);
+        }
+
+        guard.lock();
+    }
+}
+
+void nixlAgentData::reapRetired() {
+    reapPending = false;
+
+    for (auto it = retiredSections.begin(); it != retiredSections.end();) {
+        if ((*it)->inUse()) {
+            it++;
+            continue;
+        }
+        delete *it;
+        it = retiredSections.erase(it);
+    }
+
+    for (auto &[remote_agent, section] : remoteSections)
+        section->reapRemoved();
+}
+
+void nixlAgentData::dropRemoteSection(const std::string &remote_agent) {
+    auto it = remoteSections.find(remote_agent);
+    if (it != remoteSections.end()) {
+        nixlRemoteSection* section = it->second;
+        remoteMDBytes -= section->mdBytes;
+        remoteSections.erase(it);
+
+        // Outstanding handles fail their next post or check, but their backend
+        // handles might still point to the metadata until they are released
+        section->usage->stale = true;
+        if (section->inUse()) {
+            section->usage->retired = true;
+            retiredSections.push_back(section);
+        } else {
+            delete section;
+        }
+    }
+
+    if (plans)
+        plans->invalidate(remote_agent);
+    if (sched)
+        sched->removeRemote(remote_agent);
+}
+
+nixl_status_t nixlAgentData::dropRemoteMD(const std::string &remote_agent) {
+    nixl_status_t ret = NIXL_ERR_NOT_FOUND;
+    if (remoteSections.count(remote_agent) != 0)
+        ret = NIXL_SUCCESS;
+    dropRemoteSection(remote_agent);
+
+    if (remoteBackends.count(remote_agent) != 0) {
+        for (auto & it: remoteBackends[remote_agent])
+            backendEngines[it.first]->disconnect(remote_agent);
+        remoteBackends.erase(remote_agent);
+        ret = NIXL_SUCCESS;
+    }
+    return ret;
+}
+
+void nixlAgentData::evictRemoteMD(const std::string &keep_agent) {
+    const uint64_t max_agents = config.remoteMaxAgents;
+    const uint64_t max_bytes  = config.remoteMaxMDBytes;
+
+    while (true) {
+        // The local agent can have a section for local transfers, not counted
+        size_t agent_count = remoteSections.size() - remoteSections.count(name);
+        if (!((max_agents && (agent_count > max_agents)) ||
+              (max_bytes && (remoteMDBytes > max_bytes))))
+            return;
+
+        // Agents with outstanding transfer requests or prepared lists are kept, their
+        // backends might still use the metadata. Over the limits until released.
+        const std::string* lru_agent = nullptr;
+        uint64_t lru_use = UINT64_MAX;
+        for (auto &[remote_agent, section] : remoteSections) {
+            if ((remote_agent == name) || (remote_agent == keep_agent) || section->inUse())
+                continue;
+            uint64_t last_use = section->usage->lastUse.load(std::memory_order_relaxed);
+            if (last_use < lru_use) {
+                lru_use   = last_use;
+                lru_agent = &remote_agent;
+            }
+        }
+        if (!lru_agent)
+            return;
+
+        std::string remote_agent = *lru_agent;
+        NIXL_DEBUG << "Dropping metadata of least recently used agent: " << remote_agent;
+        dropRemoteMD(remote_agent);
+        remoteEvictions++;
+
+        std::lock_guard<std::mutex> guard(evictLock);
+        evictedAgents[remote_agent] = 0;
+    }
+}
+
+void nixlAgentData::refetchRemoteMD(const std::string &remote_agent) {
+    nixl_socket_peer_t source;
+    {
+        std::lock_guard<std::mutex> guard(evictLock);
+        // Kept until the fetch loads it, and fetched again after a while if it
+        // failed, rather than once per use meanwhile
+        auto evicted = evictedAgents.find(remote_agent);
+        if (evicted == evictedAgents.end())
+            return;
+        const nixlTime::us_t now = nixlTime::getUs();
+        if (evicted->second && (now - evicted->second < NIXL_REFETCH_INTERVAL_US))
+            return;
+        evicted->second = now;
+        auto it = mdSources.find(remote_agent);
+        if (it != mdSources.end())
+            source = it->second;
+    }
+
+    if (!commThread.joinable())
+        return;
+
+    if (!source.first.empty()) {
+        enqueueCommWork(std::make_tuple(SOCK_FETCH, source.first, source.second, ""));
+        return;
+    }
+#if HAVE_ETCD
+    if (useEtcd)
+        enqueueCommWork(std::make_tuple(ETCD_FETCH, remote_agent, 0, ""));
+#endif // HAVE_ETCD
+}
+
+std::unique_lock<std::mutex>
+nixlAgentData::lockEngine(nixlBackendEngine* engine) {
+    std::mutex* engine_lock = engineLocks.at(engine).get();
+    if (!engine_lock)
+        return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(*engine_lock);
+}
+
+nixlXferReqH* nixlAgentData::getXferReqH() {
+    return xferReqPool.get();
+}
+
+// Called with the engine lock held, if the request has an engine
+void nixlAgentData::putXferReqH(nixlXferReqH* req_hndl) {
+    if (req_hndl->backendHandle != nullptr)
+        req_hndl->engine->releaseReqH(req_hndl->backendHandle);
+
+    for (auto &stripe : req_hndl->stripes) {
+        const auto engine_lock = lockEngine(stripe->engine);
+        putXferReqH(stripe);
+    }
+    req_hndl->stripes.clear();
+
+    req_hndl->engine        = nullptr;
+    req_hndl->backendHandle = nullptr;
+    req_hndl->hasNotif      = false;
+    if (req_hndl->sectionUse.release())
+        reapPending = true;
+    if (req_hndl->sched)
+        req_hndl->sched->done(req_hndl);
+
+    req_hndl->selector      = nullptr;
+    req_hndl->postTime      = 0;
+    req_hndl->checkTime     = 0;
+    req_hndl->held          = false;
+    req_hndl->schedRemote   = nullptr;
+    req_hndl->initiatorDescs.clear();
+    req_hndl->targetDescs.clear();
+    xferReqPool.put(req_hndl);
+}
+
+void nixlXferReqH::postDone(const bool exact) {
+    if (postTime != 0) {
+        // A check finds the transfer done some time after it was, since the last check
+        // that didn't. It's measured if that time is short compared to the transfer.
+        const nixlTime::ns_t now  = nixlTime::getNs();
+        const nixlTime::ns_t last = exact ? now : std::max(checkTime, postTime);
+        if ((status == NIXL_SUCCESS) && (now - last <= last - postTime))
+            selector->addSample(engine, remoteAgent, xferBytes,
+                                initiatorDescs.descCount(),
+                                (last + now) / 2 - postTime);
+        postTime  = 0;
+        checkTime = 0;
+    }
+
+    if (sched)
+        sched->done(this);
+}
+
+void nixlXferReqH::checked() {
+    if (status != NIXL_IN_PROG)
+        postDone();
+    else if (postTime != 0)
+        checkTime = nixlTime::getNs();
+}
+
+// Set while the outermost user callbacks of a thread are called
+static thread_local std::vector<nixlXferReqH*>* deferredCbs = nullptr;
+
+void nixlXferReqH::callUserCbs(nixlXferReqH* const* reqs, const size_t count) {
+    if (deferredCbs) {
+        deferredCbs->insert(deferredCbs->end(), reqs, reqs + count);
+        return;
+    }
+
+    std::vector<nixlXferReqH*> deferred;
+    deferredCbs = &deferred;
+    for (size_t i = 0; i < count; ++i)
+        reqs[i]->callUserCb();
+    // Can grow while the callbacks are called
+    for (size_t i = 0; i < deferred.size(); ++i) {
+        nixlXferReqH* req_hndl = deferred[i];
+        req_hndl->callUserCb();
+    }
+    deferredCbs = nullptr;
+}
+
+nixl_status_t nixlAgentData::trackXfer(nixlXferReqH* req_hndl,
+                                       const nixl_opt_args_t* extra_params,
+                                       nixl_opt_b_args_t &opt_args) {
+    if (!extra_params || (!extra_params->xferCQ && !extra_params->completionCb))
+        return NIXL_SUCCESS;
+
+    if (extra_params->xferCQ && extra_params->completionCb)
+        return NIXL_ERR_INVALID_PARAM;
+
+    req_hndl->backendCb = req_hndl->engine->supportsXferCb();
+    if (req_hndl->backendCb) {
+        opt_args.xferCb    = nixlXferReqH::completionCb;
+        opt_args.xferCbArg = req_hndl;
+    }
+
+    if (extra_params->xferCQ) {
+        extra_params->xferCQ->attach(req_hndl);
+    } else {
+        req_hndl->userCbCtx = extra_params->completionCtx;
+        req_hndl->userCb    = extra_params->completionCb;
+    }
+    return NIXL_SUCCESS;
+}
+
+void nixlAgentData::trackedPost(nixlXferReqH* req_hndl, const nixl_status_t ret,
+                                const nixl_opt_b_args_t &opt_args) {
+    // The backend reports it, and might have done so already, after which the
+    // request can be polled and reused by another thread. Not to be touched.
+    if ((ret == NIXL_IN_PROG) && opt_args.xferCb)
+        return;
+
+    if (!req_hndl->tracked())
+        return;
+
+    if (ret < 0) {
+        if (req_hndl->cq)
+            req_hndl->cq->detach(req_hndl);
+        req_hndl->userCb = nullptr;
+    } else if (ret == NIXL_SUCCESS) {
+        // User callback is called by the caller, after releasing the locks
+        if (req_hndl->cq)
+            req_hndl->cq->add(req_hndl, true);
+    } else if (req_hndl->cq) {
+        req_hndl->cq->add(req_hndl, false);
+    } else {
+        const std::lock_guard<std::mutex> guard(cbPendingLock);
+        cbPending.push_back(req_hndl);
+    }
+}
+
+nixl_status_t nixlAgentData::issueXfer(nixlXferReqH* req_hndl,
+                                       const nixl_opt_b_args_t &opt_args) {
+    nixl_status_t ret;
+
+    // Set before the post, as the completion callback might be called before it returns
+    req_hndl->status = NIXL_IN_PROG;
+    if (req_hndl->selector)
+        req_hndl->postTime = nixlTime::getNs();
+
+    ret = req_hndl->engine->postXfer (req_hndl->backendOp,
+                                      req_hndl->initiatorDescs,
+                                      req_hndl->targetDescs,
+                                      req_hndl->remoteAgent,
+                                      req_hndl->backendHandle,
+                                      &opt_args);
+    if (ret != NIXL_IN_PROG) {
+        req_hndl->status = ret;
+        req_hndl->postDone(true);
+    }
+    return ret;
+}
+
+void nixlAgentData::issueHeld() {
+    std::vector<nixlXferReqH*> reqs;
+
+    if (!sched || !sched->hasQueued())
+        return;
+    sched->pop(reqs);
+
+    for (auto &req_hndl : reqs) {
+        nixl_opt_b_args_t opt_args;
+        nixl_status_t     ret;
+        const bool        tracked = req_hndl->tracked();
+
+        if (req_hndl->hasNotif) {
+            opt_args.notifMsg = req_hndl->notifMsg;
+            opt_args.hasNotif = true;
+        }
+        if (tracked && req_hndl->backendCb) {
+            opt_args.xferCb    = nixlXferReqH::completionCb;
+            opt_args.xferCbArg = req_hndl;
+        }
+
+        // Once issued, tracked posts are only touched by their completion reporting,
+        // while the user can check other ones as soon as they're not held anymore
+        if (tracked)
+            req_hndl->held = false;
+
+        {
+            const auto engine_lock = lockEngine(req_hndl->engine);
+            if (!remoteValid(req_hndl->remoteAgent, req_hndl->sectionUse)) {
+                req_hndl->status = NIXL_ERR_NOT_FOUND;
+                req_hndl->postDone();
+                ret = NIXL_ERR_NOT_FOUND;
+            } else {
+                ret = issueXfer(req_hndl, opt_args);
+            }
+
+            // The post was accepted when it was held, so failures are reported
+            // through the completion reporting as well
+            if (tracked) {
+                if (ret == NIXL_IN_PROG) {
+                    trackedPost(req_hndl, ret, opt_args);
+                } else if (req_hndl->cq) {
+                    req_hndl->cq->add(req_hndl, true);
+                } else {
+                    const std::lock_guard<std::mutex> guard(cbPendingLock);
+                    cbDone.push_back(req_hndl);
+                }
+            }
+        }
+
+        if (!tracked)
+            req_hndl->held = false;
+    }
+}
+
+// Both lists are updated in place, the sort uses the scratch space of the request.
+// The sorted flags of the lists are checked again once they are reordered or split.
+void nixlAgentData::optimizeDescs(nixlXferReqH* req_hndl, const bool merge,
+                                  const bool sort) {
+    nixl_meta_dlist_t &local  = req_hndl->initiatorDescs;
+    nixl_meta_dlist_t &remote = req_hndl->targetDescs;
+    int                count  = local.descCount();
+
+    auto verify_sorted = [&]() {
+        if (local.isSorted())
+            local.verifySorted();
+        if (remote.isSorted() || sort)
+            remote.verifySorted();
+    };
+
+    if (sort && (count > 1)) {
+        auto &pairs = req_hndl->descPairs;
+        pairs.clear();
+        for (int i=0; i<count; ++i)
+            pairs.emplace_back(local[i], remote[i]);
+
+        std::stable_sort(pairs.begin(), pairs.end(),
+                         [](const auto &lhs, const auto &rhs) {
+                             if (lhs.second.devId != rhs.second.devId)
+                                 return lhs.second.devId < rhs.second.devId;
+                             return lhs.second.addr < rhs.second.addr;
+                         });
+
+        for (int i=0; i<count; ++i) {
+            local[i]  = pairs[i].first;
+            remote[i] = pairs[i].second;
+        }
+    }
+
+    if (merge && (count > 1)) {
+        int j = 0;
+        for (int i=1; i<count; ++i) {
+            if (((local[j].addr + local[j].len) == local[i].addr)
+                  && ((remote[j].addr + remote[j].len) == remote[i].addr)
+                  && (local[j].metadataP == local[i].metadataP)
+                  && (remote[j].metadataP == remote[i].metadataP)
+                  && (local[j].devId == local[i].devId)
+                  && (remote[j].devId == remote[i].devId)) {
+                local[j].len  += local[i].len;
+                remote[j].len += remote[i].len;
+            } else {
+                j++;
+                local[j]  = local[i];
+                remote[j] = remote[i];
+            }
+        }
+
+        if (j + 1 < count) {
+            descsMerged += count - (j + 1);
+            count = j + 1;
+            local.resize(count);
+            remote.resize(count);
+        }
+    }
+
+    const size_t chunk = req_hndl->engine->getChunkSize();
+    size_t       extra = 0;
+    if (chunk > 0)
+        for (int i=0; i<count; ++i)
+            if (local[i].len > chunk)
+                extra += (local[i].len - 1) / chunk;
+    if (extra == 0) {
+        if (sort)
+            verify_sorted();
+        return;
+    }
+
+    // Filled from the back, so each descriptor is read before it's overwritten
+    local.resize(count + extra);
+    remote.resize(count + extra);
+    size_t w = count + extra;
+    for (int i=count-1; i>=0; --i) {
+        const nixlMetaDesc local_desc  = local[i];
+        const nixlMetaDesc remote_desc = remote[i];
+        size_t pieces = (local_desc.len <= chunk) ? 1 :
+                        (local_desc.len + chunk - 1) / chunk;
+
+        for (size_t k=pieces; k>0; --k) {
+            size_t off = (k - 1) * chunk;
+            size_t len = std::min(chunk, local_desc.len - off);
+
+            --w;
+            local[w]       = local_desc;
+            local[w].addr += off;
+            local[w].len   = len;
+            remote[w]       = remote_desc;
+            remote[w].addr += off;
+            remote[w].len   = len;
+        }
+    }
+    descsSplit += extra;
+    verify_sorted();
+}
+
+// Each of the stripes is populated with the whole transfer, and then trimmed to
+// its share. Descriptors are split at the share boundaries.
+nixl_status_t nixlAgentData::createStripes(std::vector<nixlXferReqH*> &stripes,
+                                           const nixl_xfer_op_t &operation,
+                                           const std::string &remote_agent,
+                                           const nixl_opt_args_t* extra_params,
+                                           nixlXferReqH* &req_hndl) {
+    nixl_status_t ret;
+    uint64_t      total   = 0;
+    uint64_t      weights = 0;
+
+    for (auto &desc : stripes[0]->initiatorDescs)
+        total += desc.len;
+
+    // Backends are found in no particular order, the ones with the least weight are dropped
+    std::stable_sort(stripes.begin(), stripes.end(),
+                     [](const nixlXferReqH* a, const nixlXferReqH* b) {
+                         return a->engine->getStripeWeight() > b->engine->getStripeWeight();
+                     });
+
+    size_t max_stripes = std::max<uint64_t>(1, total / NIXL_STRIPE_MIN_SIZE);
+    while (stripes.size() > max_stripes) {
+        putXferReqH(stripes.back());
+        stripes.pop_back();
+    }
+
+    for (auto &stripe : stripes)
+        weights += stripe->engine->getStripeWeight();
+
+    uint64_t left = total;
+    int      idx  = 0;
+    size_t   off  = 0;
+    for (size_t i = 0; i < stripes.size(); ++i) {
+        nixlXferReqH* stripe = stripes[i];
+        uint64_t share = (i == stripes.size() - 1) ? left :
+                         (uint64_t) ((double) total *
+                                     stripe->engine->getStripeWeight() / weights);
+        left -= share;
+
+        nixl_meta_dlist_t local_full  = stripe->initiatorDescs;
+        nixl_meta_dlist_t remote_full = stripe->targetDescs;
+        stripe->initiatorDescs.reset(local_full.getType());
+        stripe->targetDescs.reset(remote_full.getType());
+
+        while ((share > 0) && (idx < local_full.descCount())) {
+            nixlMetaDesc local_desc  = local_full[idx];
+            nixlMetaDesc remote_desc = remote_full[idx];
+            size_t       len         = std::min<uint64_t>(share, local_desc.len - off);
+
+            local_desc.addr  += off;
+            local_desc.len    = len;
+            remote_desc.addr += off;
+            remote_desc.len   = len;
+            stripe->initiatorDescs.addDesc(local_desc);
+            stripe->targetDescs.addDesc(remote_desc);
+
+            share -= len;
+            off   += len;
+            if (off == local_full[idx].len) {
+                idx++;
+                off = 0;
+            }
+        }
+    }
+
+    // Low weight backends might get no share at all
+    for (auto it = stripes.begin(); it != stripes.end();) {
+        if ((*it)->initiatorDescs.descCount() == 0) {
+            putXferReqH(*it);
+            it = stripes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // The remaining stripe has the whole transfer, and is prepared as a plain request
+    if (stripes.size() == 1)
+        return NIXL_SUCCESS;
+
+    nixl_opt_b_args_t opt_args;
+    if (extra_params)
+        opt_args.completion = extra_params->completion;
+
+    for (auto &stripe : stripes) {
+        {
+            const auto engine_lock = lockEngine(stripe->engine);
+
+            optimizeDescs(stripe, extra_params && extra_params->mergeDescs
+                                      && !extra_params->skipDescMerge,
+                          extra_params && extra_params->sortDescs);
+
+            stripe->remoteAgent = remote_agent;
+            stripe->backendOp   = operation;
+            stripe->status      = NIXL_ERR_NOT_POSTED;
+            stripe->hasNotif    = false;
+
+            ret = stripe->engine->prepXfer (stripe->backendOp,
+                                            stripe->initiatorDescs,
+                                            stripe->targetDescs,
+                                            stripe->remoteAgent,
+                                            stripe->backendHandle,
+                                            &opt_args);
+        }
+
+        if (ret != NIXL_SUCCESS) {
+            for (auto &elm : stripes) {
+                const auto engine_lock = lockEngine(elm->engine);
+                putXferReqH(elm);
+            }
+            return ret;
+        }
+    }
+
+    req_hndl = getXferReqH();
+    req_hndl->remoteAgent = remote_agent;
+    req_hndl->backendOp   = operation;
+    req_hndl->status      = NIXL_ERR_NOT_POSTED;
+    req_hndl->stripes.swap(stripes);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlAgentData::postStripes(nixlXferReqH* req_hndl) {
+    nixl_opt_b_args_t opt_args;
+    nixl_status_t     ret = NIXL_SUCCESS;
+
+    // We can't repost while any of the stripes is in progress, which the status
+    // of the request doesn't tell once another stripe failed
+    for (auto &stripe : req_hndl->stripes) {
+        if (stripe->status != NIXL_IN_PROG)
+            continue;
+        const auto engine_lock = lockEngine(stripe->engine);
+        stripe->status = stripe->engine->checkXfer(stripe->backendHandle);
+        if (stripe->status == NIXL_IN_PROG)
+            return NIXL_ERR_REPOST_ACTIVE;
+    }
+
+    // First error, otherwise in progress if any stripe is
+    for (auto &stripe : req_hndl->stripes) {
+        const auto engine_lock = lockEngine(stripe->engine);
+        stripe->status = stripe->engine->postXfer (stripe->backendOp,
+                                                   stripe->initiatorDescs,
+                                                   stripe->targetDescs,
+                                                   stripe->remoteAgent,
+                                                   stripe->backendHandle,
+                                                   &opt_args);
+        if ((ret >= 0) && (stripe->status != NIXL_SUCCESS))
+            ret = stripe->status;
+    }
+
+    req_hndl->status = ret;
+    return ret;
+}
+
+nixl_status_t nixlAgentData::checkStripes(nixlXferReqH* req_hndl) {
+    nixl_status_t ret = NIXL_SUCCESS;
+
+    for (auto &stripe : req_hndl->stripes) {
+        if (stripe->status != NIXL_SUCCESS) {
+            const auto engine_lock = lockEngine(stripe->engine);
+            stripe->status = stripe->engine->checkXfer(stripe->backendHandle);
+        }
+        if ((ret >= 0) && (stripe->status != NIXL_SUCCESS))
+            ret = stripe->status;
+    }
+
+    req_hndl->status = ret;
+    return ret;
+}
+
+nixl_status_t nixlAgentData::releaseStripes(nixlXferReqH* req_hndl) {
+    // Stripes that are released are removed, so a failed call can be retried
+    while (req_hndl->striped()) {
+        nixlXferReqH* stripe = req_hndl->stripes.back();
+        const auto engine_lock = lockEngine(stripe->engine);
+
+        if (stripe->status == NIXL_IN_PROG) {
+            stripe->status = stripe->engine->checkXfer(stripe->backendHandle);
+
+            if (stripe->status == NIXL_IN_PROG) {
+                stripe->status = stripe->engine->releaseReqH(stripe->backendHandle);
+                if (stripe->status < 0)
+                    return NIXL_ERR_REPOST_ACTIVE;
+                stripe->backendHandle = nullptr;
+            }
+        }
+        putXferReqH(stripe);
+        req_hndl->stripes.pop_back();
+    }
+
+    putXferReqH(req_hndl);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlAgentData::releaseReq(nixlXferReqH* req_hndl) {
+    if (req_hndl->striped())
+        return releaseStripes(req_hndl);
+
+    // A held post that is not being issued is just dropped
+    if (req_hndl->held) {
+        if (!sched->cancel(req_hndl))
+            return NIXL_ERR_REPOST_ACTIVE;
+        req_hndl->status = NIXL_ERR_NOT_POSTED;
+    }
+
+    const auto engine_lock = lockEngine(req_hndl->engine);
+    //attempt to cancel request
+    if(req_hndl->status == NIXL_IN_PROG) {
+        req_hndl->status = req_hndl->engine->checkXfer(
+                                     req_hndl->backendHandle);
+
+        if(req_hndl->status == NIXL_IN_PROG) {
+
+            req_hndl->status = req_hndl->engine->releaseReqH(
+                                         req_hndl->backendHandle);
+
+            if(req_hndl->status < 0)
+                return NIXL_ERR_REPOST_ACTIVE;
+
+            // just in case the backend doesn't set to NULL on success
+            // this will prevent calling releaseReqH again in destructor
+            req_hndl->backendHandle = nullptr;
+        }
+    }
+    putXferReqH(req_hndl);
+    return NIXL_SUCCESS;
+}
+
 /*** nixlAgent implementation ***/
 nixlAgent::nixlAgent(const std::string &name, const nixlAgentConfig &cfg) :
     data(std::make_unique<nixlAgentData>(name, cfg))
@@ -182,7 +921,7 @@ nixlAgent::getBackendParams (const nixlBackendH* backend,
     if (!backend)
         return NIXL_ERR_INVALID_PARAM;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
     mems   = backend->engine->getSupportedMems();
     params = backend->engine->getCustomParams();
     return NIXL_SUCCESS;
@@ -236,6 +975,8 @@ nixlAgent::createBackend(const nixl_backend_t &type,
                 return ret;
             }
             data->connMD[type] = str;
+            // Peers need the new conn info, so no delta from before it
+            data->memorySection->resetLog();
         }
 
         if (backend->supportsLocal()) {
@@ -253,8 +994,17 @@ nixlAgent::createBackend(const nixl_backend_t &type,
             return NIXL_ERR_BACKEND;
         }
 
+        // A new backend can be preferred over the one of existing plans
+        if (data->plans)
+            data->plans->invalidate();
+
         data->backendEngines[type] = backend;
         data->backendHandles[type] = bknd_hndl;
+        data->selector->addEngine(backend);
+        if (data->lock.isStrict() && !backend->supportsConcurrentXfer())
+            data->engineLocks[backend] = std::make_unique<std::mutex>();
+        else
+            data->engineLocks[backend] = nullptr;
         mems = backend->getSupportedMems();
         for (auto & elm : mems) {
             backend_list = &data->memToBackend[elm];
@@ -276,80 +1026,194 @@ nixlAgent::createBackend(const nixl_backend_t &type,
 }
 
 nixl_status_t
-nixlAgent::registerMem(const nixl_reg_dlist_t &descs,
-                       const nixl_opt_args_t* extra_params) {
-
-    backend_list_t* backend_list;
-    nixl_status_t   ret;
-    unsigned int    count = 0;
-
-    NIXL_LOCK_GUARD(data->lock);
-    if (!extra_params || extra_params->backends.size() == 0) {
-        backend_list = &data->memToBackend[descs.getType()];
-        if (backend_list->empty())
-            return NIXL_ERR_NOT_FOUND;
-    } else {
-        backend_list = new backend_list_t();
-        for (auto & elm : extra_params->backends)
-            backend_list->push_back(elm->engine);
-    }
+nixlAgentData::addRegistrations(const nixl_reg_dlist_t &descs,
+                                const backend_list_t &backends) {
+    nixl_status_t ret;
+    unsigned int  count = 0;
 
     // Best effort, if at least one succeeds NIXL_SUCCESS is returned
     // Can become more sophisticated to have a soft error case
-    for (size_t i=0; i<backend_list->size(); ++i) {
-        nixlBackendEngine* backend = (*backend_list)[i];
+    for (nixlBackendEngine* backend : backends) {
         // meta_descs use to be passed to loadLocalData
         nixl_sec_dlist_t sec_descs(descs.getType(), false);
-        ret = data->memorySection->addDescList(descs, backend, sec_descs);
+        auto start = std::chrono::steady_clock::now();
+        ret = memorySection->addDescList(descs, backend, sec_descs);
+        auto &reg_time = regTimes[backend];
+        reg_time.first += std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - start).count();
         if (ret == NIXL_SUCCESS) {
             if (backend->supportsLocal()) {
-                if (data->remoteSections.count(data->name) == 0)
-                    data->remoteSections[data->name] =
-                          new nixlRemoteSection(data->name);
+                if (remoteSections.count(name) == 0)
+                    remoteSections[name] =
+                          new nixlRemoteSection(name);
 
-                ret = data->remoteSections[data->name]->loadLocalData(
+                ret = remoteSections[name]->loadLocalData(
                                                         sec_descs, backend);
                 if (ret == NIXL_SUCCESS)
                     count++;
                 else
-                    data->memorySection->remDescList(descs, backend);
+                    memorySection->remDescList(descs, backend);
             } else {
                 count++;
             }
+            if (ret == NIXL_SUCCESS)
+                reg_time.second += descs.descCount();
         } // a bad_ret can be saved in an else
     }
 
-    if (extra_params && extra_params->backends.size() > 0)
-        delete backend_list;
-
     if (count > 0)
         return NIXL_SUCCESS;
     else
         return NIXL_ERR_BACKEND;
 }
 
-nixl_status_t
-nixlAgent::deregisterMem(const nixl_reg_dlist_t &descs,
-                         const nixl_opt_args_t* extra_params) {
+void nixlAgentData::regWorker(nixlRegH* reg_hndl) {
+    const int     batch = std::max(config.regThreads, (uint64_t) 1);
+    const int     count = reg_hndl->descs.descCount();
+    nixl_status_t ret   = NIXL_SUCCESS;
 
+    for (int i = 0; i < count; i += batch) {
+        nixl_reg_dlist_t part(reg_hndl->descs.getType(), false);
+        for (int j = i; j < std::min(i + batch, count); ++j)
+            part.addDesc(reg_hndl->descs[j]);
 
-    backend_set_t     backend_set;
-    nixl_status_t     ret, bad_ret=NIXL_SUCCESS;
+        {
+            NIXL_LOCK_GUARD(lock);
+            ret = addRegistrations(part, reg_hndl->backends);
+        }
+        if (ret != NIXL_SUCCESS)
+            break;
 
-    NIXL_LOCK_GUARD(data->lock);
-    if (!extra_params || extra_params->backends.size() == 0) {
-        backend_set_t* avail_backends;
-        avail_backends = data->memorySection->queryBackends(
-                                              descs.getType());
-        if (!avail_backends || avail_backends->empty())
-            return NIXL_ERR_NOT_FOUND;
-        // Make a copy as we might change it in remDescList
-        backend_set = *avail_backends;
-    } else {
-        for (auto & elm : extra_params->backends)
+        reg_hndl->registered += part.descCount();
+        reg_hndl->batches.push_back(std::move(part));
+    }
+
+    // Undo the batches done, so a failed registration leaves nothing registered
+    if (ret != NIXL_SUCCESS) {
+        NIXL_LOCK_GUARD(lock);
+        if (plans)
+            plans->invalidate();
+        for (auto &part : reg_hndl->batches)
+            for (nixlBackendEngine* backend : reg_hndl->backends)
+                memorySection->remDescList(part, backend);
+        reg_hndl->registered = 0;
+    }
+    reg_hndl->batches.clear();
+
+    {
+        std::lock_guard<std::mutex> guard(reg_hndl->statusLock);
+        reg_hndl->status = ret;
+    }
+    reg_hndl->statusCV.notify_all();
+}
+
+nixl_status_t
+nixlAgent::registerMem(const nixl_reg_dlist_t &descs,
+                       const nixl_opt_args_t* extra_params) {
+
+    NIXL_LOCK_GUARD(data->lock);
+    if (!extra_params || extra_params->backends.size() == 0) {
+        if (data->memToBackend[descs.getType()].empty())
+            return NIXL_ERR_NOT_FOUND;
+        return data->addRegistrations(descs, data->memToBackend[descs.getType()]);
+    }
+
+    backend_list_t backend_list;
+    for (auto & elm : extra_params->backends)
+        backend_list.push_back(elm->engine);
+    return data->addRegistrations(descs, backend_list);
+}
+
+nixl_status_t
+nixlAgent::registerMemAsync(const nixl_reg_dlist_t &descs,
+                            nixlRegH* &reg_hndl,
+                            const nixl_opt_args_t* extra_params) {
+    backend_list_t backend_list;
+
+    // The background thread relies on the agent lock against the other calls
+    if (!data->lock.isStrict())
+        return NIXL_ERR_NOT_ALLOWED;
+
+    {
+        NIXL_SHARED_LOCK_GUARD(data->lock);
+        if (!extra_params || extra_params->backends.size() == 0) {
+            backend_list = data->memToBackend[descs.getType()];
+            if (backend_list.empty())
+                return NIXL_ERR_NOT_FOUND;
+        } else {
+            for (auto & elm : extra_params->backends)
+                backend_list.push_back(elm->engine);
+        }
+    }
+
+    reg_hndl = new nixlRegH(descs, backend_list);
+    {
+        std::lock_guard<std::mutex> guard(data->regHandlesLock);
+        data->regHandles.insert(reg_hndl);
+    }
+    reg_hndl->worker = std::thread(&nixlAgentData::regWorker, data.get(), reg_hndl);
+    return NIXL_IN_PROG;
+}
+
+nixl_status_t
+nixlAgent::getRegStatus(nixlRegH* reg_hndl,
+                        const bool wait,
+                        int* registered) const {
+    if (!reg_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    std::unique_lock<std::mutex> guard(reg_hndl->statusLock);
+    if (wait)
+        reg_hndl->statusCV.wait(guard, [reg_hndl] {
+            return reg_hndl->status != NIXL_IN_PROG; });
+    if (registered)
+        *registered = reg_hndl->registered;
+    return reg_hndl->status;
+}
+
+nixl_status_t
+nixlAgent::releaseRegH(nixlRegH* reg_hndl) {
+    if (!reg_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    {
+        std::lock_guard<std::mutex> guard(data->regHandlesLock);
+        if (data->regHandles.erase(reg_hndl) == 0)
+            return NIXL_ERR_NOT_FOUND;
+    }
+    reg_hndl->worker.join();
+
+    nixl_status_t ret = reg_hndl->status;
+    delete reg_hndl;
+    return ret;
+}
+
+nixl_status_t
+nixlAgent::deregisterMem(const nixl_reg_dlist_t &descs,
+                         const nixl_opt_args_t* extra_params) {
+
+
+    backend_set_t     backend_set;
+    nixl_status_t     ret, bad_ret=NIXL_SUCCESS;
+
+    NIXL_LOCK_GUARD(data->lock);
+    if (!extra_params || extra_params->backends.size() == 0) {
+        backend_set_t* avail_backends;
+        avail_backends = data->memorySection->queryBackends(
+                                              descs.getType());
+        if (!avail_backends || avail_backends->empty())
+            return NIXL_ERR_NOT_FOUND;
+        // Make a copy as we might change it in remDescList
+        backend_set = *avail_backends;
+    } else {
+        for (auto & elm : extra_params->backends)
             backend_set.insert(elm->engine);
     }
 
+    // Plans might point to the metadata of the removed registrations
+    if (data->plans)
+        data->plans->invalidate();
+
     // Doing best effort, and returning err if any
     for (auto & backend : backend_set) {
         ret = data->memorySection->remDescList(descs, backend);
@@ -412,17 +1276,24 @@ nixlAgent::prepXferDlist (const std::string &agent_name,
     nixl_status_t  ret;
     int            count = 0;
     bool           init_side = (agent_name == NIXL_INIT_AGENT);
+    nixlRemoteSection* remote_section = nullptr;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
     // When central KV is supported, still it should return error,
     // just we can add a call to fetchRemoteMD for next time
-    if (!init_side && (data->remoteSections.count(agent_name) == 0))
-        return NIXL_ERR_NOT_FOUND;
+    if (!init_side) {
+        auto it = data->remoteSections.find(agent_name);
+        if (it == data->remoteSections.end()) {
+            data->refetchRemoteMD(agent_name);
+            return NIXL_ERR_NOT_FOUND;
+        }
+        remote_section = it->second;
+        remote_section->touch();
+    }
 
     if (!extra_params || extra_params->backends.size() == 0) {
         if (!init_side)
-            backend_set = data->remoteSections[agent_name]->
-                                queryBackends(descs.getType());
+            backend_set = remote_section->queryBackends(descs.getType());
         else
             backend_set = data->memorySection->
                                 queryBackends(descs.getType());
@@ -444,6 +1315,7 @@ nixlAgent::prepXferDlist (const std::string &agent_name,
     } else {
         handle->isLocal     = false;
         handle->remoteAgent = agent_name;
+        handle->sectionUse.acquire(remote_section->usage);
     }
 
     for (auto & backend : *backend_set) {
@@ -454,7 +1326,7 @@ nixlAgent::prepXferDlist (const std::string &agent_name,
             ret = data->memorySection->populate(
                        descs, backend, *(handle->descs[backend]));
         else
-            ret = data->remoteSections[agent_name]->populate(
+            ret = remote_section->populate(
                        descs, backend, *(handle->descs[backend]));
         if (ret == NIXL_SUCCESS) {
             count++;
@@ -477,19 +1349,107 @@ nixlAgent::prepXferDlist (const std::string &agent_name,
     }
 }
 
+namespace {
+
+// Indices to one side of makeXferReq, given as a list
+class nixlIdxList {
+    private:
+        const std::vector<int> &idx;
+        size_t                  pos = 0;
+
+    public:
+        nixlIdxList(const std::vector<int> &idx) : idx(idx) { }
+
+        size_t count() const { return idx.size(); }
+
+        bool inBounds(const int desc_count) const {
+            for (auto &i : idx)
+                if ((i < 0) || (i >= desc_count))
+                    return false;
+            return true;
+        }
+
+        void rewind() { pos = 0; }
+        int  next()   { return idx[pos++]; }
+};
+
+// Indices to one side of makeXferReq, given as ranges that are walked in place
+class nixlIdxRangeList {
+    private:
+        const nixl_idx_ranges_t &ranges;
+        size_t                   total = 0;
+        size_t                   range = 0;
+        int                      step  = 0;
+
+        void skipEmpty() {
+            while ((range < ranges.size()) && (ranges[range].count <= 0))
+                range++;
+        }
+
+    public:
+        nixlIdxRangeList(const nixl_idx_ranges_t &ranges) : ranges(ranges) {
+            for (auto &r : ranges)
+                if (r.count > 0)
+                    total += r.count;
+            skipEmpty();
+        }
+
+        size_t count() const { return total; }
+
+        // Only the first and last index of each range need to be checked, as
+        // ranges go forward. Backward or repeated indices are listed instead.
+        bool inBounds(const int desc_count) const {
+            for (auto &r : ranges) {
+                if ((r.count < 0) || (r.stride <= 0))
+                    return false;
+                if (r.count == 0)
+                    continue;
+                int64_t last = r.start + (int64_t) (r.count - 1) * r.stride;
+                if ((r.start < 0) || (r.start >= desc_count) ||
+                    (last < 0) || (last >= desc_count))
+                    return false;
+            }
+            return true;
+        }
+
+        void rewind() {
+            range = 0;
+            step  = 0;
+            skipEmpty();
+        }
+
+        int next() {
+            const nixlIdxRange &r = ranges[range];
+            int idx = r.start + step * r.stride;
+            if (++step == r.count) {
+                range++;
+                step = 0;
+                skipEmpty();
+            }
+            return idx;
+        }
+};
+
+} // anonymous namespace
+
+template <class idx_list_t>
 nixl_status_t
-nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
-                        const nixlDlistH* local_side,
-                        const std::vector<int> &local_indices,
-                        const nixlDlistH* remote_side,
-                        const std::vector<int> &remote_indices,
-                        nixlXferReqH* &req_hndl,
-                        const nixl_opt_args_t* extra_params) const {
+nixlAgentData::makeXferReq(const nixl_xfer_op_t &operation,
+                           const nixlDlistH* local_side,
+                           idx_list_t &local_idx,
+                           const nixlDlistH* remote_side,
+                           idx_list_t &remote_idx,
+                           nixlXferReqH* &req_hndl,
+                           const nixl_opt_args_t* extra_params) {
 
     nixl_opt_b_args_t  opt_args;
     nixl_status_t      ret;
-    int                desc_count = (int) local_indices.size();
+    size_t             desc_count = local_idx.count();
     nixlBackendEngine* backend    = nullptr;
+    backend_list_t     candidates;
+    size_t             bytes      = 0;
+    const bool         merge      = !(extra_params && extra_params->skipDescMerge);
+    const bool         sort       = extra_params && extra_params->sortDescs;
 
     req_hndl = nullptr;
 
@@ -499,143 +1459,165 @@ nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
     if ((!local_side->isLocal) || (remote_side->isLocal))
         return NIXL_ERR_INVALID_PARAM;
 
-    NIXL_LOCK_GUARD(data->lock);
+    if ((desc_count == 0) || (desc_count != remote_idx.count()))
+        return NIXL_ERR_INVALID_PARAM;
+
+    NIXL_SHARED_LOCK_GUARD(lock);
     // The remote was invalidated in between prepXferDlist and this call
-    if (data->remoteSections.count(remote_side->remoteAgent) == 0) {
-        delete req_hndl;
+    if (!remoteValid(remote_side->remoteAgent, remote_side->sectionUse))
         return NIXL_ERR_NOT_FOUND;
-    }
 
+    // Candidates are the backends common to both sides, in the given order if
+    // limited by the user, otherwise in their creation order
     if (extra_params && extra_params->backends.size() > 0) {
-        for (auto & elm : extra_params->backends) {
+        for (auto & elm : extra_params->backends)
             if ((local_side->descs.count(elm->engine) > 0) &&
-                (remote_side->descs.count(elm->engine) > 0)) {
-                backend = elm->engine;
-                break;
-            }
-        }
-    } else {
-        for (auto & loc_bknd : local_side->descs) {
-            for (auto & rem_bknd : remote_side->descs) {
-                if (loc_bknd.first == rem_bknd.first) {
-                    backend = loc_bknd.first;
-                    break;
-                }
-            }
-            if (backend)
-                break;
-        }
+                (remote_side->descs.count(elm->engine) > 0))
+                candidates.push_back(elm->engine);
+    } else if (!local_side->descs.empty()) {
+        nixl_mem_t mem_type = local_side->descs.begin()->second->getType();
+        for (auto & engine : memToBackend[mem_type])
+            if ((local_side->descs.count(engine) > 0) &&
+                (remote_side->descs.count(engine) > 0))
+                candidates.push_back(engine);
     }
 
-    if (!backend)
+    if (candidates.empty())
         return NIXL_ERR_INVALID_PARAM;
 
-    nixl_meta_dlist_t* local_descs  = local_side->descs.at(backend);
-    nixl_meta_dlist_t* remote_descs = remote_side->descs.at(backend);
-
-    if ((desc_count == 0) || (remote_indices.size() == 0) ||
-        (desc_count != (int) remote_indices.size()))
+    // The prepared lists of all the backends have the same descriptors
+    const nixl_meta_dlist_t* cand_local  = local_side->descs.at(candidates[0]);
+    const nixl_meta_dlist_t* cand_remote = remote_side->descs.at(candidates[0]);
+    if (!local_idx.inBounds(cand_local->descCount()) ||
+        !remote_idx.inBounds(cand_remote->descCount()))
         return NIXL_ERR_INVALID_PARAM;
 
-    for (int i=0; i<desc_count; ++i) {
-        if ((local_indices[i] >= local_descs->descCount())
-               || (local_indices[i]<0))
-            return NIXL_ERR_INVALID_PARAM;
-        if ((remote_indices[i] >= remote_descs->descCount())
-               || (remote_indices[i]<0))
-            return NIXL_ERR_INVALID_PARAM;
-        if ((*local_descs )[local_indices [i]].len !=
-            (*remote_descs)[remote_indices[i]].len)
-            return NIXL_ERR_INVALID_PARAM;
-    }
+    for (size_t i=0; i<desc_count; ++i)
+        bytes += (*cand_local)[local_idx.next()].len;
+    local_idx.rewind();
+
+    if (selector->measures())
+        selector->order(candidates, remote_side->remoteAgent, bytes, desc_count);
+    backend = candidates[0];
+
+    const auto engine_lock = lockEngine(backend);
+
+    nixl_meta_dlist_t* local_descs  = local_side->descs.at(backend);
+    nixl_meta_dlist_t* remote_descs = remote_side->descs.at(backend);
 
     if (extra_params && extra_params->hasNotif) {
         opt_args.notifMsg = extra_params->notifMsg;
         opt_args.hasNotif = true;
     }
+    if (extra_params)
+        opt_args.completion = extra_params->completion;
 
     if ((opt_args.hasNotif) && (!backend->supportsNotif())) {
         return NIXL_ERR_BACKEND;
     }
 
-    // Populate has been already done, no benefit in having sorted descriptors
-    // which will be overwritten by [] assignment operator.
-    nixlXferReqH* handle   = new nixlXferReqH;
-    handle->initiatorDescs = new nixl_meta_dlist_t (
-                                     local_descs->getType(),
-                                     false, desc_count);
+    // Populate has been already done, no benefit in having sorted descriptors.
+    // Consecutive descriptors are merged while walking the indices.
+    nixlXferReqH* handle = getXferReqH();
+    handle->initiatorDescs.reset(local_descs->getType());
+    handle->targetDescs.reset(remote_descs->getType());
 
-    handle->targetDescs    = new nixl_meta_dlist_t (
-                                     remote_descs->getType(),
-                                     false, desc_count);
+    nixlMetaDesc local_desc1, remote_desc1;
+    for (size_t i=0; i<desc_count; ++i) {
+        const nixlMetaDesc &local_desc2  = (*local_descs) [local_idx.next()];
+        const nixlMetaDesc &remote_desc2 = (*remote_descs)[remote_idx.next()];
 
-    if (extra_params && extra_params->skipDescMerge) {
-        for (int i=0; i<desc_count; ++i) {
-            (*handle->initiatorDescs)[i] =
-                                     (*local_descs)[local_indices[i]];
-            (*handle->targetDescs)[i] =
-                                     (*remote_descs)[remote_indices[i]];
+        if (local_desc2.len != remote_desc2.len) {
+            putXferReqH(handle);
+            return NIXL_ERR_INVALID_PARAM;
         }
-    } else {
-        int i = 0, j = 0; //final list size
-        while (i<(desc_count)) {
-            nixlMetaDesc local_desc1  = (*local_descs) [local_indices[i]];
-            nixlMetaDesc remote_desc1 = (*remote_descs)[remote_indices[i]];
-
-            if(i != (desc_count-1) ) {
-                nixlMetaDesc* local_desc2  = &((*local_descs) [local_indices[i+1]]);
-                nixlMetaDesc* remote_desc2 = &((*remote_descs)[remote_indices[i+1]]);
-
-              while (((local_desc1.addr + local_desc1.len) == local_desc2->addr)
-                  && ((remote_desc1.addr + remote_desc1.len) == remote_desc2->addr)
-                  && (local_desc1.metadataP == local_desc2->metadataP)
-                  && (remote_desc1.metadataP == remote_desc2->metadataP)
-                  && (local_desc1.devId == local_desc2->devId)
-                  && (remote_desc1.devId == remote_desc2->devId)) {
-
-                    local_desc1.len += local_desc2->len;
-                    remote_desc1.len += remote_desc2->len;
-
-                    i++;
-                    if(i == (desc_count-1)) break;
-
-                    local_desc2  = &((*local_descs) [local_indices[i+1]]);
-                    remote_desc2 = &((*remote_descs)[remote_indices[i+1]]);
-                }
-            }
 
-            (*handle->initiatorDescs)[j] = local_desc1;
-            (*handle->targetDescs)   [j] = remote_desc1;
-            j++;
-            i++;
+        if ((i > 0) && merge
+              && ((local_desc1.addr + local_desc1.len) == local_desc2.addr)
+              && ((remote_desc1.addr + remote_desc1.len) == remote_desc2.addr)
+              && (local_desc1.metadataP == local_desc2.metadataP)
+              && (remote_desc1.metadataP == remote_desc2.metadataP)
+              && (local_desc1.devId == local_desc2.devId)
+              && (remote_desc1.devId == remote_desc2.devId)) {
+            local_desc1.len  += local_desc2.len;
+            remote_desc1.len += remote_desc2.len;
+            continue;
         }
-        NIXL_DEBUG << "reqH descList size down to " << j;
-        handle->initiatorDescs->resize(j);
-        handle->targetDescs->resize(j);
+
+        if (i > 0) {
+            handle->initiatorDescs.addDesc(local_desc1);
+            handle->targetDescs.addDesc(remote_desc1);
+        }
+        local_desc1  = local_desc2;
+        remote_desc1 = remote_desc2;
     }
+    handle->initiatorDescs.addDesc(local_desc1);
+    handle->targetDescs.addDesc(remote_desc1);
+    descsMerged += desc_count - handle->initiatorDescs.descCount();
+
+    handle->engine = backend;
+    // Already merged in order, again only if sorted
+    optimizeDescs(handle, merge && sort, sort);
+    NIXL_DEBUG << "reqH descList size down to " << handle->initiatorDescs.descCount();
 
-    handle->engine      = backend;
     handle->remoteAgent = remote_side->remoteAgent;
     handle->notifMsg    = opt_args.notifMsg;
     handle->hasNotif    = opt_args.hasNotif;
     handle->backendOp   = operation;
     handle->status      = NIXL_ERR_NOT_POSTED;
+    handle->xferBytes   = bytes;
+    handle->prio        = extra_params ? (size_t) extra_params->priority :
+                          (size_t) nixl_xfer_prio_t::NIXL_XFER_PRIO_DEFAULT;
+    if (selector->measures())
+        handle->selector = selector.get();
 
     ret = handle->engine->prepXfer (handle->backendOp,
-                                    *handle->initiatorDescs,
-                                    *handle->targetDescs,
+                                    handle->initiatorDescs,
+                                    handle->targetDescs,
                                     handle->remoteAgent,
                                     handle->backendHandle,
                                     &opt_args);
     if (ret != NIXL_SUCCESS) {
-        delete handle;
+        putXferReqH(handle);
         return ret;
     }
 
+    handle->sectionUse.acquire(remote_side->sectionUse.get());
+    selector->chosen(backend);
     req_hndl = handle;
     return NIXL_SUCCESS;
 }
 
+nixl_status_t
+nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
+                        const nixlDlistH* local_side,
+                        const std::vector<int> &local_indices,
+                        const nixlDlistH* remote_side,
+                        const std::vector<int> &remote_indices,
+                        nixlXferReqH* &req_hndl,
+                        const nixl_opt_args_t* extra_params) const {
+    nixlIdxList local_idx(local_indices);
+    nixlIdxList remote_idx(remote_indices);
+
+    return data->makeXferReq(operation, local_side, local_idx,
+                             remote_side, remote_idx, req_hndl, extra_params);
+}
+
+nixl_status_t
+nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
+                        const nixlDlistH* local_side,
+                        const nixl_idx_ranges_t &local_ranges,
+                        const nixlDlistH* remote_side,
+                        const nixl_idx_ranges_t &remote_ranges,
+                        nixlXferReqH* &req_hndl,
+                        const nixl_opt_args_t* extra_params) const {
+    nixlIdxRangeList local_idx(local_ranges);
+    nixlIdxRangeList remote_idx(remote_ranges);
+
+    return data->makeXferReq(operation, local_side, local_idx,
+                             remote_side, remote_idx, req_hndl, extra_params);
+}
+
 nixl_status_t
 nixlAgent::createXferReq(const nixl_xfer_op_t &operation,
                          const nixl_xfer_dlist_t &local_descs,
@@ -645,15 +1627,25 @@ nixlAgent::createXferReq(const nixl_xfer_op_t &operation,
                          const nixl_opt_args_t* extra_params) const {
     nixl_status_t     ret1, ret2;
     nixl_opt_b_args_t opt_args;
-    backend_set_t*    backend_set = new backend_set_t();
+    nixlRemoteSection* remote_section;
+    std::vector<nixlXferReqH*> stripes;
+    backend_list_t    candidates;
+    size_t            bytes = 0;
+    const bool striping = extra_params && extra_params->striping;
 
     req_hndl = nullptr;
 
-    NIXL_LOCK_GUARD(data->lock);
-    if (data->remoteSections.count(remote_agent) == 0)
-    {
+    if (striping && extra_params->hasNotif)
+        return NIXL_ERR_NOT_SUPPORTED;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    auto remote_it = data->remoteSections.find(remote_agent);
+    if (remote_it == data->remoteSections.end()) {
+        data->refetchRemoteMD(remote_agent);
         return NIXL_ERR_NOT_FOUND;
     }
+    remote_section = remote_it->second;
+    remote_section->touch();
 
     // Check the correspondence between descriptor lists
     if (local_descs.descCount() != remote_descs.descCount())
@@ -662,220 +1654,801 @@ nixlAgent::createXferReq(const nixl_xfer_op_t &operation,
         if (local_descs[i].len != remote_descs[i].len)
             return NIXL_ERR_INVALID_PARAM;
 
-    if (!extra_params || extra_params->backends.size() == 0) {
-        // Finding backends that support the corresponding memories
-        // locally and remotely, and find the common ones.
-        backend_set_t* local_set =
-            data->memorySection->queryBackends(local_descs.getType());
-        backend_set_t* remote_set =
-            data->remoteSections[remote_agent]->queryBackends(
-                                                remote_descs.getType());
-        if (!local_set || !remote_set) {
-            delete backend_set;
-            return NIXL_ERR_NOT_FOUND;
-        }
-
-        for (auto & elm : *local_set)
-            if (remote_set->count(elm) != 0)
-                backend_set->insert(elm);
+    nixlXferReqH *handle = data->getXferReqH();
+    handle->initiatorDescs.reset(local_descs.getType(), local_descs.isSorted());
+    handle->targetDescs.reset(remote_descs.getType(), remote_descs.isSorted());
 
-        if (backend_set->empty()) {
-            delete backend_set;
-            return NIXL_ERR_NOT_FOUND;
-        }
-    } else {
-        for (auto & elm : extra_params->backends)
-            backend_set->insert(elm->engine);
-    }
+    // If populate fails, it clears the resp before return. When striping,
+    // all the matching backends are collected instead of the first one.
+    auto populate_both = [&](nixlBackendEngine* backend) {
+        ret1 = data->memorySection->populate(
+                     local_descs, backend, handle->initiatorDescs);
+        ret2 = remote_section->populate(
+                     remote_descs, backend, handle->targetDescs);
+        if ((ret1 != NIXL_SUCCESS) || (ret2 != NIXL_SUCCESS))
+            return false;
+
+        handle->engine = backend;
+        if (!striping)
+            return true;
+
+        stripes.push_back(handle);
+        handle = data->getXferReqH();
+        handle->initiatorDescs.reset(local_descs.getType(), local_descs.isSorted());
+        handle->targetDescs.reset(remote_descs.getType(), remote_descs.isSorted());
+        return false;
+    };
 
     // TODO: when central KV is supported, add a call to fetchRemoteMD
-    // TODO: merge descriptors back to back in memory (like makeXferReq).
-    // TODO [Perf]: Avoid heap allocation on the datapath, maybe use a mem pool
 
-    nixlXferReqH *handle   = new nixlXferReqH;
-    handle->initiatorDescs = new nixl_meta_dlist_t (
-                                     local_descs.getType(),
-                                     local_descs.isSorted());
+    // A cached plan gives the same backend and descriptors as resolving them again,
+    // unless all the backends are used or the choice depends on measurements.
+    static const std::vector<nixlBackendH*> no_backends;
+    const std::vector<nixlBackendH*> &plan_backends =
+                               extra_params ? extra_params->backends : no_backends;
+    const bool use_plans = data->plans && !striping && !data->selector->measures();
+    size_t     plan_hash = 0;
+    bool       plan_hit  = false;
+
+    if (use_plans) {
+        plan_hash = nixlXferPlanCache::hash(local_descs, remote_descs,
+                                            remote_agent, plan_backends);
+        plan_hit  = data->plans->lookup(plan_hash, local_descs, remote_descs,
+                                        remote_agent, plan_backends, handle->engine,
+                                        handle->initiatorDescs, handle->targetDescs,
+                                        bytes);
+    }
 
-    handle->targetDescs    = new nixl_meta_dlist_t (
-                                     remote_descs.getType(),
-                                     remote_descs.isSorted());
+    // The first candidate that can populate both sides is used, candidates
+    // are ordered by the selection policy unless all of them are used.
+    if (!plan_hit) {
+        if (!extra_params || extra_params->backends.size() == 0) {
+            // Finding backends that support the corresponding memories
+            // locally and remotely, and find the common ones.
+            backend_set_t* local_set =
+                data->memorySection->queryBackends(local_descs.getType());
+            backend_set_t* remote_set =
+                remote_section->queryBackends(remote_descs.getType());
+            if (!local_set || !remote_set) {
+                data->putXferReqH(handle);
+                return NIXL_ERR_NOT_FOUND;
+            }
 
-    // Currently we loop through and find first local match. Can use a
-    // preference list or more exhaustive search.
-    for (auto & backend : *backend_set) {
-        // If populate fails, it clears the resp before return
-        ret1 = data->memorySection->populate(
-                     local_descs, backend, *handle->initiatorDescs);
-        ret2 = data->remoteSections[remote_agent]->populate(
-                     remote_descs, backend, *handle->targetDescs);
-
-        if ((ret1 == NIXL_SUCCESS) && (ret2 == NIXL_SUCCESS)) {
-            // For Logging:
-            // std::cout << "Selected backend: " << backend->getType() << "\n";
-            handle->engine = backend;
-            break;
+            for (auto & backend : data->memToBackend[local_descs.getType()])
+                if ((local_set->count(backend) != 0) && (remote_set->count(backend) != 0))
+                    candidates.push_back(backend);
+        } else {
+            for (auto & elm : extra_params->backends)
+                candidates.push_back(elm->engine);
         }
+
+        for (int i=0; i<local_descs.descCount(); ++i)
+            bytes += local_descs[i].len;
+
+        if (data->selector->measures() && !striping)
+            data->selector->order(candidates, remote_agent, bytes, local_descs.descCount());
+
+        for (auto & backend : candidates)
+            if (populate_both(backend))
+                break;
+
+        if (use_plans && handle->engine)
+            data->plans->insert(plan_hash, local_descs, remote_descs, remote_agent,
+                                plan_backends, handle->engine, handle->initiatorDescs,
+                                handle->targetDescs, bytes);
     }
 
-    delete backend_set;
+    if (striping) {
+        data->putXferReqH(handle);
+        if (stripes.size() > 1) {
+            ret1 = data->createStripes(stripes, operation, remote_agent,
+                                       extra_params, req_hndl);
+            if (ret1 != NIXL_SUCCESS)
+                return ret1;
+            if (req_hndl) {
+                req_hndl->sectionUse.acquire(remote_section->usage);
+                return NIXL_SUCCESS;
+            }
+        }
+        if (stripes.empty())
+            return NIXL_ERR_NOT_FOUND;
+        handle = stripes[0];
+    }
 
     if (!handle->engine) {
-        delete handle;
+        data->putXferReqH(handle);
         return NIXL_ERR_NOT_FOUND;
     }
 
+    const auto engine_lock = data->lockEngine(handle->engine);
+
     if (extra_params && extra_params->hasNotif) {
         opt_args.notifMsg = extra_params->notifMsg;
         opt_args.hasNotif = true;
     }
+    if (extra_params)
+        opt_args.completion = extra_params->completion;
 
     if (opt_args.hasNotif && (!handle->engine->supportsNotif())) {
-        delete handle;
+        data->putXferReqH(handle);
+        return NIXL_ERR_BACKEND;
+    }
+
+    data->optimizeDescs(handle, extra_params && extra_params->mergeDescs
+                                    && !extra_params->skipDescMerge,
+                        extra_params && extra_params->sortDescs);
+
+    handle->remoteAgent = remote_agent;
+    handle->backendOp   = operation;
+    handle->status      = NIXL_ERR_NOT_POSTED;
+    handle->notifMsg    = opt_args.notifMsg;
+    handle->hasNotif    = opt_args.hasNotif;
+    handle->xferBytes   = bytes;
+    handle->prio        = extra_params ? (size_t) extra_params->priority :
+                          (size_t) nixl_xfer_prio_t::NIXL_XFER_PRIO_DEFAULT;
+    if (data->selector->measures() && !striping)
+        handle->selector = data->selector.get();
+
+    ret1 = handle->engine->prepXfer (handle->backendOp,
+                                     handle->initiatorDescs,
+                                     handle->targetDescs,
+                                     handle->remoteAgent,
+                                     handle->backendHandle,
+                                     &opt_args);
+    if (ret1 != NIXL_SUCCESS) {
+        data->putXferReqH(handle);
+        return ret1;
+    }
+
+    handle->sectionUse.acquire(remote_section->usage);
+    data->selector->chosen(handle->engine);
+    req_hndl = handle;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::postXferReq(nixlXferReqH *req_hndl,
+                       const nixl_opt_args_t* extra_params) const {
+    nixl_status_t ret;
+    nixl_opt_b_args_t opt_args;
+
+    opt_args.hasNotif = false;
+
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    // Requests can't be reposted before their completion is reported
+    if (req_hndl->tracked())
+        return NIXL_ERR_REPOST_ACTIVE;
+
+    if (req_hndl->striped()) {
+        if (extra_params && (extra_params->hasNotif || extra_params->xferCQ ||
+                             extra_params->completionCb))
+            return NIXL_ERR_NOT_SUPPORTED;
+
+        NIXL_SHARED_LOCK_GUARD(data->lock);
+        if (!data->remoteValid(req_hndl->remoteAgent, req_hndl->sectionUse)) {
+            data->putXferReqH(req_hndl);
+            return NIXL_ERR_NOT_FOUND;
+        }
+        req_hndl->sectionUse.touch();
+        return data->postStripes(req_hndl);
+    }
+
+    // Released explicitly before calling the completion callback
+    std::shared_lock<nixlLock> agent_lock(data->lock);
+    data->issueHeld();
+
+    // A held post is not issued yet
+    if (req_hndl->held)
+        return NIXL_ERR_REPOST_ACTIVE;
+
+    auto engine_lock = data->lockEngine(req_hndl->engine);
+    // Check if the remote was invalidated before post/repost
+    if (!data->remoteValid(req_hndl->remoteAgent, req_hndl->sectionUse)) {
+        data->putXferReqH(req_hndl);
+        return NIXL_ERR_NOT_FOUND;
+    }
+    req_hndl->sectionUse.touch();
+
+    // We can't repost while a request is in progress
+    if (req_hndl->status == NIXL_IN_PROG) {
+        req_hndl->status = req_hndl->engine->checkXfer(
+                                     req_hndl->backendHandle);
+        req_hndl->checked();
+        if (req_hndl->status == NIXL_IN_PROG) {
+            data->putXferReqH(req_hndl);
+            return NIXL_ERR_REPOST_ACTIVE;
+        }
+    }
+
+    // Carrying over notification from xfer handle creation time
+    if (req_hndl->hasNotif) {
+        opt_args.notifMsg = req_hndl->notifMsg;
+        opt_args.hasNotif = true;
+    }
+
+    // Updating the notification based on opt_args
+    if (extra_params) {
+        if (extra_params->hasNotif) {
+            req_hndl->notifMsg = extra_params->notifMsg;
+            opt_args.notifMsg  = extra_params->notifMsg;
+            req_hndl->hasNotif = true;
+            opt_args.hasNotif  = true;
+        } else {
+            req_hndl->hasNotif = false;
+            opt_args.hasNotif  = false;
+        }
+    }
+
+    if (opt_args.hasNotif && (!req_hndl->engine->supportsNotif())) {
+        data->putXferReqH(req_hndl);
         return NIXL_ERR_BACKEND;
     }
 
-    handle->remoteAgent = remote_agent;
-    handle->backendOp   = operation;
-    handle->status      = NIXL_ERR_NOT_POSTED;
-    handle->notifMsg    = opt_args.notifMsg;
-    handle->hasNotif    = opt_args.hasNotif;
+    ret = data->trackXfer(req_hndl, extra_params, opt_args);
+    if (ret != NIXL_SUCCESS)
+        return ret;
+
+    // A held post is issued by the agent later, it can do so as soon as it's queued
+    if (data->sched) {
+        req_hndl->status = NIXL_IN_PROG;
+        if (!data->sched->admit(req_hndl))
+            return NIXL_IN_PROG;
+    }
+
+    // If status is not NIXL_IN_PROG we can repost,
+    ret = data->issueXfer(req_hndl, opt_args);
+    data->trackedPost(req_hndl, ret, opt_args);
+
+    if ((ret == NIXL_SUCCESS) && req_hndl->userCb) {
+        engine_lock.unlock();
+        agent_lock.unlock();
+        nixlXferReqH::callUserCbs(&req_hndl, 1);
+    }
+    return ret;
+}
+
+nixl_status_t
+nixlAgent::getXferStatus (nixlXferReqH *req_hndl) {
+
+    // Requests with a queue or callback are checked when it's progressed
+    if (req_hndl->tracked())
+        return req_hndl->status;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    data->issueHeld();
+    if (req_hndl->held)
+        return NIXL_IN_PROG;
+
+    // If the status is done, no need to recheck.
+    if (req_hndl->status != NIXL_SUCCESS) {
+        // Check if the remote was invalidated before completion
+        if (!data->remoteValid(req_hndl->remoteAgent, req_hndl->sectionUse)) {
+            data->putXferReqH(req_hndl);
+            return NIXL_ERR_NOT_FOUND;
+        }
+        if (req_hndl->striped())
+            return data->checkStripes(req_hndl);
+
+        const auto engine_lock = data->lockEngine(req_hndl->engine);
+        req_hndl->status = req_hndl->engine->checkXfer(
+                                     req_hndl->backendHandle);
+        req_hndl->checked();
+    }
+
+    return req_hndl->status;
+}
+
+
+nixl_status_t
+nixlAgent::queryXferBackend(const nixlXferReqH* req_hndl,
+                            nixlBackendH* &backend) const {
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    // For striped transfers, the backend carrying the first part is given
+    nixlBackendEngine* engine = req_hndl->striped() ?
+                                req_hndl->stripes[0]->engine : req_hndl->engine;
+    backend = data->backendHandles.at(engine->getType());
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::releaseXferReq(nixlXferReqH *req_hndl) {
+
+    // The completion is not reported yet
+    if (req_hndl->tracked())
+        return NIXL_ERR_NOT_ALLOWED;
+
+    nixl_status_t ret;
+    {
+        NIXL_SHARED_LOCK_GUARD(data->lock);
+        ret = data->releaseReq(req_hndl);
+    }
+
+    // The last request using metadata that was dropped or removed frees it
+    if (data->reapPending) {
+        NIXL_LOCK_GUARD(data->lock);
+        data->reapRetired();
+    }
+    return ret;
+}
+
+namespace {
+
+// Requests of a batch that are handled by the same engine
+class nixlEngineBatch {
+    public:
+        nixlBackendEngine*  engine;
+        std::vector<size_t> reqIdx;
+};
+
+void addToBatch(std::vector<nixlEngineBatch> &batches,
+                nixlBackendEngine* engine, const size_t idx) {
+    // Only a handful of engines per agent, linear search is fine
+    for (auto &batch : batches) {
+        if (batch.engine == engine) {
+            batch.reqIdx.push_back(idx);
+            return;
+        }
+    }
+    batches.push_back({engine, {idx}});
+}
+
+nixl_status_t batchStatus(const std::vector<nixl_status_t> &status) {
+    nixl_status_t ret = NIXL_SUCCESS;
+    for (auto &elm : status) {
+        if (elm < 0)
+            return elm;
+        if (elm == NIXL_IN_PROG)
+            ret = NIXL_IN_PROG;
+    }
+    return ret;
+}
+
+} // anonymous namespace
+
+nixl_status_t
+nixlAgent::postXferReqBatch(const std::vector<nixlXferReqH*> &req_hndls,
+                            std::vector<nixl_status_t> &status,
+                            const nixl_opt_args_t* extra_params) const {
+    std::vector<nixlEngineBatch>   batches;
+    std::vector<nixl_opt_b_args_t> opt_args(req_hndls.size());
+    nixl_xfer_batch_t              xfer_batch;
+    const std::string*             checked_remote = nullptr;
+
+    if (extra_params && extra_params->xferCQ && extra_params->completionCb) {
+        status.assign(req_hndls.size(), NIXL_ERR_INVALID_PARAM);
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    status.assign(req_hndls.size(), NIXL_ERR_NOT_POSTED);
+
+    // Released explicitly before calling the completion callbacks
+    std::shared_lock<nixlLock> agent_lock(data->lock);
+    data->issueHeld();
+    for (size_t i = 0; i < req_hndls.size(); ++i) {
+        nixlXferReqH* req_hndl = req_hndls[i];
+        if (!req_hndl) {
+            status[i] = NIXL_ERR_INVALID_PARAM;
+            continue;
+        }
+
+        // Requests can't be reposted before their completion is reported
+        if (req_hndl->tracked() || req_hndl->held) {
+            status[i] = NIXL_ERR_REPOST_ACTIVE;
+            continue;
+        }
+
+        // Check if the remote was invalidated before post/repost, consecutive
+        // requests usually go to the same remote so it is checked once for them
+        if (!checked_remote || (*checked_remote != req_hndl->remoteAgent)) {
+            if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
+                status[i] = NIXL_ERR_NOT_FOUND;
+                continue;
+            }
+            checked_remote = &req_hndl->remoteAgent;
+            req_hndl->sectionUse.touch();
+        }
+        if (req_hndl->sectionUse.stale()) {
+            status[i] = NIXL_ERR_NOT_FOUND;
+            continue;
+        }
+
+        // Striped requests post each of their stripes to its own engine
+        if (req_hndl->striped()) {
+            if (extra_params && (extra_params->hasNotif || extra_params->xferCQ ||
+                                 extra_params->completionCb))
+                status[i] = NIXL_ERR_NOT_SUPPORTED;
+            else
+                status[i] = data->postStripes(req_hndl);
+            continue;
+        }
+
+        addToBatch(batches, req_hndl->engine, i);
+    }
+
+    for (auto &batch : batches) {
+        const auto engine_lock = data->lockEngine(batch.engine);
+
+        xfer_batch.clear();
+        for (auto &i : batch.reqIdx) {
+            nixlXferReqH* req_hndl = req_hndls[i];
+
+            // We can't repost while a request is in progress
+            if (req_hndl->status == NIXL_IN_PROG) {
+                req_hndl->status = req_hndl->engine->checkXfer(
+                                             req_hndl->backendHandle);
+                req_hndl->checked();
+                if (req_hndl->status == NIXL_IN_PROG) {
+                    status[i] = NIXL_ERR_REPOST_ACTIVE;
+                    continue;
+                }
+            }
+
+            // Updating the notification based on opt_args, as in postXferReq
+            if (extra_params) {
+                req_hndl->hasNotif = extra_params->hasNotif;
+                if (extra_params->hasNotif)
+                    req_hndl->notifMsg = extra_params->notifMsg;
+            }
+
+            if (req_hndl->hasNotif) {
+                if (!batch.engine->supportsNotif()) {
+                    status[i] = NIXL_ERR_BACKEND;
+                    continue;
+                }
+                opt_args[i].notifMsg = req_hndl->notifMsg;
+                opt_args[i].hasNotif = true;
+            }
+
+            // Can't fail, as the queue and the callback were not given together
+            data->trackXfer(req_hndl, extra_params, opt_args[i]);
+            req_hndl->status = NIXL_IN_PROG;
+
+            // Held posts are issued by the agent later
+            if (data->sched && !data->sched->admit(req_hndl)) {
+                status[i] = NIXL_IN_PROG;
+                continue;
+            }
+            if (req_hndl->selector)
+                req_hndl->postTime = nixlTime::getNs();
+
+            nixlBackendXferArgs args;
+            args.operation   = req_hndl->backendOp;
+            args.local       = &req_hndl->initiatorDescs;
+            args.remote      = &req_hndl->targetDescs;
+            args.remoteAgent = &req_hndl->remoteAgent;
+            args.handle      = req_hndl->backendHandle;
+            args.optArgs     = &opt_args[i];
+            xfer_batch.push_back(args);
+        }
+
+        if (xfer_batch.empty())
+            continue;
+
+        nixl_status_t ret = batch.engine->postXferBatch(xfer_batch);
+
+        // Requests of the batch are the ones that are still marked as not posted.
+        // Backends reporting the completion keep the handle given to them.
+        size_t j = 0;
+        for (auto &i : batch.reqIdx) {
+            if (status[i] != NIXL_ERR_NOT_POSTED)
+                continue;
+            nixlXferReqH* req_hndl = req_hndls[i];
+            status[i] = (ret < 0) ? ret : xfer_batch[j].status;
+            if ((status[i] != NIXL_IN_PROG) || !opt_args[i].xferCb) {
+                req_hndl->backendHandle = xfer_batch[j].handle;
+                if (status[i] != NIXL_IN_PROG) {
+                    req_hndl->status = status[i];
+                    req_hndl->postDone(true);
+                }
+            }
+            data->trackedPost(req_hndl, status[i], opt_args[i]);
+            j++;
+        }
+    }
+
+    agent_lock.unlock();
+    std::vector<nixlXferReqH*> done;
+    for (size_t i = 0; i < req_hndls.size(); ++i)
+        if ((status[i] == NIXL_SUCCESS) && req_hndls[i]->userCb)
+            done.push_back(req_hndls[i]);
+    if (!done.empty())
+        nixlXferReqH::callUserCbs(done.data(), done.size());
+
+    return batchStatus(status);
+}
+
+nixl_status_t
+nixlAgent::getXferStatusBatch(const std::vector<nixlXferReqH*> &req_hndls,
+                              std::vector<nixl_status_t> &status) {
+    std::vector<nixlEngineBatch> batches;
+    nixl_xfer_batch_t            xfer_batch;
+    const std::string*           checked_remote = nullptr;
+
+    status.assign(req_hndls.size(), NIXL_SUCCESS);
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    data->issueHeld();
+    for (size_t i = 0; i < req_hndls.size(); ++i) {
+        nixlXferReqH* req_hndl = req_hndls[i];
+        if (!req_hndl) {
+            status[i] = NIXL_ERR_INVALID_PARAM;
+            continue;
+        }
+
+        // If the status is done, or the request is in a queue, no need to recheck.
+        if ((req_hndl->status == NIXL_SUCCESS) || req_hndl->tracked()) {
+            status[i] = req_hndl->status;
+            continue;
+        }
+
+        if (req_hndl->held) {
+            status[i] = NIXL_IN_PROG;
+            continue;
+        }
+
+        // Check if the remote was invalidated before completion
+        if (!checked_remote || (*checked_remote != req_hndl->remoteAgent)) {
+            if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
+                status[i] = NIXL_ERR_NOT_FOUND;
+                continue;
+            }
+            checked_remote = &req_hndl->remoteAgent;
+        }
+        if (req_hndl->sectionUse.stale()) {
+            status[i] = NIXL_ERR_NOT_FOUND;
+            continue;
+        }
+
+        if (req_hndl->striped()) {
+            status[i] = data->checkStripes(req_hndl);
+            continue;
+        }
+
+        addToBatch(batches, req_hndl->engine, i);
+    }
+
+    for (auto &batch : batches) {
+        const auto engine_lock = data->lockEngine(batch.engine);
 
-    ret1 = handle->engine->prepXfer (handle->backendOp,
-                                     *handle->initiatorDescs,
-                                     *handle->targetDescs,
-                                     handle->remoteAgent,
-                                     handle->backendHandle,
-                                     &opt_args);
-    if (ret1 != NIXL_SUCCESS) {
-        delete handle;
-        return ret1;
+        xfer_batch.resize(batch.reqIdx.size());
+        for (size_t j = 0; j < batch.reqIdx.size(); ++j)
+            xfer_batch[j].handle = req_hndls[batch.reqIdx[j]]->backendHandle;
+
+        nixl_status_t ret = batch.engine->checkXferBatch(xfer_batch);
+
+        for (size_t j = 0; j < batch.reqIdx.size(); ++j) {
+            nixlXferReqH* req_hndl = req_hndls[batch.reqIdx[j]];
+            req_hndl->status       = (ret < 0) ? ret : xfer_batch[j].status;
+            status[batch.reqIdx[j]] = req_hndl->status;
+            req_hndl->checked();
+        }
     }
 
-    req_hndl = handle;
-    return NIXL_SUCCESS;
+    return batchStatus(status);
 }
 
 nixl_status_t
-nixlAgent::postXferReq(nixlXferReqH *req_hndl,
-                       const nixl_opt_args_t* extra_params) const {
-    nixl_status_t ret;
-    nixl_opt_b_args_t opt_args;
+nixlAgent::releaseXferReqBatch(const std::vector<nixlXferReqH*> &req_hndls) {
+    nixl_status_t                ret = NIXL_SUCCESS;
+    nixlBackendEngine*           locked_engine = nullptr;
+    std::unique_lock<std::mutex> engine_lock;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    for (auto &req_hndl : req_hndls) {
+        if (!req_hndl) {
+            ret = NIXL_ERR_INVALID_PARAM;
+            continue;
+        }
 
-    opt_args.hasNotif = false;
+        if (req_hndl->tracked()) {
+            ret = NIXL_ERR_NOT_ALLOWED;
+            continue;
+        }
 
-    if (!req_hndl)
-        return NIXL_ERR_INVALID_PARAM;
+        if (req_hndl->held) {
+            if (!data->sched->cancel(req_hndl)) {
+                ret = NIXL_ERR_REPOST_ACTIVE;
+                continue;
+            }
+            req_hndl->status = NIXL_ERR_NOT_POSTED;
+        }
 
-    NIXL_LOCK_GUARD(data->lock);
-    // Check if the remote was invalidated before post/repost
-    if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
-        delete req_hndl;
-        return NIXL_ERR_NOT_FOUND;
-    }
+        // Engine locks are never nested, release the previous one first
+        if (req_hndl->striped()) {
+            if (engine_lock.owns_lock())
+                engine_lock.unlock();
+            locked_engine = nullptr;
+            if (data->releaseStripes(req_hndl) != NIXL_SUCCESS)
+                ret = NIXL_ERR_REPOST_ACTIVE;
+            continue;
+        }
 
-    // We can't repost while a request is in progress
-    if (req_hndl->status == NIXL_IN_PROG) {
-        req_hndl->status = req_hndl->engine->checkXfer(
-                                     req_hndl->backendHandle);
-        if (req_hndl->status == NIXL_IN_PROG) {
-            delete req_hndl;
-            return NIXL_ERR_REPOST_ACTIVE;
+        if (req_hndl->engine != locked_engine) {
+            if (engine_lock.owns_lock())
+                engine_lock.unlock();
+            engine_lock   = data->lockEngine(req_hndl->engine);
+            locked_engine = req_hndl->engine;
         }
-    }
 
-    // Carrying over notification from xfer handle creation time
-    if (req_hndl->hasNotif) {
-        opt_args.notifMsg = req_hndl->notifMsg;
-        opt_args.hasNotif = true;
-    }
+        //attempt to cancel request
+        if (req_hndl->status == NIXL_IN_PROG) {
+            req_hndl->status = req_hndl->engine->checkXfer(
+                                         req_hndl->backendHandle);
 
-    // Updating the notification based on opt_args
-    if (extra_params) {
-        if (extra_params->hasNotif) {
-            req_hndl->notifMsg = extra_params->notifMsg;
-            opt_args.notifMsg  = extra_params->notifMsg;
-            req_hndl->hasNotif = true;
-            opt_args.hasNotif  = true;
-        } else {
-            req_hndl->hasNotif = false;
-            opt_args.hasNotif  = false;
-        }
-    }
+            if (req_hndl->status == NIXL_IN_PROG) {
+                req_hndl->status = req_hndl->engine->releaseReqH(
+                                             req_hndl->backendHandle);
 
-    if (opt_args.hasNotif && (!req_hndl->engine->supportsNotif())) {
-        delete req_hndl;
-        return NIXL_ERR_BACKEND;
+                if (req_hndl->status < 0) {
+                    ret = NIXL_ERR_REPOST_ACTIVE;
+                    continue;
+                }
+
+                req_hndl->backendHandle = nullptr;
+            }
+        }
+        data->putXferReqH(req_hndl);
     }
 
-    // If status is not NIXL_IN_PROG we can repost,
-    ret = req_hndl->engine->postXfer (req_hndl->backendOp,
-                                     *req_hndl->initiatorDescs,
-                                     *req_hndl->targetDescs,
-                                      req_hndl->remoteAgent,
-                                      req_hndl->backendHandle,
-                                      &opt_args);
-    req_hndl->status = ret;
     return ret;
 }
 
 nixl_status_t
-nixlAgent::getXferStatus (nixlXferReqH *req_hndl) {
+nixlAgent::progressXfers() {
+    std::vector<nixlXferReqH*> checking;
+    std::vector<nixlXferReqH*> done;
+    bool                       in_prog;
 
-    NIXL_LOCK_GUARD(data->lock);
-    // If the status is done, no need to recheck.
-    if (req_hndl->status != NIXL_SUCCESS) {
-        // Check if the remote was invalidated before completion
-        if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
-            delete req_hndl;
-            return NIXL_ERR_NOT_FOUND;
+    // Callbacks are called after releasing the locks, so they can call the agent
+    {
+        NIXL_SHARED_LOCK_GUARD(data->lock);
+        data->issueHeld();
+        {
+            const std::lock_guard<std::mutex> guard(data->cbPendingLock);
+            checking.swap(data->cbPending);
+            done.swap(data->cbDone);
         }
-        req_hndl->status = req_hndl->engine->checkXfer(
-                                     req_hndl->backendHandle);
+
+        for (auto &req_hndl : checking) {
+            // Check if the remote was invalidated before completion
+            if (!data->remoteValid(req_hndl->remoteAgent, req_hndl->sectionUse)) {
+                req_hndl->status = NIXL_ERR_NOT_FOUND;
+            } else {
+                const auto engine_lock = data->lockEngine(req_hndl->engine);
+                req_hndl->status = req_hndl->engine->checkXfer(
+                                             req_hndl->backendHandle);
+                req_hndl->checked();
+            }
+            if (req_hndl->status != NIXL_IN_PROG)
+                done.push_back(req_hndl);
+        }
+
+        const std::lock_guard<std::mutex> guard(data->cbPendingLock);
+        for (auto &req_hndl : checking)
+            if (req_hndl->status == NIXL_IN_PROG)
+                data->cbPending.push_back(req_hndl);
+        in_prog = !data->cbPending.empty() ||
+                  (data->sched && data->sched->hasQueued());
     }
 
-    return req_hndl->status;
+    nixlXferReqH::callUserCbs(done.data(), done.size());
+
+    return in_prog ? NIXL_IN_PROG : NIXL_SUCCESS;
 }
 
+nixl_status_t
+nixlAgent::createXferCQ(nixlXferCQ* &cq) const {
+    cq = new nixlXferCQ();
+    if (cq->eventFd < 0) {
+        NIXL_ERROR << "Failed to create eventfd for completion queue";
+        delete cq;
+        cq = nullptr;
+        return NIXL_ERR_UNKNOWN;
+    }
+    return NIXL_SUCCESS;
+}
 
 nixl_status_t
-nixlAgent::queryXferBackend(const nixlXferReqH* req_hndl,
-                            nixlBackendH* &backend) const {
-    NIXL_LOCK_GUARD(data->lock);
-    backend = data->backendHandles[req_hndl->engine->getType()];
+nixlAgent::releaseXferCQ(nixlXferCQ* cq) {
+    if (!cq)
+        return NIXL_ERR_INVALID_PARAM;
+
+    {
+        const std::lock_guard<std::mutex> guard(cq->lock);
+        if (cq->reqCount != 0)
+            return NIXL_ERR_NOT_ALLOWED;
+    }
+
+    delete cq;
     return NIXL_SUCCESS;
 }
 
 nixl_status_t
-nixlAgent::releaseXferReq(nixlXferReqH *req_hndl) {
+nixlAgent::getXferCQFd(const nixlXferCQ* cq, int &fd) const {
+    if (!cq)
+        return NIXL_ERR_INVALID_PARAM;
 
-    NIXL_LOCK_GUARD(data->lock);
-    //attempt to cancel request
-    if(req_hndl->status == NIXL_IN_PROG) {
-        req_hndl->status = req_hndl->engine->checkXfer(
-                                     req_hndl->backendHandle);
+    fd = cq->eventFd;
+    return NIXL_SUCCESS;
+}
 
-        if(req_hndl->status == NIXL_IN_PROG) {
+nixl_status_t
+nixlAgent::pollXferCQ(nixlXferCQ* cq,
+                      std::vector<nixlXferReqH*> &req_hndls,
+                      const size_t max_reqs) {
+    std::vector<nixlXferReqH*> checking;
 
-            req_hndl->status = req_hndl->engine->releaseReqH(
-                                         req_hndl->backendHandle);
+    if (!cq)
+        return NIXL_ERR_INVALID_PARAM;
 
-            if(req_hndl->status < 0)
-                return NIXL_ERR_REPOST_ACTIVE;
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    data->issueHeld();
 
-            // just in case the backend doesn't set to NULL on success
-            // this will prevent calling releaseReqH again in destructor
-            req_hndl->backendHandle = nullptr;
+    // Pending requests are checked without the queue lock, since posts add to
+    // the queue while holding their engine lock. Requests in the queue are not
+    // touched by other calls, so they're only accessed by this poll meanwhile.
+    {
+        const std::lock_guard<std::mutex> guard(cq->lock);
+        checking.swap(cq->pending);
+    }
+
+    for (auto &req_hndl : checking) {
+        // Check if the remote was invalidated before completion
+        if (!data->remoteValid(req_hndl->remoteAgent, req_hndl->sectionUse)) {
+            req_hndl->status = NIXL_ERR_NOT_FOUND;
+            continue;
         }
+
+        const auto engine_lock = data->lockEngine(req_hndl->engine);
+        req_hndl->status = req_hndl->engine->checkXfer(req_hndl->backendHandle);
+        req_hndl->checked();
     }
-    delete req_hndl;
-    return NIXL_SUCCESS;
+
+    const std::lock_guard<std::mutex> guard(cq->lock);
+
+    for (auto &req_hndl : checking) {
+        if (req_hndl->status == NIXL_IN_PROG)
+            cq->pending.push_back(req_hndl);
+        else
+            cq->completed.push_back(req_hndl);
+    }
+
+    const std::lock_guard<std::mutex> cb_guard(cq->cbLock);
+    cq->completed.insert(cq->completed.end(),
+                         cq->cbCompleted.begin(), cq->cbCompleted.end());
+    cq->cbCompleted.clear();
+
+    size_t count = cq->completed.size();
+    if ((max_reqs != 0) && (max_reqs < count))
+        count = max_reqs;
+
+    for (size_t i = 0; i < count; ++i) {
+        cq->completed[i]->cq = nullptr;
+        req_hndls.push_back(cq->completed[i]);
+    }
+    cq->completed.erase(cq->completed.begin(), cq->completed.begin() + count);
+    cq->reqCount -= count;
+
+    cq->resetSignal();
+
+    return (count > 0) ? NIXL_SUCCESS : NIXL_IN_PROG;
 }
 
 nixl_status_t
 nixlAgent::releasedDlistH (nixlDlistH* dlist_hndl) const {
-    NIXL_LOCK_GUARD(data->lock);
-    delete dlist_hndl;
+    {
+        NIXL_SHARED_LOCK_GUARD(data->lock);
+        if (dlist_hndl->sectionUse.release())
+            data->reapPending = true;
+        delete dlist_hndl;
+    }
+
+    if (data->reapPending) {
+        NIXL_LOCK_GUARD(data->lock);
+        data->reapRetired();
+    }
     return NIXL_SUCCESS;
 }
 
@@ -886,7 +2459,7 @@ nixlAgent::getNotifs(nixl_notifs_t &notif_map,
     nixl_status_t   ret, bad_ret=NIXL_SUCCESS;
     backend_list_t* backend_list;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
     if (!extra_params || extra_params->backends.size() == 0) {
         backend_list = &data->notifEngines;
         if (backend_list->empty())
@@ -908,7 +2481,10 @@ nixlAgent::getNotifs(nixl_notifs_t &notif_map,
     // the backend to the msg, but user could put it themselves.
     for (auto & eng: *backend_list) {
         bknd_notif_list.clear();
-        ret = eng->getNotifs(bknd_notif_list);
+        {
+            const auto engine_lock = data->lockEngine(eng);
+            ret = eng->getNotifs(bknd_notif_list);
+        }
         if (ret < 0)
             bad_ret=ret;
 
@@ -937,7 +2513,7 @@ nixlAgent::genNotif(const std::string &remote_agent,
     nixlBackendEngine* backend = nullptr;
     backend_list_t*    backend_list;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
     if (!extra_params || extra_params->backends.size() == 0) {
         backend_list = &data->notifEngines;
         if (backend_list->empty())
@@ -954,9 +2530,11 @@ nixlAgent::genNotif(const std::string &remote_agent,
         }
     }
 
+    auto remote_it = data->remoteBackends.find(remote_agent);
     for (auto & eng: *backend_list) {
-        if (data->remoteBackends[remote_agent].count(
-                                 eng->getType()) != 0) {
+        if (remote_it == data->remoteBackends.end())
+            break;
+        if (remote_it->second.count(eng->getType()) != 0) {
             backend = eng;
             break;
         }
@@ -965,35 +2543,44 @@ nixlAgent::genNotif(const std::string &remote_agent,
     if (extra_params && extra_params->backends.size() > 0)
         delete backend_list;
 
-    if (backend)
-        return backend->genNotif(remote_agent, msg);
-    else
+    if (!backend)
         return NIXL_ERR_NOT_FOUND;
+
+    const auto engine_lock = data->lockEngine(backend);
+    return backend->genNotif(remote_agent, msg);
 }
 
 nixl_status_t
-nixlAgent::getLocalMD (nixl_blob_t &str) const {
+nixlAgentData::getLocalMD (nixl_blob_t &str, const bool reset) const {
     size_t conn_cnt;
     nixl_backend_t nixl_backend;
     nixl_status_t ret;
 
-    NIXL_LOCK_GUARD(data->lock);
-    // data->connMD was populated when the backend was created
-    conn_cnt = data->connMD.size();
+    // connMD was populated when the backend was created
+    conn_cnt = connMD.size();
 
     if (conn_cnt == 0) // Error, no backend supports remote
         return NIXL_ERR_INVALID_PARAM;
 
-    nixlSerDes sd;
-    ret = sd.addStr("Agent", data->name);
+    uint64_t md_gen = memorySection->getGen();
+
+    nixlSerDes sd(mdFormat());
+    ret = sd.addStr("Agent", name);
     if(ret)
         return ret;
 
+    // Leading like the generation of deltas, which older loaders reject as well
+    if (reset) {
+        ret = sd.addBuf("MDReset", &md_gen, sizeof(md_gen));
+        if(ret)
+            return ret;
+    }
+
     ret = sd.addBuf("Conns", &conn_cnt, sizeof(conn_cnt));
     if(ret)
         return ret;
 
-    for (auto &c : data->connMD) {
+    for (auto &c : connMD) {
         nixl_backend = c.first;
         ret = sd.addStr("t", nixl_backend);
         if(ret)
@@ -1007,7 +2594,63 @@ nixlAgent::getLocalMD (nixl_blob_t &str) const {
     if(ret)
         return ret;
 
-    ret = data->memorySection->serialize(&sd);
+    ret = memorySection->serialize(&sd);
+    if(ret)
+        return ret;
+
+    // Trailing, so loaders that don't know about generations can ignore it
+    ret = sd.addBuf("MDGen", &md_gen, sizeof(md_gen));
+    if(ret)
+        return ret;
+
+    str = sd.exportStr();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getLocalMD (nixl_blob_t &str) const {
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    return data->getLocalMD(str);
+}
+
+nixl_status_t
+nixlAgent::getLocalMDDelta (const uint64_t since_gen, nixl_blob_t &str) const {
+    nixl_status_t ret;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    if (data->connMD.size() == 0) // Error, no backend supports remote
+        return NIXL_ERR_INVALID_PARAM;
+
+    uint64_t md_gen = data->memorySection->getGen();
+
+    // Deltas carry the generation they apply to first, so loaders that don't
+    // know about them reject them instead of reading a partial update.
+    nixlSerDes sd(data->mdFormat());
+    ret = sd.addStr("Agent", data->name);
+    if(ret)
+        return ret;
+
+    ret = sd.addBuf("MDBase", &since_gen, sizeof(since_gen));
+    if(ret)
+        return ret;
+
+    ret = sd.addBuf("MDGen", &md_gen, sizeof(md_gen));
+    if(ret)
+        return ret;
+
+    // Conn info only changes with a new backend, which resets the delta log
+    size_t conn_cnt = 0;
+    ret = sd.addBuf("Conns", &conn_cnt, sizeof(conn_cnt));
+    if(ret)
+        return ret;
+
+    ret = sd.addStr("", "MemDelta");
+    if(ret)
+        return ret;
+
+    ret = data->memorySection->serializeDelta(&sd, since_gen);
+    if (ret == NIXL_ERR_NOT_FOUND) // Too old, replace all the loaded metadata
+        return data->getLocalMD(str, true);
     if(ret)
         return ret;
 
@@ -1015,6 +2658,17 @@ nixlAgent::getLocalMD (nixl_blob_t &str) const {
     return NIXL_SUCCESS;
 }
 
+nixl_status_t
+nixlAgent::getRemoteMDGen (const std::string &remote_agent, uint64_t &gen) const {
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    auto it = data->remoteSections.find(remote_agent);
+    if ((remote_agent == data->name) || (it == data->remoteSections.end()))
+        return NIXL_ERR_NOT_FOUND;
+
+    gen = it->second->mdGen;
+    return NIXL_SUCCESS;
+}
+
 nixl_status_t
 nixlAgent::getLocalPartialMD(const nixl_reg_dlist_t &descs,
                              nixl_blob_t &str,
@@ -1023,7 +2677,7 @@ nixlAgent::getLocalPartialMD(const nixl_reg_dlist_t &descs,
     backend_list_t *backend_list;
     nixl_status_t ret;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
 
     if (!extra_params || extra_params->backends.size() == 0) {
         if (descs.descCount() != 0) {
@@ -1055,7 +2709,7 @@ nixlAgent::getLocalPartialMD(const nixl_reg_dlist_t &descs,
         selected_engines.insert(backend);
     }
 
-    nixlSerDes sd;
+    nixlSerDes sd(data->mdFormat());
     ret = sd.addStr("Agent", data->name);
     if(ret)
         return ret;
@@ -1092,6 +2746,16 @@ nixlAgent::getLocalPartialMD(const nixl_reg_dlist_t &descs,
     return NIXL_SUCCESS;
 }
 
+// Two independent 64-bit hashes, so a changed blob is not taken for the last one
+static std::pair<uint64_t, uint64_t> hashMD(const nixl_blob_t &blob) {
+    uint64_t fnv = 0xcbf29ce484222325ULL;
+    for (const unsigned char c : blob) {
+        fnv ^= c;
+        fnv *= 0x100000001b3ULL;
+    }
+    return {std::hash<nixl_blob_t>{}(blob), fnv};
+}
+
 nixl_status_t
 nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
                          std::string &agent_name) {
@@ -1104,6 +2768,9 @@ nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
     nixl_status_t ret;
 
     NIXL_LOCK_GUARD(data->lock);
+    if (data->reapPending)
+        data->reapRetired();
+
     ret = sd.importStr(remote_metadata);
     if(ret)
         return ret;
@@ -1115,6 +2782,38 @@ nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
     if (remote_agent == data->name)
         return NIXL_ERR_INVALID_PARAM;
 
+    // Same blob as the last one loaded from this agent, nothing changed
+    const auto md_hash = hashMD(remote_metadata);
+    auto sec_it = data->remoteSections.find(remote_agent);
+    if ((sec_it != data->remoteSections.end()) &&
+        (sec_it->second->mdSize == remote_metadata.size()) &&
+        (sec_it->second->mdHash == md_hash)) {
+        sec_it->second->touch();
+        agent_name = remote_agent;
+        return NIXL_SUCCESS;
+    }
+
+    // A delta only applies on top of the generation it was made from, while a
+    // reset record replaces whatever was loaded
+    uint64_t md_base = 0, md_gen = 0;
+    bool is_delta = (sd.getBufLen("MDBase") == sizeof(md_base));
+    bool is_reset = (sd.getBufLen("MDReset") == sizeof(md_gen));
+    if (is_reset) {
+        ret = sd.getBuf("MDReset", &md_gen, sizeof(md_gen));
+        if(ret)
+            return ret;
+    } else if (is_delta) {
+        ret = sd.getBuf("MDBase", &md_base, sizeof(md_base));
+        if(ret)
+            return ret;
+        ret = sd.getBuf("MDGen", &md_gen, sizeof(md_gen));
+        if(ret)
+            return ret;
+        if ((sec_it == data->remoteSections.end()) ||
+            (sec_it->second->mdGen != md_base))
+            return NIXL_ERR_MISMATCH;
+    }
+
     NIXL_DEBUG << "Loading remote metadata for agent: " << remote_agent;
 
     ret = sd.getBuf("Conns", &conn_cnt, sizeof(conn_cnt));
@@ -1162,27 +2861,80 @@ nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
     if (count == 0 && conn_cnt > 0)
         return NIXL_ERR_BACKEND;
 
-    if (sd.getStr("") != "MemSection")
+    if (sd.getStr("") != (is_delta ? "MemDelta" : "MemSection"))
         return NIXL_ERR_MISMATCH;
 
+    // Conn info is kept, only the registrations are dropped
+    if (is_reset)
+        data->dropRemoteSection(remote_agent);
+
     if (data->remoteSections.count(remote_agent) == 0)
         data->remoteSections[remote_agent] = new nixlRemoteSection(
-                                                  remote_agent);
-
-    ret = data->remoteSections[remote_agent]->loadRemoteData(&sd,
-                                                  data->backendEngines);
+                                                  remote_agent,
+                                                  data->config.lazyRemoteMD);
+    nixlRemoteSection* section = data->remoteSections[remote_agent];
+
+    if (is_delta) {
+        ret = section->loadRemoteDelta(&sd, data->backendEngines);
+        // Plans might point to the metadata of the removed registrations
+        if (data->plans)
+            data->plans->invalidate(remote_agent);
+    } else {
+        ret = section->loadRemoteData(&sd, data->backendEngines);
+    }
 
     // TODO: can be more graceful, if just the new MD blob was improper
     if (ret) {
-        delete data->remoteSections[remote_agent];
-        data->remoteSections.erase(remote_agent);
+        data->dropRemoteSection(remote_agent);
         return ret;
     }
 
+    // Full metadata has its generation at the end, partial metadata has none
+    // and adds to the loaded generation.
+    if (is_reset || is_delta) {
+        section->mdGen = md_gen;
+    } else if (sd.getBufLen("MDGen") == sizeof(md_gen)) {
+        ret = sd.getBuf("MDGen", &md_gen, sizeof(md_gen));
+        if(ret)
+            return ret;
+        section->mdGen = md_gen;
+    }
+    section->mdSize = remote_metadata.size();
+    section->mdHash = md_hash;
+
+    // Deltas add and remove entries, so the bytes are those held after loading
+    data->remoteMDBytes -= section->mdBytes;
+    section->mdBytes     = section->heldBytes();
+    data->remoteMDBytes += section->mdBytes;
+    section->touch();
+    data->evictRemoteMD(remote_agent);
+
+    {
+        std::lock_guard<std::mutex> guard(data->evictLock);
+        data->evictedAgents.erase(remote_agent);
+    }
+
+    if (data->resolveThread.joinable())
+        data->enqueueResolve(remote_agent);
+
     agent_name = remote_agent;
     return NIXL_SUCCESS;
 }
 
+nixl_status_t
+nixlAgent::waitRemoteMDResolved(const uint64_t timeout_us) const {
+    if (!data->resolveThread.joinable())
+        return NIXL_ERR_NOT_SUPPORTED;
+
+    std::unique_lock<std::mutex> guard(data->resolveQueueLock);
+    bool idle = data->resolveIdleCV.wait_for(guard, std::chrono::microseconds(timeout_us),
+                                             [this]() {
+                                                 return data->resolveQueue.empty() &&
+                                                        !data->resolveBusy;
+                                             });
+    return idle ? NIXL_SUCCESS : NIXL_IN_PROG;
+}
+
 nixl_status_t
 nixlAgent::invalidateRemoteMD(const std::string &remote_agent) {
     NIXL_LOCK_GUARD(data->lock);
@@ -1190,21 +2942,16 @@ nixlAgent::invalidateRemoteMD(const std::string &remote_agent) {
     if (remote_agent == data->name)
         return NIXL_ERR_INVALID_PARAM;
 
-    nixl_status_t ret = NIXL_ERR_NOT_FOUND;
-    if (data->remoteSections.count(remote_agent)!=0) {
-        delete data->remoteSections[remote_agent];
-        data->remoteSections.erase(remote_agent);
-        ret = NIXL_SUCCESS;
-    }
+    if (data->reapPending)
+        data->reapRetired();
 
-    if (data->remoteBackends.count(remote_agent)!=0) {
-        for (auto & it: data->remoteBackends[remote_agent])
-            data->backendEngines[it.first]->disconnect(remote_agent);
-        data->remoteBackends.erase(remote_agent);
-        ret = NIXL_SUCCESS;
+    {
+        // Not fetched again on its next use
+        std::lock_guard<std::mutex> guard(data->evictLock);
+        data->evictedAgents.erase(remote_agent);
     }
 
-    return ret;
+    return data->dropRemoteMD(remote_agent);
 }
 
 nixl_status_t
@@ -1261,6 +3008,12 @@ nixlAgent::fetchRemoteMD (const std::string remote_name,
                           const nixl_opt_args_t* extra_params) {
     // If IP is provided, use socket-based communication
     if (extra_params && !extra_params->ipAddr.empty()) {
+        {
+            // To fetch it again if its metadata is dropped
+            std::lock_guard<std::mutex> guard(data->evictLock);
+            data->mdSources[remote_name] = std::make_pair(extra_params->ipAddr,
+                                                          extra_params->port);
+        }
         data->enqueueCommWork(std::make_tuple(SOCK_FETCH, extra_params->ipAddr, extra_params->port, ""));
         return NIXL_SUCCESS;
     }
@@ -1300,18 +3053,67 @@ nixlAgent::invalidateLocalMD (const nixl_opt_args_t* extra_params) const {
 nixl_status_t
 nixlAgent::checkRemoteMD (const std::string remote_name,
                           const nixl_xfer_dlist_t &descs) const {
-    NIXL_LOCK_GUARD(data->lock);
-    if (data->remoteSections.count(remote_name) != 0) {
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    auto it = data->remoteSections.find(remote_name);
+    if (it != data->remoteSections.end()) {
         if (descs.descCount() == 0) {
             return NIXL_SUCCESS;
         } else {
+            auto bknd_it = data->remoteBackends.find(remote_name);
+            if (bknd_it == data->remoteBackends.end())
+                return NIXL_ERR_NOT_FOUND;
             nixl_meta_dlist_t dummy(descs.getType(), descs.isSorted());
-            for (const auto& [backend, conn_info] : data->remoteBackends[remote_name])
-                if (data->remoteSections[remote_name]->populate(
-                          descs, data->backendEngines[backend], dummy) == NIXL_SUCCESS)
+            for (const auto& [backend, conn_info] : bknd_it->second)
+                if (it->second->populate(
+                          descs, data->backendEngines.at(backend), dummy) == NIXL_SUCCESS)
                     return NIXL_SUCCESS;
             dummy.clear();
         }
     }
     return NIXL_ERR_NOT_FOUND;
 }
+
+nixl_status_t
+nixlAgent::getAgentStats (nixl_stats_t &stats) const {
+    uint64_t hits, misses;
+    size_t   free_cnt;
+
+    data->xferReqPool.getCounters(hits, misses, free_cnt);
+
+    stats.clear();
+    stats["xfer_req_pool_hits"]   = hits;
+    stats["xfer_req_pool_misses"] = misses;
+    stats["xfer_req_pool_free"]   = free_cnt;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    data->selector->getStats(stats);
+    if (data->sched)
+        data->sched->getStats(stats);
+    if (data->plans)
+        data->plans->getStats(stats);
+    stats["xfer_descs.merged"] = data->descsMerged;
+    stats["xfer_descs.split"]  = data->descsSplit;
+
+    // Remote descriptors not loaded yet with lazyRemoteMD
+    uint64_t pending = 0;
+    for (auto &[remote_agent, section] : data->remoteSections)
+        pending += section->pendingCount();
+    stats["remote_md.pending"]   = pending;
+    stats["remote_md.agents"]    = data->remoteSections.size() -
+                                   data->remoteSections.count(data->name);
+    stats["remote_md.bytes"]     = data->remoteMDBytes;
+    stats["remote_md.evictions"] = data->remoteEvictions;
+
+    for (auto &[type, backend] : data->backendEngines) {
+        nixl_stats_t backend_stats;
+        backend->getStats(backend_stats);
+        for (auto &[key, value] : backend_stats)
+            stats["backend." + type + "." + key] = value;
+    }
+
+    for (auto &[backend, reg_time] : data->regTimes) {
+        stats["mem_reg." + backend->getType() + ".us"]    = reg_time.first;
+        stats["mem_reg." + backend->getType() + ".descs"] = reg_time.second;
+    }
+    return NIXL_SUCCESS;
+}
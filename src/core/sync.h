@@ -19,7 +19,11 @@
 #include "common/util.h"
 #include "nixl_params.h"
 #include <mutex>
+#include <shared_mutex>
 
+// Reader/writer lock that is only taken in NIXL_THREAD_SYNC_STRICT mode.
+// Control path methods take it exclusively, while datapath methods that only
+// read the agent bookkeeping take it shared, so they can run concurrently.
 class nixlLock {
     public:
         nixlLock(const nixl_thread_sync_t sync_mode): syncMode(sync_mode)
@@ -37,11 +41,28 @@ class nixlLock {
             }
         }
 
+        void lock_shared() {
+            if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT) {
+                m.lock_shared();
+            }
+        }
+
+        void unlock_shared() {
+            if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT) {
+                m.unlock_shared();
+            }
+        }
+
+        bool isStrict() const {
+            return syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT;
+        }
+
     private:
         nixl_thread_sync_t syncMode;
-        std::mutex m;
+        std::shared_mutex m;
 };
 
 #define NIXL_LOCK_GUARD(lock) const std::lock_guard<nixlLock> UNIQUE_NAME(lock_guard) (lock)
+#define NIXL_SHARED_LOCK_GUARD(lock) const std::shared_lock<nixlLock> UNIQUE_NAME(lock_guard) (lock)
 
 #endif /* SYNC_H */
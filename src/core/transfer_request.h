@@ -17,6 +17,20 @@
 #ifndef __TRANSFER_REQUEST_H_
 #define __TRANSFER_REQUEST_H_
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "common/nixl_time.h"
+#include "mem_section.h"
+
+class nixlXferCQ;
+class nixlBackendSelector;
+class nixlXferSched;
+class nixlSchedRemote;
+
 // Contains pointers to corresponding backend engine and its handler, and populated
 // and verified DescLists, and other state and metadata needed for a NIXL transfer
 class nixlXferReqH {
@@ -24,36 +38,191 @@ class nixlXferReqH {
         nixlBackendEngine* engine         = nullptr;
         nixlBackendReqH*   backendHandle  = nullptr;
 
-        nixl_meta_dlist_t* initiatorDescs = nullptr;
-        nixl_meta_dlist_t* targetDescs    = nullptr;
+        nixl_meta_dlist_t  initiatorDescs{DRAM_SEG};
+        nixl_meta_dlist_t  targetDescs{DRAM_SEG};
+
+        // Scratch space to sort the descriptors, kept when the request is recycled
+        std::vector<std::pair<nixlMetaDesc, nixlMetaDesc>> descPairs;
 
         std::string        remoteAgent;
         nixl_blob_t        notifMsg;
         bool               hasNotif       = false;
 
+        // Remote section the descriptors point to, kept until the request is released
+        nixlSectionUse     sectionUse;
+
         nixl_xfer_op_t     backendOp;
-        nixl_status_t      status;
+
+        // Can be updated from a backend thread through the completion callback
+        std::atomic<nixl_status_t> status{NIXL_ERR_NOT_POSTED};
+
+        // Completion reporting of the current post, either to a queue until it is
+        // polled out of it, or to a user callback. Meanwhile, the request is not
+        // touched by other calls. backendCb is set if the backend reports it.
+        // userCbCtx is set before userCb, which publishes it to the backend thread.
+        nixlXferCQ*                       cq        = nullptr;
+        std::atomic<nixl_completion_cb_t> userCb{nullptr};
+        void*                             userCbCtx = nullptr;
+        std::atomic<bool>                 backendCb{false};
+
+        inline bool tracked() const { return cq || userCb; }
+
+        // Requests of each backend for a striped transfer, which has no engine itself
+        std::vector<nixlXferReqH*> stripes;
+
+        inline bool striped() const { return !stripes.empty(); }
+
+        // Completion time measurement of the current post, if the backend selection
+        // policy uses it. selector is set on creation, postTime on each post, and
+        // checkTime each time the post is checked and still in progress.
+        nixlBackendSelector* selector     = nullptr;
+        size_t               xferBytes    = 0;
+        nixlTime::ns_t       postTime     = 0;
+        nixlTime::ns_t       checkTime    = 0;
+
+        // Agent side scheduling of the current post. A held post is queued in the
+        // scheduler or being issued by the agent, an admitted one is counted in sched.
+        size_t               prio         = 0;
+        std::atomic<bool>    held{false};
+        nixlTime::us_t       queueTime    = 0;
+        nixlXferSched*       sched        = nullptr;
+        nixlSchedRemote*     schedRemote  = nullptr;
+
+        // Called once the post is known to be done, successfully or not. Exact if
+        // it's known as soon as it's done, by the post or the backend callback,
+        // rather than found by a check.
+        void postDone(const bool exact = false);
+
+        // Called after each check of the post in the backend, with status updated
+        void checked();
+
+        // After the user callback is called the request can be reused, even within it
+        inline void callUserCb() {
+            void*                ctx = userCbCtx;
+            nixl_completion_cb_t cb  = userCb.exchange(nullptr);
+            cb(this, status, ctx);
+        }
+
+        // Calls the user callbacks of the given requests. Those of posts done from
+        // within a callback are called once it returns, so reposts don't recurse.
+        static void callUserCbs(nixlXferReqH* const* reqs, const size_t count);
+
+        // Passed to the backend as xferCb, might be called from a backend thread
+        static void completionCb(void* arg, nixl_status_t status);
 
     public:
         inline nixlXferReqH() { }
 
         inline ~nixlXferReqH() {
-            // delete checks for nullptr itself
-            delete initiatorDescs;
-            delete targetDescs;
             if (backendHandle != nullptr)
                 engine->releaseReqH(backendHandle);
         }
 
     friend class nixlAgent;
+    friend class nixlAgentData;
+    friend class nixlXferCQ;
+    friend class nixlXferSched;
 };
 
+// Completion queue of transfer requests. Requests reported by a backend callback
+// are added to cbCompleted, others are kept in pending and checked by the agent
+// on poll. The eventfd is readable while there are done requests to be polled,
+// pending ones don't signal it, or a poll loop would never sleep.
+class nixlXferCQ {
+    private:
+        int                        eventFd;
+        size_t                     reqCount = 0;
+
+        std::mutex                 lock;
+        std::vector<nixlXferReqH*> pending;
+        std::vector<nixlXferReqH*> completed;
+
+        // Separate lock so backend callbacks don't wait behind a poll
+        std::mutex                 cbLock;
+        std::vector<nixlXferReqH*> cbCompleted;
+
+        inline void signal() {
+            uint64_t val = 1;
+            if (write(eventFd, &val, sizeof(val)) < 0) {
+                // Only fails if the counter overflows, so it's readable anyway
+            }
+        }
+
+        // Called with both locks held, after a poll. Done requests might be left
+        // over the max of the poll, or found done by it with no signal yet.
+        inline void resetSignal() {
+            uint64_t val;
+            if (read(eventFd, &val, sizeof(val)) < 0) {
+                // EAGAIN, the counter was already zero
+            }
+            if (!completed.empty() || !cbCompleted.empty())
+                signal();
+        }
+
+    public:
+        inline nixlXferCQ() {
+            eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        }
+
+        inline ~nixlXferCQ() {
+            if (eventFd >= 0)
+                close(eventFd);
+        }
+
+        inline void attach(nixlXferReqH* req) {
+            const std::lock_guard<std::mutex> guard(lock);
+            req->cq = this;
+            reqCount++;
+        }
+
+        // For requests that were not posted successfully
+        inline void detach(nixlXferReqH* req) {
+            const std::lock_guard<std::mutex> guard(lock);
+            req->cq = nullptr;
+            reqCount--;
+        }
+
+        // Request finished within the post, or needs to be checked on poll
+        inline void add(nixlXferReqH* req, const bool done) {
+            const std::lock_guard<std::mutex> guard(lock);
+            if (!done) {
+                pending.push_back(req);
+                return;
+            }
+            if (completed.empty())
+                signal();
+            completed.push_back(req);
+        }
+
+        // Called through the backend completion callback
+        inline void addFromCb(nixlXferReqH* req) {
+            const std::lock_guard<std::mutex> guard(cbLock);
+            if (cbCompleted.empty())
+                signal();
+            cbCompleted.push_back(req);
+        }
+
+    friend class nixlAgent;
+};
+
+inline void nixlXferReqH::completionCb(void* arg, nixl_status_t status) {
+    nixlXferReqH* req = (nixlXferReqH*) arg;
+
+    req->status = status;
+    req->postDone(true);
+    if (req->cq)
+        req->cq->addFromCb(req);
+    else
+        callUserCbs(&req, 1);
+}
+
 class nixlDlistH {
     private:
         std::unordered_map<nixlBackendEngine*, nixl_meta_dlist_t*> descs;
 
         std::string        remoteAgent;
         bool               isLocal;
+        nixlSectionUse     sectionUse;
 
     public:
         inline nixlDlistH() { }
@@ -64,6 +233,7 @@ class nixlDlistH {
         }
 
     friend class nixlAgent;
+    friend class nixlAgentData;
 };
 
 #endif
@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <functional>
+#include "xfer_plan.h"
+
+namespace {
+
+inline void hashCombine(size_t &seed, const size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+void hashDescs(size_t &seed, const nixl_xfer_dlist_t &descs) {
+    hashCombine(seed, descs.getType());
+    hashCombine(seed, descs.isSorted());
+    hashCombine(seed, descs.descCount());
+    for (auto &desc : descs) {
+        hashCombine(seed, desc.addr);
+        hashCombine(seed, desc.len);
+        hashCombine(seed, desc.devId);
+    }
+}
+
+} // anonymous namespace
+
+size_t nixlXferPlanCache::hash(const nixl_xfer_dlist_t &local_descs,
+                               const nixl_xfer_dlist_t &remote_descs,
+                               const std::string &remote_agent,
+                               const std::vector<nixlBackendH*> &backends) {
+    size_t seed = std::hash<std::string>{}(remote_agent);
+
+    for (auto &backend : backends)
+        hashCombine(seed, std::hash<nixlBackendH*>{}(backend));
+    hashDescs(seed, local_descs);
+    hashDescs(seed, remote_descs);
+    return seed;
+}
+
+bool nixlXferPlanCache::matches(const nixlXferPlan &plan,
+                                const nixl_xfer_dlist_t &local_descs,
+                                const nixl_xfer_dlist_t &remote_descs,
+                                const std::string &remote_agent,
+                                const std::vector<nixlBackendH*> &backends) {
+    return (plan.remoteAgent == remote_agent) && (plan.backends == backends) &&
+           (plan.localQuery == local_descs) && (plan.remoteQuery == remote_descs);
+}
+
+bool nixlXferPlanCache::lookup(const size_t hash,
+                               const nixl_xfer_dlist_t &local_descs,
+                               const nixl_xfer_dlist_t &remote_descs,
+                               const std::string &remote_agent,
+                               const std::vector<nixlBackendH*> &backends,
+                               nixlBackendEngine* &engine,
+                               nixl_meta_dlist_t &initiator_descs,
+                               nixl_meta_dlist_t &target_descs,
+                               size_t &xfer_bytes) {
+    const std::lock_guard<std::mutex> guard(lock);
+
+    auto range = index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const nixlXferPlan &plan = *it->second;
+        if (!matches(plan, local_descs, remote_descs, remote_agent, backends))
+            continue;
+
+        engine          = plan.engine;
+        initiator_descs = plan.initiatorDescs;
+        target_descs    = plan.targetDescs;
+        xfer_bytes      = plan.xferBytes;
+        lru.splice(lru.begin(), lru, it->second);
+        hits++;
+        return true;
+    }
+
+    misses++;
+    return false;
+}
+
+void nixlXferPlanCache::insert(const size_t hash,
+                               const nixl_xfer_dlist_t &local_descs,
+                               const nixl_xfer_dlist_t &remote_descs,
+                               const std::string &remote_agent,
+                               const std::vector<nixlBackendH*> &backends,
+                               nixlBackendEngine* engine,
+                               const nixl_meta_dlist_t &initiator_descs,
+                               const nixl_meta_dlist_t &target_descs,
+                               const size_t xfer_bytes) {
+    const std::lock_guard<std::mutex> guard(lock);
+
+    // Another thread might have added the same plan meanwhile
+    auto range = index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+        if (matches(*it->second, local_descs, remote_descs, remote_agent, backends))
+            return;
+
+    // The least recently used plan is overwritten in place, reusing its storage
+    if (lru.size() >= maxPlans) {
+        auto victim = std::prev(lru.end());
+        auto victim_range = index.equal_range(victim->hash);
+        for (auto it = victim_range.first; it != victim_range.second; ++it) {
+            if (it->second == victim) {
+                index.erase(it);
+                break;
+            }
+        }
+        lru.splice(lru.begin(), lru, victim);
+        evictions++;
+    } else {
+        lru.emplace_front();
+    }
+
+    nixlXferPlan &plan  = lru.front();
+    plan.hash           = hash;
+    plan.remoteAgent    = remote_agent;
+    plan.backends       = backends;
+    plan.localQuery     = local_descs;
+    plan.remoteQuery    = remote_descs;
+    plan.engine         = engine;
+    plan.initiatorDescs = initiator_descs;
+    plan.targetDescs    = target_descs;
+    plan.xferBytes      = xfer_bytes;
+    index.emplace(hash, lru.begin());
+}
+
+void nixlXferPlanCache::invalidate() {
+    const std::lock_guard<std::mutex> guard(lock);
+
+    invalidations += lru.size();
+    index.clear();
+    lru.clear();
+}
+
+void nixlXferPlanCache::invalidate(const std::string &remote_agent) {
+    const std::lock_guard<std::mutex> guard(lock);
+
+    for (auto it = index.begin(); it != index.end(); ) {
+        if (it->second->remoteAgent == remote_agent) {
+            lru.erase(it->second);
+            it = index.erase(it);
+            invalidations++;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void nixlXferPlanCache::getStats(nixl_stats_t &stats) {
+    const std::lock_guard<std::mutex> guard(lock);
+
+    stats["xfer_plan.hits"]          = hits;
+    stats["xfer_plan.misses"]        = misses;
+    stats["xfer_plan.entries"]       = lru.size();
+    stats["xfer_plan.evictions"]     = evictions;
+    stats["xfer_plan.invalidations"] = invalidations;
+}
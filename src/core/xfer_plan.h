@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __XFER_PLAN_H_
+#define __XFER_PLAN_H_
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "nixl_types.h"
+#include "nixl_descriptors.h"
+#include "backend/backend_aux.h"
+
+class nixlBackendH;
+class nixlBackendEngine;
+
+// The outcome of createXferReq for a pair of descriptor lists: the populated
+// lists and the chosen engine. The query lists are kept to rule out collisions.
+class nixlXferPlan {
+    public:
+        size_t                     hash;
+        std::string                remoteAgent;
+        std::vector<nixlBackendH*> backends;
+        nixl_xfer_dlist_t          localQuery;
+        nixl_xfer_dlist_t          remoteQuery;
+
+        nixlBackendEngine*         engine;
+        nixl_meta_dlist_t          initiatorDescs;
+        nixl_meta_dlist_t          targetDescs;
+        size_t                     xferBytes;
+
+        nixlXferPlan() : localQuery(DRAM_SEG), remoteQuery(DRAM_SEG),
+                         initiatorDescs(DRAM_SEG), targetDescs(DRAM_SEG) { }
+};
+
+// LRU cache of transfer plans, so repeated createXferReq calls with the same
+// descriptor lists skip the backend matching and the populate of both sides.
+// Plans point to the registration metadata, so they have to be dropped when
+// a local registration or the metadata of their remote agent goes away.
+class nixlXferPlanCache {
+    private:
+        using plan_list_t = std::list<nixlXferPlan>;
+
+        const size_t                                       maxPlans;
+
+        std::mutex                                         lock;
+        // Most recently used first
+        plan_list_t                                        lru;
+        std::unordered_multimap<size_t, plan_list_t::iterator> index;
+
+        uint64_t                                           hits          = 0;
+        uint64_t                                           misses        = 0;
+        uint64_t                                           evictions     = 0;
+        uint64_t                                           invalidations = 0;
+
+        static bool matches(const nixlXferPlan &plan,
+                            const nixl_xfer_dlist_t &local_descs,
+                            const nixl_xfer_dlist_t &remote_descs,
+                            const std::string &remote_agent,
+                            const std::vector<nixlBackendH*> &backends);
+
+    public:
+        nixlXferPlanCache(const size_t max_plans) : maxPlans(max_plans) { }
+
+        static size_t hash(const nixl_xfer_dlist_t &local_descs,
+                           const nixl_xfer_dlist_t &remote_descs,
+                           const std::string &remote_agent,
+                           const std::vector<nixlBackendH*> &backends);
+
+        // Copies the plan to the given lists on a hit
+        bool lookup(const size_t hash,
+                    const nixl_xfer_dlist_t &local_descs,
+                    const nixl_xfer_dlist_t &remote_descs,
+                    const std::string &remote_agent,
+                    const std::vector<nixlBackendH*> &backends,
+                    nixlBackendEngine* &engine,
+                    nixl_meta_dlist_t &initiator_descs,
+                    nixl_meta_dlist_t &target_descs,
+                    size_t &xfer_bytes);
+
+        void insert(const size_t hash,
+                    const nixl_xfer_dlist_t &local_descs,
+                    const nixl_xfer_dlist_t &remote_descs,
+                    const std::string &remote_agent,
+                    const std::vector<nixlBackendH*> &backends,
+                    nixlBackendEngine* engine,
+                    const nixl_meta_dlist_t &initiator_descs,
+                    const nixl_meta_dlist_t &target_descs,
+                    const size_t xfer_bytes);
+
+        // Drops all the plans, or the ones to a remote agent
+        void invalidate();
+        void invalidate(const std::string &remote_agent);
+
+        void getStats(nixl_stats_t &stats);
+};
+
+#endif
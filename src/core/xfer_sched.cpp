@@ -0,0 +1,257 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nixl.h"
+#include "backend/backend_engine.h"
+#include "transfer_request.h"
+#include "xfer_sched.h"
+
+nixlXferSched::nixlXferSched(const nixlAgentConfig &cfg) :
+                             prioHoldBytes(cfg.prioHoldBytes),
+                             remoteMaxBytes(cfg.remoteMaxBytes),
+                             remoteMaxReqs(cfg.remoteMaxReqs),
+                             totalMaxBytes(cfg.totalMaxBytes),
+                             totalMaxReqs(cfg.totalMaxReqs) { }
+
+bool nixlSchedRemote::idle() const {
+    if (inflightReqs > 0)
+        return false;
+    for (auto &cnt : queued)
+        if (cnt > 0)
+            return false;
+    return true;
+}
+
+bool nixlXferSched::enabled(const nixlAgentConfig &cfg) {
+    return (cfg.prioHoldBytes > 0) || (cfg.remoteMaxBytes > 0) || (cfg.remoteMaxReqs > 0) ||
+           (cfg.totalMaxBytes > 0) || (cfg.totalMaxReqs > 0);
+}
+
+// Called with the lock held
+bool nixlXferSched::higherActive(const size_t prio) const {
+    for (size_t i = 0; i < prio; ++i)
+        if ((classes[i].inflightReqs > 0) || !classes[i].queue.empty())
+            return true;
+    return false;
+}
+
+// Called with the lock held
+bool nixlXferSched::fitsPrio(const nixlXferReqH* req) const {
+    const prioClass &cls = classes[req->prio];
+
+    if ((prioHoldBytes > 0) && higherActive(req->prio) &&
+        (cls.inflightBytes + req->xferBytes > prioHoldBytes))
+        return false;
+    return true;
+}
+
+// Called with the lock held, a post larger than the limit can go alone
+bool nixlXferSched::fitsTotal(const nixlXferReqH* req) const {
+    if (inflightReqs == 0)
+        return true;
+    if ((totalMaxReqs > 0) && (inflightReqs + 1 > totalMaxReqs))
+        return false;
+    if ((totalMaxBytes > 0) && (inflightBytes + req->xferBytes > totalMaxBytes))
+        return false;
+    return true;
+}
+
+// Called with the lock held, same as fitsTotal
+bool nixlXferSched::fitsRemote(const nixlXferReqH* req) const {
+    const nixlSchedRemote* remote = req->schedRemote;
+
+    if (remote->inflightReqs == 0)
+        return true;
+    if ((remoteMaxReqs > 0) && (remote->inflightReqs + 1 > remoteMaxReqs))
+        return false;
+    if ((remoteMaxBytes > 0) && (remote->inflightBytes + req->xferBytes > remoteMaxBytes))
+        return false;
+    return true;
+}
+
+// Called with the lock held
+void nixlXferSched::addInflight(nixlXferReqH* req) {
+    prioClass       &cls    = classes[req->prio];
+    nixlSchedRemote* remote = req->schedRemote;
+
+    cls.inflightBytes    += req->xferBytes;
+    cls.inflightReqs++;
+    cls.posts++;
+    remote->inflightBytes += req->xferBytes;
+    remote->inflightReqs++;
+    inflightBytes        += req->xferBytes;
+    inflightReqs++;
+    req->sched = this;
+}
+
+// Called with the lock held
+void nixlXferSched::pruneRemote(nixlSchedRemote* remote, const std::string &remote_agent) {
+    if (remote->removed && remote->idle())
+        remotes.erase(remote_agent);
+}
+
+bool nixlXferSched::admit(nixlXferReqH* req) {
+    const std::lock_guard<std::mutex> guard(lock);
+
+    // Looked up on each post, as the entry goes with the agent's metadata
+    req->schedRemote = &remotes[req->remoteAgent];
+    nixlSchedRemote* remote = req->schedRemote;
+    remote->removed = false;
+
+    // Posts of a class to an agent are issued in order, and behind held higher
+    // priority ones to any agent
+    bool queued = remote->queued[req->prio] > 0;
+    for (size_t i = 0; i < req->prio; ++i)
+        if (!classes[i].queue.empty())
+            queued = true;
+
+    if (!queued) {
+        bool fits_remote = fitsRemote(req);
+        bool fits_total  = fitsTotal(req);
+
+        if (fits_remote && fits_total && fitsPrio(req)) {
+            addInflight(req);
+            return true;
+        }
+
+        if (!fits_remote)
+            remote->throttled++;
+        if (!fits_total)
+            throttled++;
+    }
+
+    req->held      = true;
+    req->queueTime = nixlTime::getUs();
+    classes[req->prio].queue.push_back(req);
+    classes[req->prio].held++;
+    remote->queued[req->prio]++;
+    queuedCnt++;
+    return false;
+}
+
+void nixlXferSched::pop(std::vector<nixlXferReqH*> &reqs) {
+    const nixlTime::us_t now = nixlTime::getUs();
+
+    const std::lock_guard<std::mutex> guard(lock);
+
+    // Once a post to an agent stays held, later ones of its class to the agent
+    // stay held as well, and lower classes stay behind a held one
+    pops++;
+    for (auto &cls : classes) {
+        for (auto it = cls.queue.begin(); it != cls.queue.end();) {
+            nixlXferReqH*    req    = *it;
+            nixlSchedRemote* remote = req->schedRemote;
+
+            if ((remote->blockedPop == pops) ||
+                !fitsRemote(req) || !fitsTotal(req) || !fitsPrio(req)) {
+                remote->blockedPop = pops;
+                ++it;
+                continue;
+            }
+
+            it = cls.queue.erase(it);
+            remote->queued[req->prio]--;
+            queuedCnt--;
+
+            uint64_t delay = now - req->queueTime;
+            cls.delaySumUs += delay;
+            cls.delayMaxUs  = std::max(cls.delayMaxUs, delay);
+
+            addInflight(req);
+            reqs.push_back(req);
+        }
+        if (!cls.queue.empty())
+            break;
+    }
+}
+
+void nixlXferSched::done(nixlXferReqH* req) {
+    const std::lock_guard<std::mutex> guard(lock);
+    prioClass       &cls    = classes[req->prio];
+    nixlSchedRemote* remote = req->schedRemote;
+
+    cls.inflightBytes    -= req->xferBytes;
+    cls.inflightReqs--;
+    remote->inflightBytes -= req->xferBytes;
+    remote->inflightReqs--;
+    inflightBytes        -= req->xferBytes;
+    inflightReqs--;
+    req->sched = nullptr;
+    pruneRemote(remote, req->remoteAgent);
+}
+
+bool nixlXferSched::cancel(nixlXferReqH* req) {
+    const std::lock_guard<std::mutex> guard(lock);
+    auto &queue = classes[req->prio].queue;
+
+    auto it = std::find(queue.begin(), queue.end(), req);
+    if (it == queue.end())
+        return false;
+
+    queue.erase(it);
+    req->schedRemote->queued[req->prio]--;
+    queuedCnt--;
+    req->held = false;
+    pruneRemote(req->schedRemote, req->remoteAgent);
+    return true;
+}
+
+void nixlXferSched::removeRemote(const std::string &remote_agent) {
+    const std::lock_guard<std::mutex> guard(lock);
+
+    auto it = remotes.find(remote_agent);
+    if (it == remotes.end())
+        return;
+    it->second.removed = true;
+    pruneRemote(&it->second, remote_agent);
+}
+
+void nixlXferSched::getStats(nixl_stats_t &stats) const {
+    static const std::array<std::string, NIXL_XFER_PRIO_CNT> names =
+                                                  {"high", "normal", "bulk"};
+
+    const std::lock_guard<std::mutex> guard(lock);
+    for (size_t i = 0; i < NIXL_XFER_PRIO_CNT; ++i) {
+        const prioClass &cls    = classes[i];
+        const std::string prefix = "xfer_sched." + names[i] + ".";
+
+        stats[prefix + "posts"]              = cls.posts;
+        stats[prefix + "held"]               = cls.held;
+        stats[prefix + "queued"]             = cls.queue.size();
+        stats[prefix + "inflight_bytes"]     = cls.inflightBytes;
+        stats[prefix + "inflight_reqs"]      = cls.inflightReqs;
+        stats[prefix + "queue_delay_us"]     = cls.delaySumUs;
+        stats[prefix + "queue_delay_max_us"] = cls.delayMaxUs;
+    }
+
+    // Throttled counts the posts held by the limits, not the ones queued behind them
+    stats["xfer_sched.inflight_bytes"] = inflightBytes;
+    stats["xfer_sched.inflight_reqs"]  = inflightReqs;
+    stats["xfer_sched.throttled"]      = throttled;
+
+    for (auto &elm : remotes) {
+        const std::string prefix = "xfer_sched.remote." + elm.first + ".";
+        size_t            queued = 0;
+
+        for (auto &cnt : elm.second.queued)
+            queued += cnt;
+
+        stats[prefix + "inflight_bytes"] = elm.second.inflightBytes;
+        stats[prefix + "inflight_reqs"]  = elm.second.inflightReqs;
+        stats[prefix + "queued"]         = queued;
+        stats[prefix + "throttled"]      = elm.second.throttled;
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __XFER_SCHED_H_
+#define __XFER_SCHED_H_
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "nixl_types.h"
+#include "nixl_params.h"
+
+class nixlXferReqH;
+
+#define NIXL_XFER_PRIO_CNT 3
+
+// Posts in flight to a remote agent and held for it
+class nixlSchedRemote {
+    public:
+        uint64_t inflightBytes = 0;
+        uint64_t inflightReqs  = 0;
+        uint64_t throttled     = 0;
+        std::array<size_t, NIXL_XFER_PRIO_CNT> queued{};
+
+        // Set during a pop once a held post to the agent is not admitted
+        uint64_t blockedPop    = 0;
+
+        // The agent's metadata was dropped, removed once it has no posts left
+        bool     removed       = false;
+
+        bool idle() const;
+};
+
+// Agent side admission of transfer posts, between postXferReq and the backend
+// postXfer, so it works for all backends. Posts that are not admitted are held
+// in a queue per priority class, and issued by the agent once in flight posts
+// are done. Lower priority classes are held back while higher ones are active,
+// and bytes and requests in flight are limited per remote agent and in total.
+// Posts of a class to the same agent are issued in order, so a throttled agent
+// only holds back its own posts of that class, while posts of lower classes stay
+// held behind any held post of a higher one.
+class nixlXferSched {
+    private:
+        class prioClass {
+            public:
+                uint64_t                  inflightBytes = 0;
+                uint64_t                  inflightReqs  = 0;
+                std::deque<nixlXferReqH*> queue;
+
+                uint64_t                  posts         = 0;
+                uint64_t                  held          = 0;
+                uint64_t                  delaySumUs    = 0;
+                uint64_t                  delayMaxUs    = 0;
+        };
+
+        // Max bytes in flight of a class while a higher priority class is active,
+        // and limits of bytes and requests in flight, 0 if not limited
+        const uint64_t                         prioHoldBytes;
+        const uint64_t                         remoteMaxBytes;
+        const uint64_t                         remoteMaxReqs;
+        const uint64_t                         totalMaxBytes;
+        const uint64_t                         totalMaxReqs;
+
+        mutable std::mutex                     lock;
+        std::array<prioClass, NIXL_XFER_PRIO_CNT> classes;
+        std::unordered_map<std::string, nixlSchedRemote> remotes;
+        std::atomic<size_t>                    queuedCnt{0};
+
+        uint64_t                               inflightBytes = 0;
+        uint64_t                               inflightReqs  = 0;
+        uint64_t                               throttled     = 0;
+        uint64_t                               pops          = 0;
+
+        bool higherActive(const size_t prio) const;
+        bool fitsPrio(const nixlXferReqH* req) const;
+        bool fitsTotal(const nixlXferReqH* req) const;
+        bool fitsRemote(const nixlXferReqH* req) const;
+        void addInflight(nixlXferReqH* req);
+        void pruneRemote(nixlSchedRemote* remote, const std::string &remote_agent);
+
+    public:
+        nixlXferSched(const nixlAgentConfig &cfg);
+
+        // If the agent config enables any limit
+        static bool enabled(const nixlAgentConfig &cfg);
+
+        // Admits a post to be issued now, or holds it in the queue of its class
+        bool admit(nixlXferReqH* req);
+
+        // Moves the held posts that can be issued now to reqs, in priority order
+        void pop(std::vector<nixlXferReqH*> &reqs);
+
+        // An admitted post is done, or abandoned
+        void done(nixlXferReqH* req);
+
+        // Removes a held post, false if it's not in the queue anymore
+        bool cancel(nixlXferReqH* req);
+
+        // The metadata of the agent was dropped, its entry goes once it's idle
+        void removeRemote(const std::string &remote_agent);
+
+        bool hasQueued() const { return queuedCnt > 0; }
+
+        void getStats(nixl_stats_t &stats) const;
+};
+
+#endif
@@ -0,0 +1,292 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __INTERVAL_TREE_H
+#define __INTERVAL_TREE_H
+
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include "nixl_descriptors.h"
+
+/**
+ * @brief Ordered multiset of entries keyed by a nixlBasicDesc, that also finds the
+ *        entries covering a query
+ *
+ * Entries are kept in the nixlBasicDesc order (devId, address, length) in a treap,
+ * where each node also keeps the furthest (devId, end address) of its subtree.
+ * Entries covering a query start at or before it and reach its end, so subtrees
+ * that don't reach it are skipped. Insert, erase, exact and cover lookups are
+ * O(log n) expected, and going through the k covering entries is O(k log n).
+ * Entries are not moved once inserted, until they're erased.
+ */
+template <typename T, typename KeyOf>
+class nixlIntervalTree {
+    private:
+        using end_t = std::pair<uint64_t, uintptr_t>;
+
+        class node {
+            public:
+                T        value;
+                node*    left   = nullptr;
+                node*    right  = nullptr;
+                node*    parent = nullptr;
+                uint32_t prio;
+                end_t    maxEnd;
+
+                node(const T &value, const uint32_t prio) : value(value), prio(prio) { }
+        };
+
+        node*    root  = nullptr;
+        size_t   count = 0;
+        uint32_t seed  = 2463534242u;
+
+        static inline const nixlBasicDesc &key(const node* n) { return KeyOf()(n->value); }
+
+        static inline end_t endOf(const nixlBasicDesc &desc) {
+            return end_t(desc.devId, desc.addr + desc.len);
+        }
+
+        // Start of the entries that start at or before the query
+        static inline nixlBasicDesc startOf(const nixlBasicDesc &query) {
+            return nixlBasicDesc(query.addr, SIZE_MAX, query.devId);
+        }
+
+        // Xorshift, priorities only need to be spread
+        inline uint32_t nextPrio() {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            return seed;
+        }
+
+        // Called once the children of a node change
+        static void update(node* n) {
+            n->maxEnd = endOf(key(n));
+            for (node* child : {n->left, n->right}) {
+                if (!child)
+                    continue;
+                child->parent = n;
+                if (n->maxEnd < child->maxEnd)
+                    n->maxEnd = child->maxEnd;
+            }
+        }
+
+        // Into the entries before k, and the ones at or after it
+        static void split(node* n, const nixlBasicDesc &k, node* &l, node* &r) {
+            if (!n) {
+                l = r = nullptr;
+            } else if (key(n) < k) {
+                split(n->right, k, n->right, r);
+                l = n;
+                update(l);
+            } else {
+                split(n->left, k, l, n->left);
+                r = n;
+                update(r);
+            }
+        }
+
+        // All the entries of l are at or before the ones of r
+        static node* merge(node* l, node* r) {
+            if (!l || !r)
+                return l ? l : r;
+            if (l->prio > r->prio) {
+                l->right = merge(l->right, r);
+                update(l);
+                return l;
+            }
+            r->left = merge(l, r->left);
+            update(r);
+            return r;
+        }
+
+        // Entries equal to k can be on both sides of one that is
+        static node* findNode(node* n, const nixlBasicDesc &k, const T* value) {
+            while (n) {
+                if (k < key(n)) {
+                    n = n->left;
+                } else if (key(n) < k) {
+                    n = n->right;
+                } else {
+                    if (!value || (&n->value == value))
+                        return n;
+                    node* found = findNode(n->left, k, value);
+                    return found ? found : findNode(n->right, k, value);
+                }
+            }
+            return nullptr;
+        }
+
+        template <typename F>
+        static const T* findCover(const node* n, const nixlBasicDesc &query,
+                                  const nixlBasicDesc &q_start, const end_t &q_end,
+                                  F &accept) {
+            if (!n || (n->maxEnd < q_end))
+                return nullptr;
+            const T* found = findCover(n->left, query, q_start, q_end, accept);
+            if (found || (q_start < key(n)))
+                return found;
+            if (key(n).covers(query) && accept(n->value))
+                return &n->value;
+            return findCover(n->right, query, q_start, q_end, accept);
+        }
+
+        static void destroy(node* n) {
+            if (!n)
+                return;
+            destroy(n->left);
+            destroy(n->right);
+            delete n;
+        }
+
+    public:
+        class const_iterator {
+            private:
+                const node* n;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = T;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = const T*;
+                using reference         = const T&;
+
+                explicit const_iterator(const node* n = nullptr) : n(n) { }
+
+                reference operator*() const { return n->value; }
+                pointer operator->() const { return &n->value; }
+
+                const_iterator &operator++() {
+                    if (n->right) {
+                        n = n->right;
+                        while (n->left)
+                            n = n->left;
+                    } else {
+                        while (n->parent && (n->parent->right == n))
+                            n = n->parent;
+                        n = n->parent;
+                    }
+                    return *this;
+                }
+
+                const_iterator operator++(int) {
+                    const_iterator prev = *this;
+                    ++(*this);
+                    return prev;
+                }
+
+                bool operator==(const const_iterator &other) const { return n == other.n; }
+                bool operator!=(const const_iterator &other) const { return n != other.n; }
+        };
+
+        nixlIntervalTree() { }
+        nixlIntervalTree(const nixlIntervalTree &) = delete;
+        nixlIntervalTree &operator=(const nixlIntervalTree &) = delete;
+        ~nixlIntervalTree() { destroy(root); }
+
+        inline size_t size() const { return count; }
+        inline bool empty() const { return count == 0; }
+
+        const_iterator begin() const {
+            const node* n = root;
+            while (n && n->left)
+                n = n->left;
+            return const_iterator(n);
+        }
+
+        const_iterator end() const { return const_iterator(); }
+
+        // Placed before the entries equal to it
+        const T* insert(const T &value) {
+            node* n = new node(value, nextPrio());
+            node *l, *r;
+
+            update(n);
+            split(root, key(n), l, r);
+            root = merge(merge(l, n), r);
+            root->parent = nullptr;
+            count++;
+            return &n->value;
+        }
+
+        // Removes the given entry, or any entry equal to k if not given
+        bool erase(const nixlBasicDesc &k, const T* value = nullptr) {
+            node* n = findNode(root, k, value);
+            if (!n)
+                return false;
+
+            node* parent = n->parent;
+            node* sub    = merge(n->left, n->right);
+            if (sub)
+                sub->parent = parent;
+            if (!parent)
+                root = sub;
+            else if (parent->left == n)
+                parent->left = sub;
+            else
+                parent->right = sub;
+            for (node* p = parent; p; p = p->parent)
+                update(p);
+
+            delete n;
+            count--;
+            return true;
+        }
+
+        void clear() {
+            destroy(root);
+            root  = nullptr;
+            count = 0;
+        }
+
+        // An entry equal to k
+        const T* find(const nixlBasicDesc &k) const {
+            const node* n = findNode(root, k, nullptr);
+            return n ? &n->value : nullptr;
+        }
+
+        // An entry that covers the query. If one of the left subtree reaches the query
+        // and they all start before it, one of them covers it, so this goes down a
+        // single path.
+        const T* cover(const nixlBasicDesc &query) const {
+            const nixlBasicDesc q_start = startOf(query);
+            const end_t         q_end   = endOf(query);
+            const node*         n       = root;
+
+            while (n && !(n->maxEnd < q_end)) {
+                if (q_start < key(n)) {
+                    n = n->left;
+                    continue;
+                }
+                if (key(n).covers(query))
+                    return &n->value;
+                if (n->left && !(n->left->maxEnd < q_end))
+                    n = n->left;
+                else
+                    n = n->right;
+            }
+            return nullptr;
+        }
+
+        // The first entry in order that covers the query and is accepted
+        template <typename F>
+        const T* findCover(const nixlBasicDesc &query, F accept) const {
+            return findCover(root, query, startOf(query), endOf(query), accept);
+        }
+};
+
+#endif
@@ -23,7 +23,13 @@
 #include <array>
 #include <string>
 #include <set>
+#include <deque>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include "nixl_descriptors.h"
+#include "interval_tree.h"
 #include "nixl.h"
 #include "backend/backend_engine.h"
 
@@ -40,6 +46,8 @@ using backend_map_t = std::unordered_map<nixl_backend_t, nixlBackendEngine*>;
 class nixlSectionDesc : public nixlMetaDesc {
 public:
     nixl_blob_t metaBlob;
+    // Remote entry whose backend metadata is loaded on first use
+    bool        pending = false;
 
     using nixlMetaDesc::nixlMetaDesc;
 
@@ -59,13 +67,142 @@ public:
 };
 
 using nixl_sec_dlist_t = nixlDescList<nixlSectionDesc>;
-using section_map_t = std::map<section_key_t, nixl_sec_dlist_t*>;
+
+// Min number of equal blocks at a fixed stride sent as one range record
+#define NIXL_SEC_RANGE_MIN 4
+
+/**
+ * @brief Run of equal size blocks at a fixed stride that share their meta blob,
+ *        e.g. blocks registered in one slab. Sent as one record in the metadata,
+ *        and the remote side adds a block as a descriptor when it is first used.
+ */
+class nixlSectionRange {
+public:
+    nixlBasicDesc first; // The other blocks follow at stride
+    size_t        stride = 0;
+    size_t        count  = 0;
+    nixl_blob_t   metaBlob;
+
+    inline nixlBasicDesc block(const size_t idx) const {
+        return nixlBasicDesc(first.addr + idx * stride, first.len, first.devId);
+    }
+
+    inline nixlBasicDesc span() const {
+        return nixlBasicDesc(first.addr, (count - 1) * stride + first.len, first.devId);
+    }
+
+    // Index of the block that covers the query, count if there is none
+    inline size_t find(const nixlBasicDesc &query) const {
+        if ((query.devId != first.devId) || (query.addr < first.addr))
+            return count;
+        size_t idx = (query.addr - first.addr) / stride;
+        if ((idx >= count) || !block(idx).covers(query))
+            return count;
+        return idx;
+    }
+};
+
+/**
+ * @brief Index of the section descriptors of one memory type and backend
+ *
+ * Descriptors are kept in an interval tree ordered by devId, then address and
+ * length, the same order as a sorted nixl_sec_dlist_t. Insert, remove, exact
+ * and cover lookups are O(log n), including with overlapping registrations.
+ * Range records are kept the same way by their span.
+ */
+class nixlSectionIndex {
+    private:
+        class descKey {
+            public:
+                const nixlBasicDesc &operator()(const nixlSectionDesc &desc) const {
+                    return desc;
+                }
+        };
+
+        using range_entry_t = std::pair<nixlBasicDesc, nixlSectionRange>;
+
+        class rangeKey {
+            public:
+                const nixlBasicDesc &operator()(const range_entry_t &entry) const {
+                    return entry.first;
+                }
+        };
+
+        using sec_tree_t   = nixlIntervalTree<nixlSectionDesc, descKey>;
+        using range_tree_t = nixlIntervalTree<range_entry_t, rangeKey>;
+
+        nixl_mem_t                             type;
+        sec_tree_t                             descs;
+
+        // Entries added without their backend metadata
+        std::atomic<size_t>                    pending{0};
+
+        // Memory held by the entries and their blobs
+        std::atomic<size_t>                    bytes{0};
+
+        // Range records by their span
+        range_tree_t                           ranges;
+
+        const range_entry_t* findRange (const nixlBasicDesc &query, size_t &idx) const;
+
+    public:
+        using const_iterator = sec_tree_t::const_iterator;
+
+        nixlSectionIndex (const nixl_mem_t &type) : type(type) {}
+
+        inline nixl_mem_t getType() const { return type; }
+        inline int descCount() const { return (int) descs.size(); }
+        inline int rangeCount() const { return (int) ranges.size(); }
+        inline size_t pendingCount() const { return pending; }
+        inline size_t heldBytes() const { return bytes; }
+        inline bool isEmpty() const { return descs.empty() && ranges.empty(); }
+
+        inline const_iterator begin() const { return descs.begin(); }
+        inline const_iterator end() const { return descs.end(); }
+
+        void addDesc (const nixlSectionDesc &desc);
+        // Removes one matching descriptor, returns false if none was found
+        bool remDesc (const nixlBasicDesc &desc);
+
+        // Exact match on devId, address and length
+        const nixlSectionDesc* find (const nixlBasicDesc &query) const;
+        // A registration that fully covers the query
+        const nixlSectionDesc* cover (const nixlBasicDesc &query) const;
+
+        // Sets the backend metadata of a pending entry, which doesn't change its order
+        void setMetadata (const nixlSectionDesc* desc, nixlBackendMD* metadata);
+
+        void addRange (const nixlSectionRange &range);
+        // A range with a block that covers the query, and the index of the block
+        const nixlSectionRange* coverRange (const nixlBasicDesc &query, size_t &idx) const;
+        // Takes a block out of its range, splitting it, false if none has it
+        bool remRangeBlock (const nixlBasicDesc &block);
+
+        // Serialized as a sorted nixl_sec_dlist_t, followed by the range records
+        // for the runs of at least NIXL_SEC_RANGE_MIN blocks
+        nixl_status_t serialize (nixlSerDes* serializer) const;
+};
+
+using section_map_t = std::map<section_key_t, nixlSectionIndex*>;
+
+// Max number of registration changes kept for metadata deltas
+#define NIXL_MD_LOG_SIZE (64 * 1024)
 
 class nixlMemSection {
     protected:
         std::array<backend_set_t, FILE_SEG+1>         memToBackend;
         section_map_t                                 sectionMap;
 
+        // Sections with pending entries or range records load them while populating,
+        // which can run concurrently. Readers hold it shared if there are any.
+        mutable std::shared_mutex                     resolveLock;
+
+        // Loads the metadata of the pending entry or the range block that covers
+        // the query, called with resolveLock held
+        virtual nixl_status_t resolveEntry (nixlSectionIndex* index,
+                                            nixlBackendEngine* backend,
+                                            const nixlBasicDesc &query) const;
+
     public:
         nixlMemSection () {};
 
@@ -81,7 +218,43 @@ class nixlMemSection {
 
 
 class nixlLocalSection : public nixlMemSection {
+    private:
+        // Registrations added to or removed from the metadata, per generation
+        class nixlMDChange {
+            public:
+                uint64_t      gen;
+                bool          added;
+                section_key_t secKey;
+                nixlBasicDesc desc;
+        };
+
+        uint64_t                   mdGen = 0;
+        // Oldest generation a delta can start from
+        uint64_t                   mdLogBase = 0;
+        std::deque<nixlMDChange>   mdLog;
+
+        void logChanges (const nixl_reg_dlist_t &mem_elms,
+                         const section_key_t &sec_key,
+                         const bool added);
+
+        // Max threads registering the descs of a list, for backends that support it
+        uint64_t                   regThreads;
+
+        nixl_status_t registerDesc (nixlBackendEngine* backend,
+                                    const nixlBlobDesc &mem,
+                                    const nixl_mem_t &nixl_mem,
+                                    nixlSectionDesc &local_sec,
+                                    nixlSectionDesc &self_sec) const;
+
     public:
+        nixlLocalSection (const uint64_t reg_threads = 0) : regThreads(reg_threads) {}
+
+        // Generation of the metadata, bumped on each change to the registrations
+        inline uint64_t getGen() const { return mdGen; }
+
+        // Starts a generation that no delta can go across, e.g. for new conn info
+        void resetLog ();
+
         nixl_status_t addDescList (const nixl_reg_dlist_t &mem_elms,
                                    nixlBackendEngine* backend,
                                    nixl_sec_dlist_t &remote_self);
@@ -96,10 +269,71 @@ class nixlLocalSection : public nixlMemSection {
                                        const backend_set_t &backends,
                                        const nixl_reg_dlist_t &mem_elms) const;
 
+        // Registrations removed and added since since_gen. NIXL_ERR_NOT_FOUND
+        // if the changes are no longer in the log, the full metadata is needed.
+        nixl_status_t serializeDelta(nixlSerDes* serializer,
+                                     const uint64_t since_gen) const;
+
         ~nixlLocalSection();
 };
 
 
+// Use of a remote section, shared with the handles that point to its metadata, so it
+// is not dropped to make room while they are outstanding, and they can mark it used
+class nixlSectionUsage {
+    public:
+        std::atomic<uint64_t> users{0};
+        std::atomic<uint64_t> lastUse{0};
+        // The section was replaced or dropped, its handles can't be posted anymore
+        std::atomic<bool>     stale{false};
+        // Metadata is kept for the handles, and freed once the last one is released
+        std::atomic<bool>     retired{false};
+
+        inline void touch() {
+            lastUse.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                          std::memory_order_relaxed);
+        }
+};
+
+// Held by a handle for as long as it points to the metadata of a remote section
+class nixlSectionUse {
+    private:
+        std::shared_ptr<nixlSectionUsage> usage;
+
+    public:
+        nixlSectionUse() { }
+        nixlSectionUse(const nixlSectionUse &) = delete;
+        nixlSectionUse &operator=(const nixlSectionUse &) = delete;
+        ~nixlSectionUse() { release(); }
+
+        inline void acquire(const std::shared_ptr<nixlSectionUsage> &section_usage) {
+            release();
+            usage = section_usage;
+            usage->users.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // True for the last user of a section with retired metadata
+        inline bool release() {
+            if (!usage)
+                return false;
+            bool last = (usage->users.fetch_sub(1, std::memory_order_acq_rel) == 1) &&
+                        usage->retired.load(std::memory_order_relaxed);
+            usage.reset();
+            return last;
+        }
+
+        inline void touch() const {
+            if (usage)
+                usage->touch();
+        }
+
+        inline bool stale() const {
+            return usage && usage->stale.load(std::memory_order_relaxed);
+        }
+
+        inline const std::shared_ptr<nixlSectionUsage> &get() const { return usage; }
+};
+
 class nixlRemoteSection : public nixlMemSection {
     private:
         std::string agentName;
@@ -107,12 +341,54 @@ class nixlRemoteSection : public nixlMemSection {
         nixl_status_t addDescList (
                            const nixl_reg_dlist_t &mem_elms,
                            nixlBackendEngine *backend);
+        nixl_status_t remDescList (
+                           const nixl_reg_dlist_t &mem_elms,
+                           nixlBackendEngine *backend);
+        nixl_status_t addRange (const nixl_mem_t &nixl_mem,
+                                const nixlSectionRange &range,
+                                nixlBackendEngine *backend);
+
+        nixl_status_t resolveEntry (nixlSectionIndex* index,
+                                    nixlBackendEngine* backend,
+                                    const nixlBasicDesc &query) const override;
+
+        // Keep the blobs and load the backend metadata on first use
+        bool lazyLoad;
+
+        // Metadata of entries removed while handles might still use it
+        std::vector<std::pair<nixlBackendEngine*, nixlBackendMD*>> removedMD;
     public:
-        nixlRemoteSection (const std::string &agent_name);
+        // Generation of the last metadata loaded from the agent, and the size and
+        // 128-bit hash of its blob to skip loading the same blob again
+        uint64_t                      mdGen = 0;
+        size_t                        mdSize = 0;
+        std::pair<uint64_t, uint64_t> mdHash{0, 0};
+        // Bytes held for the metadata, counted in the agent, and use for dropping
+        // the least recently used
+        size_t                                  mdBytes = 0;
+        const std::shared_ptr<nixlSectionUsage> usage = std::make_shared<nixlSectionUsage>();
+
+        inline void touch() { usage->touch(); }
+        inline bool inUse() const { return usage->users.load(std::memory_order_acquire) > 0; }
+
+        // Unloads the metadata of the removed entries once no handle uses the section
+        void reapRemoved ();
+
+        nixlRemoteSection (const std::string &agent_name, const bool lazy_load = false);
+
+        // Loads the metadata of up to max_count pending entries, ranges are left
+        // for their first use. Returns true when there is nothing more it can load.
+        bool resolvePending (const size_t max_count);
+        size_t pendingCount () const;
+        size_t heldBytes () const;
 
         nixl_status_t loadRemoteData (nixlSerDes* deserializer,
                                       backend_map_t &backendToEngineMap);
 
+        // Applies the removals and then the additions of a delta from serializeDelta
+        nixl_status_t loadRemoteDelta (nixlSerDes* deserializer,
+                                       backend_map_t &backendToEngineMap);
+
         // When adding self as a remote agent for local operations
         nixl_status_t loadLocalData (const nixl_sec_dlist_t& mem_elms,
                                      nixlBackendEngine* backend);
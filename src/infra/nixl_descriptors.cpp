@@ -18,6 +18,8 @@
 #include <iostream>
 #include <functional>
 #include <stdexcept>
+#include <limits>
+#include <cstring>
 #include "nixl.h"
 #include "nixl_descriptors.h"
 #include "mem_section.h"
@@ -145,6 +147,11 @@ void nixlBlobDesc::print(const std::string &suffix) const {
 // The template is used to select from nixlBasicDesc/nixlMetaDesc/nixlBlobDesc
 // There are no virtual functions, so the object is all data, no pointers.
 
+namespace {
+inline const nixl_blob_t& descMeta(const nixlBlobDesc &desc) { return desc.metaInfo; }
+inline const nixl_blob_t& descMeta(const nixlSectionDesc &desc) { return desc.metaBlob; }
+};
+
 template <class T>
 nixlDescList<T>::nixlDescList (const nixl_mem_t &type,
                                const bool &sorted,
@@ -181,16 +188,42 @@ nixlDescList<T>::nixlDescList(nixlSerDes* deserializer) {
         // Contiguous in memory, so no need for per elm deserialization
         if (str!="nixlBDList")
             return;
-        str = deserializer->getStr("");
-        if (str.size()!= n_desc * sizeof(nixlBasicDesc))
+        std::string_view elms = deserializer->getStrView("");
+        if (elms.size()!= n_desc * sizeof(nixlBasicDesc))
             return;
         // If size is proper, deserializer cannot fail
         descs.resize(n_desc);
-        str.copy(reinterpret_cast<char*>(descs.data()), str.size());
+        elms.copy(reinterpret_cast<char*>(descs.data()), elms.size());
 
-    } else if (std::is_same<nixlBlobDesc, T>::value) {
+    } else if constexpr (std::is_same<nixlBlobDesc, T>::value) {
         if (str!="nixlSDList")
             return;
+        if ((n_desc > 0) && (deserializer->getFormat() == nixlSerDes::BINARY)) {
+            // Packed arrays of the basic descs and meta info lengths, then all
+            // the meta info, read in place.
+            std::string_view elms  = deserializer->getStrView("");
+            std::string_view lens  = deserializer->getStrView("");
+            std::string_view metas = deserializer->getStrView("");
+            if ((elms.size() != n_desc * sizeof(nixlBasicDesc)) ||
+                (lens.size() != n_desc * sizeof(uint32_t)))
+                return;
+
+            size_t offset = 0;
+            descs.resize(n_desc);
+            for (size_t i=0; i<n_desc; ++i) {
+                uint32_t meta_len;
+                memcpy(static_cast<nixlBasicDesc*>(&descs[i]),
+                       elms.data() + i * sizeof(nixlBasicDesc), sizeof(nixlBasicDesc));
+                memcpy(&meta_len, lens.data() + i * sizeof(uint32_t), sizeof(uint32_t));
+                if (metas.size() - offset < meta_len) {
+                    descs.clear();
+                    return;
+                }
+                descs[i].metaInfo.assign(metas.data() + offset, meta_len);
+                offset += meta_len;
+            }
+            return;
+        }
         for (size_t i=0; i<n_desc; ++i) {
             str = deserializer->getStr("");
             // If size is proper, deserializer cannot fail
@@ -393,15 +426,43 @@ nixl_status_t nixlDescList<T>::serialize(nixlSerDes* serializer) const {
     // Optimization for nixlBasicDesc,
     // contiguous in memory, so no need for per elm serialization
     if (std::is_same<nixlBasicDesc, T>::value) {
-        ret = serializer->addStr("", std::string(
-                                 reinterpret_cast<const char*>(descs.data()),
-                                 n_desc * sizeof(nixlBasicDesc)));
+        ret = serializer->addBuf("", descs.data(), n_desc * sizeof(nixlBasicDesc));
         if (ret) return ret;
-    } else { // already checked it can be only nixlBlobDesc or nixlSectionDesc
-        for (auto & elm : descs) {
-            ret = serializer->addStr("", elm.serialize());
-            if (ret) return ret;
+    } else if constexpr (std::is_same<nixlBlobDesc, T>::value ||
+                         std::is_same<nixlSectionDesc, T>::value) {
+        if (serializer->getFormat() == nixlSerDes::TAGGED_STR) {
+            for (auto & elm : descs) {
+                ret = serializer->addStr("", elm.serialize());
+                if (ret) return ret;
+            }
+            return NIXL_SUCCESS;
+        }
+
+        // Packed arrays instead of a field per descriptor
+        std::vector<nixlBasicDesc> elms(n_desc);
+        std::vector<uint32_t> lens(n_desc);
+        nixl_blob_t metas;
+        size_t total_len = 0;
+
+        for (auto & elm : descs)
+            total_len += descMeta(elm).size();
+        metas.reserve(total_len);
+
+        for (size_t i=0; i<n_desc; ++i) {
+            const nixl_blob_t &meta = descMeta(descs[i]);
+            if (meta.size() > std::numeric_limits<uint32_t>::max())
+                return NIXL_ERR_INVALID_PARAM;
+            elms[i] = descs[i];
+            lens[i] = meta.size();
+            metas.append(meta);
         }
+
+        ret = serializer->addBuf("", elms.data(), n_desc * sizeof(nixlBasicDesc));
+        if (ret) return ret;
+        ret = serializer->addBuf("", lens.data(), n_desc * sizeof(uint32_t));
+        if (ret) return ret;
+        ret = serializer->addStr("", metas);
+        if (ret) return ret;
     }
 
     return NIXL_SUCCESS;
@@ -15,7 +15,10 @@
  * limitations under the License.
  */
 #include <map>
+#include <mutex>
+#include <algorithm>
 #include <iostream>
+#include <thread>
 #include "nixl.h"
 #include "nixl_descriptors.h"
 #include "mem_section.h"
@@ -23,11 +26,153 @@
 #include "nixl_types.h"
 #include "serdes/serdes.h"
 
+/*** Class nixlSectionIndex implementation ***/
+
+void nixlSectionIndex::addDesc (const nixlSectionDesc &desc) {
+    descs.insert(desc);
+    bytes += sizeof(nixlSectionDesc) + desc.metaBlob.size();
+    if (desc.pending)
+        pending++;
+}
+
+bool nixlSectionIndex::remDesc (const nixlBasicDesc &desc) {
+    const nixlSectionDesc* entry = descs.find(desc);
+    if (!entry)
+        return false;
+    if (entry->pending)
+        pending--;
+    bytes -= sizeof(nixlSectionDesc) + entry->metaBlob.size();
+    descs.erase(desc, entry);
+    return true;
+}
+
+const nixlSectionDesc* nixlSectionIndex::find (const nixlBasicDesc &query) const {
+    return descs.find(query);
+}
+
+const nixlSectionDesc* nixlSectionIndex::cover (const nixlBasicDesc &query) const {
+    return descs.cover(query);
+}
+
+void nixlSectionIndex::setMetadata (const nixlSectionDesc* desc,
+                                    nixlBackendMD* metadata) {
+    nixlSectionDesc* entry = const_cast<nixlSectionDesc*>(desc);
+    entry->metadataP = metadata;
+    entry->pending   = false;
+    pending--;
+}
+
+void nixlSectionIndex::addRange (const nixlSectionRange &range) {
+    ranges.insert(range_entry_t(range.span(), range));
+    bytes += sizeof(range_entry_t) + range.metaBlob.size();
+}
+
+// Spans of interleaved ranges can cover the query with only one of their blocks
+const nixlSectionIndex::range_entry_t*
+nixlSectionIndex::findRange (const nixlBasicDesc &query, size_t &idx) const {
+    return ranges.findCover(query, [&](const range_entry_t &entry) {
+        idx = entry.second.find(query);
+        return idx < entry.second.count;
+    });
+}
+
+const nixlSectionRange* nixlSectionIndex::coverRange (const nixlBasicDesc &query,
+                                                      size_t &idx) const {
+    const range_entry_t* entry = findRange(query, idx);
+    return entry ? &entry->second : nullptr;
+}
+
+bool nixlSectionIndex::remRangeBlock (const nixlBasicDesc &block) {
+    size_t idx;
+    const range_entry_t* entry = findRange(block, idx);
+    if (!entry || (entry->second.block(idx) != block))
+        return false;
+
+    nixlSectionRange head = entry->second, tail = entry->second;
+    bytes -= sizeof(range_entry_t) + entry->second.metaBlob.size();
+    ranges.erase(entry->first, entry);
+
+    head.count = idx;
+    tail.first = tail.block(idx + 1);
+    tail.count = tail.count - idx - 1;
+    if (head.count > 0)
+        addRange(head);
+    if (tail.count > 0)
+        addRange(tail);
+    return true;
+}
+
+nixl_status_t nixlSectionIndex::serialize (nixlSerDes* serializer) const {
+    nixl_status_t ret;
+    // Already in order, each addDesc on the sorted list appends at the end
+    nixl_sec_dlist_t dlist(type, true);
+    std::vector<nixlSectionRange> runs;
+
+    auto sameBlock = [](const nixlSectionDesc &a, const nixlSectionDesc &b) {
+        return (a.devId == b.devId) && (a.len == b.len) && (a.metaBlob == b.metaBlob);
+    };
+
+    auto itr = descs.begin();
+    while (itr != descs.end()) {
+        // Longest run from itr, the stride is set by its first two blocks
+        auto next = std::next(itr);
+        size_t count = 1;
+        size_t stride = 0;
+        if ((next != descs.end()) && sameBlock(*itr, *next) &&
+            (next->addr > itr->addr) && (next->addr - itr->addr >= itr->len)) {
+            stride = next->addr - itr->addr;
+            auto prev = itr;
+            while ((next != descs.end()) && sameBlock(*prev, *next) &&
+                   (next->addr - prev->addr == stride)) {
+                prev = next++;
+                ++count;
+            }
+        }
+
+        if (count >= NIXL_SEC_RANGE_MIN) {
+            nixlSectionRange run;
+            run.first    = *itr;
+            run.stride   = stride;
+            run.count    = count;
+            run.metaBlob = itr->metaBlob;
+            runs.push_back(std::move(run));
+        } else {
+            for (; itr != next; ++itr)
+                dlist.addDesc(*itr);
+        }
+        itr = next;
+    }
+
+    ret = dlist.serialize(serializer);
+    if (ret || runs.empty())
+        return ret;
+
+    size_t range_count = runs.size();
+    ret = serializer->addBuf("nixlSecRng", &range_count, sizeof(range_count));
+    if (ret) return ret;
+
+    for (auto & run : runs) {
+        uint64_t rec[5] = {run.first.addr, run.first.len, run.first.devId,
+                           run.stride, run.count};
+        ret = serializer->addBuf("r", rec, sizeof(rec));
+        if (ret) return ret;
+        ret = serializer->addStr("m", run.metaBlob);
+        if (ret) return ret;
+    }
+    return NIXL_SUCCESS;
+}
+
 /*** Class nixlMemSection implementation ***/
 
 // It's pure virtual, but base also class needs a destructor due to its members.
 nixlMemSection::~nixlMemSection () {}
 
+nixl_status_t nixlMemSection::resolveEntry (nixlSectionIndex* index,
+                                            nixlBackendEngine* backend,
+                                            const nixlBasicDesc &query) const {
+    return NIXL_ERR_NOT_FOUND; // Only remote sections load entries on first use
+}
+
 backend_set_t* nixlMemSection::queryBackends (const nixl_mem_t &mem) {
     if (mem<DRAM_SEG || mem>FILE_SEG)
         return nullptr;
@@ -51,101 +196,75 @@ nixl_status_t nixlMemSection::populate (const nixl_xfer_dlist_t &query,
         return NIXL_ERR_NOT_FOUND;
 
     nixlBasicDesc *p;
-    nixl_sec_dlist_t* base = it->second;
+    nixlSectionIndex* base = it->second;
     resp.resize(query.descCount());
 
-    if (!base->isSorted()) {
-        int count = 0;
-        for (int i=0; i<query.descCount(); ++i)
-            for (const auto & elm : *base)
-                if (elm.covers(query[i])){
-                    p = &resp[i];
-                    *p = query[i];
-                    resp[i].metadataP = elm.metadataP;
-                    count++;
-                    break;
-                }
-
-        if (query.descCount()==count) {
-            return NIXL_SUCCESS;
-        } else {
+    // Ranges and pending entries are only added with the agent lock held exclusively,
+    // and once no entry is pending none gets pending again.
+    std::shared_lock<std::shared_mutex> guard(resolveLock, std::defer_lock);
+    if ((base->rangeCount() > 0) || (base->pendingCount() > 0))
+        guard.lock();
+
+    for (int i=0; i<query.descCount(); ++i) {
+        const nixlSectionDesc* s = base->cover(query[i]);
+        if ((!s || s->pending) && guard.owns_lock()) {
+            guard.unlock();
+            {
+                std::unique_lock<std::shared_mutex> resolve_guard(resolveLock);
+                // Might have been loaded meanwhile
+                s = base->cover(query[i]);
+                if (!s || s->pending)
+                    resolveEntry(base, backend, query[i]);
+            }
+            guard.lock();
+            s = base->cover(query[i]);
+        }
+        if (!s || s->pending) {
             resp.clear();
             return NIXL_ERR_UNKNOWN;
         }
-    } else {
-        const nixlBasicDesc *q;
-        bool found, q_sorted = query.isSorted();
-
-        if (q_sorted) {
-            int s_index, q_index, size;
-            const nixlSectionDesc *s;
-
-            size = base->descCount();
-            s_index = 0;
-            q_index = 0;
-
-            while (q_index<query.descCount()){
-                s = &(*base)[s_index];
-                q = &query[q_index];
-                if (s->covers(*q)) {
-                    p = &resp[q_index];
-                    *p = *q;
-                    resp[q_index].metadataP = s->metadataP;
-                    q_index++;
-                } else {
-                    s_index++;
-                    // TODO: add early termination if already (*q < *s),
-                    // but s was not properly covering q
-                    if (s_index==size) {
-                        resp.clear();
-                        return NIXL_ERR_UNKNOWN;
-                    }
-                }
-            }
+        p = &resp[i];
+        *p = query[i];
+        resp[i].metadataP = s->metadataP;
+    }
+    return NIXL_SUCCESS;
+}
 
-            // To be added only in debug mode
-            // resp.verifySorted();
-            return NIXL_SUCCESS;
+/*** Class nixlLocalSection implementation ***/
 
-        } else {
-            int last_found = 0;
-            for (int i=0; i<query.descCount(); ++i) {
-                found = false;
-                q = &query[i];
-                auto itr = std::lower_bound(base->begin() + last_found,
-                                            base->end(), *q);
-
-                // Same start address case
-                if (itr != base->end()){
-                    if (itr->covers(*q)) {
-                        found = true;
-                    }
-                }
-
-                // query starts starts later, try previous entry
-                if ((!found) && (itr != base->begin())){
-                    itr = std::prev(itr , 1);
-                    if (itr->covers(*q)) {
-                        found = true;
-                    }
-                }
-
-                if (found) {
-                    p = &resp[i];
-                    *p = *q;
-                    resp[i].metadataP = itr->metadataP;
-                } else {
-                    resp.clear();
-                    return NIXL_ERR_UNKNOWN;
-                }
-            }
-            return NIXL_SUCCESS;
+// Registers a single desc, cleaning up after itself on error
+nixl_status_t nixlLocalSection::registerDesc (nixlBackendEngine* backend,
+                                              const nixlBlobDesc &mem,
+                                              const nixl_mem_t &nixl_mem,
+                                              nixlSectionDesc &local_sec,
+                                              nixlSectionDesc &self_sec) const {
+    nixl_status_t ret;
+
+    ret = backend->registerMem(mem, nixl_mem, local_sec.metadataP);
+    if (ret != NIXL_SUCCESS)
+        return ret;
+
+    if (backend->supportsLocal()) {
+        ret = backend->loadLocalMD(local_sec.metadataP, self_sec.metadataP);
+        if (ret != NIXL_SUCCESS) {
+            backend->deregisterMem(local_sec.metadataP);
+            return ret;
         }
     }
+    if (backend->supportsRemote()) {
+        ret = backend->getPublicData(local_sec.metadataP, local_sec.metaBlob);
+        if (ret != NIXL_SUCCESS) {
+            // A backend might use the same object for both initiator/target
+            // side of a transfer, so no need for unloadMD in that case.
+            if (backend->supportsLocal() && self_sec.metadataP != local_sec.metadataP)
+                backend->unloadMD(self_sec.metadataP);
+            backend->deregisterMem(local_sec.metadataP);
+            return ret;
+        }
+    }
+    return NIXL_SUCCESS;
 }
 
-/*** Class nixlLocalSection implementation ***/
-
 // Calls into backend engine to register the memories in the desc list
 nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
                                              nixlBackendEngine* backend,
@@ -156,46 +275,71 @@ nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
     // Find the MetaDesc list, or add it to the map
     nixl_mem_t     nixl_mem     = mem_elms.getType();
     section_key_t  sec_key      = std::make_pair(nixl_mem, backend);
+    const int      count        = mem_elms.descCount();
+
+    // Registered first, and only then added to the section, so the backend
+    // calls can be spread over threads if the backend allows
+    std::vector<nixlSectionDesc> local_secs(count), self_secs(count);
+    std::vector<nixl_status_t>   rets(count, NIXL_ERR_BACKEND);
+    std::atomic<int>             next(0);
+    std::atomic<bool>            failed(false);
+
+    auto reg_worker = [&]() {
+        int i;
+        while (!failed && (i = next++) < count) {
+            // TODO: For now trusting the user, but there can be a more checks mode
+            //       where we find overlaps and split the memories or warn the user
+            rets[i] = registerDesc(backend, mem_elms[i], nixl_mem,
+                                   local_secs[i], self_secs[i]);
+            if (rets[i] != NIXL_SUCCESS)
+                failed = true;
+        }
+    };
+
+    size_t thread_count = 1;
+    if (backend->supportsConcurrentReg())
+        thread_count = std::min((size_t) count, (size_t) regThreads);
+
+    if (thread_count > 1) {
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < thread_count; ++t)
+            workers.emplace_back(reg_worker);
+        reg_worker();
+        for (auto &w : workers)
+            w.join();
+    } else {
+        reg_worker();
+    }
+
+    // Abort in case of error, the failed ones have cleaned up already
+    if (failed) {
+        nixl_status_t ret = NIXL_ERR_BACKEND;
+        for (int i = 0; i < count; ++i) {
+            if (rets[i] != NIXL_SUCCESS) {
+                if (i < next)
+                    ret = rets[i];
+                continue;
+            }
+            if (backend->supportsLocal() &&
+                self_secs[i].metadataP != local_secs[i].metadataP)
+                backend->unloadMD(self_secs[i].metadataP);
+            backend->deregisterMem(local_secs[i].metadataP);
+        }
+        remote_self.clear();
+        return ret;
+    }
 
     auto it = sectionMap.find(sec_key);
     if (it==sectionMap.end()) { // New desc list
-        sectionMap[sec_key] = new nixl_sec_dlist_t(nixl_mem, true);
+        sectionMap[sec_key] = new nixlSectionIndex(nixl_mem);
         memToBackend[nixl_mem].insert(backend);
     }
-    nixl_sec_dlist_t *target = sectionMap[sec_key];
+    nixlSectionIndex *target = sectionMap[sec_key];
 
     // Add entries to the target list
-    nixlSectionDesc local_sec, self_sec;
-    nixlBasicDesc *lp = &local_sec;
-    nixlBasicDesc *rp = &self_sec;
-    nixl_status_t ret;
-
-    int i;
-    for (i = 0; i < mem_elms.descCount(); ++i) {
-        // TODO: For now trusting the user, but there can be a more checks mode
-        //       where we find overlaps and split the memories or warn the user
-        ret = backend->registerMem(mem_elms[i], nixl_mem, local_sec.metadataP);
-        if (ret != NIXL_SUCCESS)
-            break;
-
-        if (backend->supportsLocal()) {
-            ret = backend->loadLocalMD(local_sec.metadataP, self_sec.metadataP);
-            if (ret != NIXL_SUCCESS) {
-                backend->deregisterMem(local_sec.metadataP);
-                break;
-            }
-        }
-        if (backend->supportsRemote()) {
-            ret = backend->getPublicData(local_sec.metadataP, local_sec.metaBlob);
-            if (ret != NIXL_SUCCESS) {
-                // A backend might use the same object for both initiator/target
-                // side of a transfer, so no need for unloadMD in that case.
-                if (backend->supportsLocal() && self_sec.metadataP != local_sec.metadataP)
-                    backend->unloadMD(self_sec.metadataP);
-                backend->deregisterMem(local_sec.metadataP);
-                break;
-            }
-        }
+    for (int i = 0; i < count; ++i) {
+        nixlSectionDesc &local_sec = local_secs[i];
+        nixlBasicDesc   *lp        = &local_sec;
 
         *lp = mem_elms[i]; // Copy the basic desc part
         if (((nixl_mem == BLK_SEG) || (nixl_mem == OBJ_SEG) ||
@@ -205,28 +349,15 @@ nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
         target->addDesc(local_sec);
 
         if (backend->supportsLocal()) {
+            nixlBasicDesc *rp = &self_secs[i];
             *rp = *lp;
-            remote_self.addDesc(self_sec);
+            remote_self.addDesc(self_secs[i]);
         }
     }
 
-    // Abort in case of error
-    if (ret != NIXL_SUCCESS) {
-        for (int j = 0; j < i; ++j) {
-            int index = target->getIndex(mem_elms[j]);
-
-            if (backend->supportsLocal()) {
-                int self_index = remote_self.getIndex(mem_elms[j]);
-                // Should never be negative, as we just added it in previous loop
-                if (self_index >= 0 && remote_self[self_index].metadataP != (*target)[index].metadataP)
-                    backend->unloadMD(remote_self[self_index].metadataP);
-            }
-            backend->deregisterMem((*target)[index].metadataP);
-            target->remDesc(index);
-        }
-        remote_self.clear();
-    }
-    return ret;
+    if (backend->supportsRemote())
+        logChanges(mem_elms, sec_key, true);
+    return NIXL_SUCCESS;
 }
 
 nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
@@ -238,39 +369,71 @@ nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
     auto it = sectionMap.find(sec_key);
     if (it==sectionMap.end())
         return NIXL_ERR_NOT_FOUND;
-    nixl_sec_dlist_t *target = it->second;
+    nixlSectionIndex *target = it->second;
 
     // First check if the mem_elms are present in the list,
     // don't deregister anything in case any is missing.
-    for (auto & elm : mem_elms) {
-        int index = target->getIndex(elm);
-        if (index < 0)
+    for (auto & elm : mem_elms)
+        if (!target->find(elm))
             return NIXL_ERR_NOT_FOUND;
-    }
 
     for (auto & elm : mem_elms) {
-        int index = target->getIndex(elm);
         // Already checked, elm should always be found. Can add a check in debug mode.
-        backend->deregisterMem((*target)[index].metadataP);
-        target->remDesc(index);
+        backend->deregisterMem(target->find(elm)->metadataP);
+        target->remDesc(elm);
     }
 
-    if (target->descCount()==0) {
+    if (target->isEmpty()) {
         delete target;
         sectionMap.erase(sec_key);
         memToBackend[nixl_mem].erase(backend);
     }
 
+    if (backend->supportsRemote())
+        logChanges(mem_elms, sec_key, false);
+
     return NIXL_SUCCESS;
 }
 
+void nixlLocalSection::logChanges (const nixl_reg_dlist_t &mem_elms,
+                                   const section_key_t &sec_key,
+                                   const bool added) {
+    nixl_mem_t nixl_mem = sec_key.first;
+    nixlMDChange change;
+
+    change.gen    = ++mdGen;
+    change.added  = added;
+    change.secKey = sec_key;
+    for (auto & elm : mem_elms) {
+        change.desc = elm;
+        // Same as the registered entry in addDescList
+        if (added && ((nixl_mem == BLK_SEG) || (nixl_mem == OBJ_SEG) ||
+                      (nixl_mem == FILE_SEG)) && (change.desc.len == 0))
+            change.desc.len = SIZE_MAX;
+        mdLog.push_back(change);
+    }
+
+    // Deltas from before the dropped changes need the full metadata
+    while (mdLog.size() > NIXL_MD_LOG_SIZE) {
+        mdLogBase = mdLog.front().gen;
+        mdLog.pop_front();
+    }
+}
+
+void nixlLocalSection::resetLog () {
+    mdLogBase = ++mdGen;
+    mdLog.clear();
+}
+
 namespace {
+template <class sec_list_t>
 nixl_status_t serializeSections(nixlSerDes* serializer,
-                                const section_map_t &sections) {
+                                const std::map<section_key_t, sec_list_t*> &sections,
+                                const std::string &tag = "nixlSecElms") {
     nixl_status_t ret;
 
     size_t seg_count = sections.size();
-    ret = serializer->addBuf("nixlSecElms", &seg_count, sizeof(seg_count));
+    ret = serializer->addBuf(tag, &seg_count, sizeof(seg_count));
     if (ret) return ret;
 
     for (const auto &[sec_key, dlist] : sections) {
@@ -297,7 +460,7 @@ nixl_status_t nixlLocalSection::serializePartial(nixlSerDes* serializer,
                                                  const nixl_reg_dlist_t &mem_elms) const {
     nixl_mem_t nixl_mem = mem_elms.getType();
     nixl_status_t ret = NIXL_SUCCESS;
-    section_map_t mem_elms_to_serialize;
+    std::map<section_key_t, nixl_sec_dlist_t*> mem_elms_to_serialize;
 
     // If there are no descriptors to serialize, just serialize empty list of sections
     if (mem_elms.descCount() == 0)
@@ -312,15 +475,15 @@ nixl_status_t nixlLocalSection::serializePartial(nixlSerDes* serializer,
 
         // TODO: consider section_map_t to be a map of unique_ptr or instance of nixl_meta_dlist_t.
         //       This will avoid the need to delete the nixl_sec_dlist_t instances.
-        const nixl_sec_dlist_t *base = it->second;
+        const nixlSectionIndex *base = it->second;
         nixl_sec_dlist_t *resp = new nixl_sec_dlist_t(nixl_mem, mem_elms.isSorted());
         for (const auto &desc : mem_elms) {
-            int index = base->getIndex(desc);
-            if (index < 0) {
+            const nixlSectionDesc* sec = base->find(desc);
+            if (!sec) {
                 ret = NIXL_ERR_NOT_FOUND;
                 break;
             }
-            resp->addDesc((*base)[index]);
+            resp->addDesc(*sec);
         }
         if (ret != NIXL_SUCCESS)
             break;
@@ -335,6 +498,68 @@ nixl_status_t nixlLocalSection::serializePartial(nixlSerDes* serializer,
     return ret;
 }
 
+nixl_status_t nixlLocalSection::serializeDelta(nixlSerDes* serializer,
+                                               const uint64_t since_gen) const {
+    if (since_gen > mdGen)
+        return NIXL_ERR_INVALID_PARAM;
+    if (since_gen < mdLogBase)
+        return NIXL_ERR_NOT_FOUND;
+
+    // Net change per registration since since_gen: whether the other side
+    // had it, which is when the first change is a removal, and has it now.
+    std::map<std::pair<section_key_t, nixlBasicDesc>, std::pair<bool, bool>> changes;
+    auto itr = std::upper_bound(mdLog.begin(), mdLog.end(), since_gen,
+                                [](const uint64_t gen, const nixlMDChange &change) {
+                                    return gen < change.gen;
+                                });
+    for (; itr != mdLog.end(); ++itr) {
+        auto [entry, inserted] = changes.try_emplace(std::make_pair(itr->secKey, itr->desc),
+                                                     !itr->added, itr->added);
+        if (!inserted)
+            entry->second.second = itr->added;
+    }
+
+    nixl_status_t ret = NIXL_SUCCESS;
+    std::map<section_key_t, nixl_sec_dlist_t*> removed, added;
+    for (const auto &[change, state] : changes) {
+        const auto &[sec_key, desc] = change;
+        const auto &[had, has] = state;
+
+        if (had) {
+            if (removed.count(sec_key) == 0)
+                removed[sec_key] = new nixl_sec_dlist_t(sec_key.first, true);
+            nixlSectionDesc sec;
+            static_cast<nixlBasicDesc&>(sec) = desc;
+            removed[sec_key]->addDesc(sec);
+        }
+
+        if (has) {
+            auto it = sectionMap.find(sec_key);
+            const nixlSectionDesc* sec = (it == sectionMap.end()) ?
+                                         nullptr : it->second->find(desc);
+            // Should always be found, as the last change was adding it
+            if (!sec) {
+                ret = NIXL_ERR_UNKNOWN;
+                break;
+            }
+            if (added.count(sec_key) == 0)
+                added[sec_key] = new nixl_sec_dlist_t(sec_key.first, true);
+            added[sec_key]->addDesc(*sec);
+        }
+    }
+
+    if (ret == NIXL_SUCCESS)
+        ret = serializeSections(serializer, removed, "nixlSecRems");
+    if (ret == NIXL_SUCCESS)
+        ret = serializeSections(serializer, added);
+
+    for (auto &[sec_key, m_desc] : removed)
+        delete m_desc;
+    for (auto &[sec_key, m_desc] : added)
+        delete m_desc;
+    return ret;
+}
+
 nixlLocalSection::~nixlLocalSection() {
     for (auto &[sec_key, dlist] : sectionMap) {
         nixlBackendEngine* eng = sec_key.second;
@@ -347,8 +572,10 @@ nixlLocalSection::~nixlLocalSection() {
 
 /*** Class nixlRemoteSection implementation ***/
 
-nixlRemoteSection::nixlRemoteSection (const std::string &agent_name) {
+nixlRemoteSection::nixlRemoteSection (const std::string &agent_name,
+                                      const bool lazy_load) {
     this->agentName = agent_name;
+    this->lazyLoad  = lazy_load;
 }
 
 nixl_status_t nixlRemoteSection::addDescList (
@@ -363,9 +590,9 @@ nixl_status_t nixlRemoteSection::addDescList (
     nixl_mem_t nixl_mem   = mem_elms.getType();
     section_key_t sec_key = std::make_pair(nixl_mem, backend);
     if (sectionMap.count(sec_key) == 0)
-        sectionMap[sec_key] = new nixl_sec_dlist_t(nixl_mem, true);
+        sectionMap[sec_key] = new nixlSectionIndex(nixl_mem);
     memToBackend[nixl_mem].insert(backend); // Fine to overwrite, it's a set
-    nixl_sec_dlist_t *target = sectionMap[sec_key];
+    nixlSectionIndex *target = sectionMap[sec_key];
 
 
     // Add entries to the target list.
@@ -374,18 +601,23 @@ nixl_status_t nixlRemoteSection::addDescList (
     nixl_status_t ret;
     for (int i=0; i<mem_elms.descCount(); ++i) {
         // TODO: Can add overlap checks (erroneous)
-        int idx = target->getIndex(mem_elms[i]);
-        if (idx < 0) {
-            ret = backend->loadRemoteMD(mem_elms[i], nixl_mem, agentName, out.metadataP);
-            // In case of errors, no need to remove the previous entries
-            // Agent will delete the full object.
-            if (ret<0)
-                return ret;
+        const nixlSectionDesc* prev = target->find(mem_elms[i]);
+        if (!prev) {
+            out.pending = lazyLoad;
+            out.metadataP = nullptr;
+            if (!lazyLoad) {
+                ret = backend->loadRemoteMD(mem_elms[i], nixl_mem, agentName,
+                                            out.metadataP);
+                // In case of errors, no need to remove the previous entries
+                // Agent will delete the full object.
+                if (ret<0)
+                    return ret;
+            }
             *p = mem_elms[i]; // Copy the basic desc part
             out.metaBlob = mem_elms[i].metaInfo;
             target->addDesc(out);
         } else {
-            const nixl_blob_t &prev_meta_info = (*target)[idx].metaBlob;
+            const nixl_blob_t &prev_meta_info = prev->metaBlob;
             // TODO: Support metadata updates
             if (prev_meta_info != mem_elms[i].metaInfo)
                 return NIXL_ERR_NOT_ALLOWED;
@@ -394,6 +626,170 @@ nixl_status_t nixlRemoteSection::addDescList (
     return NIXL_SUCCESS;
 }
 
+nixl_status_t nixlRemoteSection::remDescList (
+                                 const nixl_reg_dlist_t& mem_elms,
+                                 nixlBackendEngine* backend) {
+    nixl_mem_t nixl_mem   = mem_elms.getType();
+    section_key_t sec_key = std::make_pair(nixl_mem, backend);
+    auto it = sectionMap.find(sec_key);
+    if (it == sectionMap.end())
+        return NIXL_ERR_NOT_FOUND;
+    nixlSectionIndex *target = it->second;
+
+    // A missing entry means the delta doesn't match what was loaded before,
+    // agent will delete the full object.
+    for (auto & elm : mem_elms) {
+        // Blocks of a range might also have been added as a descriptor
+        const nixlSectionDesc* prev = target->find(elm);
+        bool in_range = target->remRangeBlock(elm);
+        if (!prev && !in_range)
+            return NIXL_ERR_NOT_FOUND;
+        if (prev) {
+            if (prev->pending) {
+                // Nothing loaded
+            } else if (inUse()) {
+                removedMD.emplace_back(backend, prev->metadataP);
+                usage->retired = true;
+            } else {
+                backend->unloadMD(prev->metadataP);
+            }
+            target->remDesc(elm);
+        }
+    }
+
+    if (target->isEmpty()) {
+        delete target;
+        sectionMap.erase(sec_key);
+        memToBackend[nixl_mem].erase(backend);
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlRemoteSection::addRange (const nixl_mem_t &nixl_mem,
+                                           const nixlSectionRange &range,
+                                           nixlBackendEngine* backend) {
+    if (!backend->supportsRemote())
+        return NIXL_ERR_UNKNOWN;
+
+    section_key_t sec_key = std::make_pair(nixl_mem, backend);
+    if (sectionMap.count(sec_key) == 0)
+        sectionMap[sec_key] = new nixlSectionIndex(nixl_mem);
+    memToBackend[nixl_mem].insert(backend); // Fine to overwrite, it's a set
+    nixlSectionIndex *target = sectionMap[sec_key];
+
+    // Same as addDescList, an already loaded range can't change
+    size_t idx;
+    const nixlSectionRange* prev = target->coverRange(range.first, idx);
+    if (prev && (idx == 0) && (prev->span() == range.span())) {
+        if ((prev->stride != range.stride) || (prev->metaBlob != range.metaBlob))
+            return NIXL_ERR_NOT_ALLOWED;
+        return NIXL_SUCCESS;
+    }
+
+    target->addRange(range);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlRemoteSection::resolveEntry (nixlSectionIndex* index,
+                                               nixlBackendEngine* backend,
+                                               const nixlBasicDesc &query) const {
+    nixl_status_t ret;
+    const nixlSectionDesc* entry = index->cover(query);
+    if (entry) {
+        if (!entry->pending)
+            return NIXL_SUCCESS;
+
+        nixlBackendMD* metadata = nullptr;
+        ret = backend->loadRemoteMD(nixlBlobDesc(*entry, entry->metaBlob),
+                                    index->getType(), agentName, metadata);
+        if (ret < 0)
+            return ret;
+        index->setMetadata(entry, metadata);
+        return NIXL_SUCCESS;
+    }
+
+    size_t idx;
+    const nixlSectionRange* range = index->coverRange(query, idx);
+    if (!range)
+        return NIXL_ERR_NOT_FOUND;
+
+    nixlSectionDesc out;
+    nixlBasicDesc *p = &out;
+    *p = range->block(idx);
+    ret = backend->loadRemoteMD(nixlBlobDesc(*p, range->metaBlob),
+                                              index->getType(), agentName,
+                                              out.metadataP);
+    if (ret < 0)
+        return ret;
+    out.metaBlob = range->metaBlob;
+    index->addDesc(out);
+    return NIXL_SUCCESS;
+}
+
+bool nixlRemoteSection::resolvePending (const size_t max_count) {
+    std::unique_lock<std::shared_mutex> guard(resolveLock);
+    size_t count = 0;
+
+    for (auto &[sec_key, index] : sectionMap) {
+        if (index->pendingCount() == 0)
+            continue;
+        for (auto & elm : *index) {
+            if (!elm.pending)
+                continue;
+            if (count == max_count)
+                return false;
+            // On errors the entries stay pending, and populate reports them on use.
+            // The others are still loaded, failed ones are tried again in later batches.
+            nixlBackendMD* metadata = nullptr;
+            if (sec_key.second->loadRemoteMD(nixlBlobDesc(elm, elm.metaBlob), sec_key.first,
+                                             agentName, metadata) < 0)
+                continue;
+            index->setMetadata(&elm, metadata);
+            count++;
+        }
+    }
+    return true;
+}
+
+size_t nixlRemoteSection::pendingCount () const {
+    size_t count = 0;
+    for (auto &[sec_key, index] : sectionMap)
+        count += index->pendingCount();
+    return count;
+}
+
+size_t nixlRemoteSection::heldBytes () const {
+    size_t count = 0;
+    for (auto &[sec_key, index] : sectionMap)
+        count += index->heldBytes();
+    return count;
+}
+
+nixl_status_t nixlRemoteSection::loadRemoteDelta (nixlSerDes* deserializer,
+                                                  backend_map_t &backendToEngineMap) {
+    nixl_status_t ret;
+    size_t seg_count;
+    nixl_backend_t nixl_backend;
+
+    ret = deserializer->getBuf("nixlSecRems", &seg_count, sizeof(seg_count));
+    if (ret) return ret;
+
+    for (size_t i=0; i<seg_count; ++i) {
+        nixl_backend = deserializer->getStr("bknd");
+        if (nixl_backend.size()==0)
+            return NIXL_ERR_INVALID_PARAM;
+        nixl_reg_dlist_t s_desc(deserializer);
+        if (s_desc.descCount()==0)
+            return NIXL_ERR_NOT_FOUND;
+        if (backendToEngineMap.count(nixl_backend) != 0) {
+            ret = remDescList(s_desc, backendToEngineMap[nixl_backend]);
+            if (ret) return ret;
+        }
+    }
+
+    return loadRemoteData(deserializer, backendToEngineMap);
+}
+
 nixl_status_t nixlRemoteSection::loadRemoteData (nixlSerDes* deserializer,
                                                  backend_map_t &backendToEngineMap) {
     nixl_status_t ret;
@@ -410,11 +806,42 @@ nixl_status_t nixlRemoteSection::loadRemoteData (nixlSerDes* deserializer,
         if (nixl_backend.size()==0)
             return NIXL_ERR_INVALID_PARAM;
         nixl_reg_dlist_t s_desc(deserializer);
-        if (s_desc.descCount()==0) // can be used for entry removal in future
+
+        // Optional range records after the list
+        std::vector<nixlSectionRange> s_ranges;
+        if (deserializer->getBufLen("nixlSecRng") == sizeof(size_t)) {
+            size_t range_count;
+            ret = deserializer->getBuf("nixlSecRng", &range_count, sizeof(range_count));
+            if (ret) return ret;
+            s_ranges.resize(range_count);
+            for (auto & range : s_ranges) {
+                uint64_t rec[5];
+                ret = deserializer->getBuf("r", rec, sizeof(rec));
+                if (ret) return ret;
+                if (deserializer->getBufLen("m") < 0)
+                    return NIXL_ERR_MISMATCH;
+                range.first    = nixlBasicDesc(rec[0], rec[1], rec[2]);
+                range.stride   = rec[3];
+                range.count    = rec[4];
+                range.metaBlob = deserializer->getStr("m");
+                if ((range.count == 0) || (range.stride < range.first.len) ||
+                    (range.stride == 0))
+                    return NIXL_ERR_INVALID_PARAM;
+            }
+        }
+
+        if (s_desc.descCount()==0 && s_ranges.empty()) // can be used for entry removal in future
             return NIXL_ERR_NOT_FOUND;
         if (backendToEngineMap.count(nixl_backend) != 0) {
-            ret = addDescList(s_desc, backendToEngineMap[nixl_backend]);
-            if (ret) return ret;
+            nixlBackendEngine* eng = backendToEngineMap[nixl_backend];
+            if (s_desc.descCount() > 0) {
+                ret = addDescList(s_desc, eng);
+                if (ret) return ret;
+            }
+            for (auto & range : s_ranges) {
+                ret = addRange(s_desc.getType(), range, eng);
+                if (ret) return ret;
+            }
         }
     }
     return NIXL_SUCCESS;
@@ -431,9 +858,9 @@ nixl_status_t nixlRemoteSection::loadLocalData (
     section_key_t sec_key = std::make_pair(nixl_mem, backend);
 
     if (sectionMap.count(sec_key) == 0)
-        sectionMap[sec_key] = new nixl_sec_dlist_t(nixl_mem, true);
+        sectionMap[sec_key] = new nixlSectionIndex(nixl_mem);
     memToBackend[nixl_mem].insert(backend); // Fine to overwrite, it's a set
-    nixl_sec_dlist_t *target = sectionMap[sec_key];
+    nixlSectionIndex *target = sectionMap[sec_key];
 
     for (auto & elm: mem_elms)
         target->addDesc(elm);
@@ -441,11 +868,23 @@ nixl_status_t nixlRemoteSection::loadLocalData (
     return NIXL_SUCCESS;
 }
 
+void nixlRemoteSection::reapRemoved() {
+    if (removedMD.empty() || inUse())
+        return;
+    for (auto &[eng, metadata] : removedMD)
+        eng->unloadMD(metadata);
+    removedMD.clear();
+    usage->retired = false;
+}
+
 nixlRemoteSection::~nixlRemoteSection() {
+    for (auto &[eng, metadata] : removedMD)
+        eng->unloadMD(metadata);
     for (auto &[sec_key, dlist] : sectionMap) {
         nixlBackendEngine* eng = sec_key.second;
         for (auto & elm : *dlist)
-            eng->unloadMD(elm.metadataP);
+            if (!elm.pending)
+                eng->unloadMD(elm.metadataP);
         delete dlist;
     }
     // nixlMemSection destructor will clean up the rest
@@ -17,6 +17,12 @@
 #include "ucx_backend.h"
 #include "serdes/serdes.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
 #ifdef HAVE_CUDA
 
 #include <cuda_runtime.h>
@@ -194,26 +200,38 @@ void nixlUcxEngine::vramFiniCtx()
 *****************************************/
 
 
-class nixlUcxIntReq : public nixlLinkElem<nixlUcxIntReq> {
-    private:
-        int _completed;
+/* Header and payload of a notification, which UCX reads until the send
+   completes. Returned to the pool of the engine along with the request. */
+class nixlUcxAmBuffer {
     public:
-        std::string *amBuffer;
+        struct nixl_ucx_am_hdr hdr;
+        nixlSerDes ser;
+        nixlObjPool<nixlUcxAmBuffer> *pool;
+
+        nixlUcxAmBuffer(nixlObjPool<nixlUcxAmBuffer> *_pool) : pool(_pool) { }
+};
 
-        nixlUcxIntReq() : nixlLinkElem() {
-            _completed = 0;
+/* Requests that are tested and released by the caller, e.g. of genNotif,
+   keep the buffer of a notification until UCX reuses them. Transfers use
+   completion callbacks instead, see nixlUcxBackendH. */
+class nixlUcxIntReq {
+    public:
+        nixlUcxAmBuffer *amBuffer;
+
+        nixlUcxIntReq() {
             amBuffer = NULL;
         }
 
         ~nixlUcxIntReq() {
-            _completed = 0;
+            putAmBuffer();
+        }
+
+        void putAmBuffer() {
             if (amBuffer) {
-                delete amBuffer;
+                amBuffer->pool->put(amBuffer);
+                amBuffer = NULL;
             }
         }
-
-        bool is_complete() { return _completed; }
-        void completed() { _completed = 1; }
 };
 
 static void _internalRequestInit(void *request)
@@ -229,103 +247,138 @@ static void _internalRequestFini(void *request)
     req->~nixlUcxIntReq();
 }
 
-
-static void _internalRequestReset(nixlUcxIntReq *req) {
-    _internalRequestFini((void *)req);
-    _internalRequestInit((void *)req);
-}
-
 /****************************************
  * Backend request management
 *****************************************/
 
+/* Operations of a transfer are counted instead of tracked one by one. Those
+   that don't complete immediately report to completionCb, so checking a
+   transfer doesn't depend on its number of descs. Their requests are kept
+   until the next post or the release, to be cancelled by an early release. */
 class nixlUcxBackendH : public nixlBackendReqH {
 private:
-    nixlUcxIntReq head;
-    nixlUcxWorker* uw;
+    /* Worker the transfer is posted on, whose pool the handle came from */
+    nixlUcxEngineWorker *worker;
+
+    /* One reference held by the user until releaseReqH, and one per
+       outstanding operation. The last one returns the handle to the pool. */
+    std::atomic<uint64_t> refs;
+    /* First error reported by a completion */
+    std::atomic<nixl_status_t> err;
+    /* Notification of the transfer, read by UCX until its send completes */
+    nixlUcxAmBuffer *notifBuf;
+    /* Requests of the operations that didn't complete immediately */
+    std::vector<nixlUcxReq> reqs;
+
+    void put() {
+        if (--refs == 0) {
+            reset();
+            worker->reqHPool.put(this);
+        }
+    }
 
 public:
+    /* Completion callback, set while watched by the progress thread */
+    nixl_xfer_cb_t cb;
+    void *cbArg;
+    bool watched;
+
+    /* Completion semantics from prepXfer, and the endpoints a post flushes */
+    nixl_xfer_compl_t completion;
+    std::vector<nixlUcxEp*> flushEps;
+
+    nixlUcxBackendH(nixlUcxEngineWorker *_worker){
+        worker = _worker;
+        notifBuf = nullptr;
+        reset();
+    }
 
-    nixlUcxBackendH(nixlUcxWorker* _uw){
-        uw = _uw;
+    /* Handles are reused from the pool of the engine */
+    void reset() {
+        refs = 1;
+        clear();
+        cb = nullptr;
+        cbArg = nullptr;
+        watched = false;
+        completion = nixl_xfer_compl_t::NIXL_XFER_COMPL_DEFAULT;
     }
 
-    void append(nixlUcxIntReq *req) {
-        head.link(req);
+    /* Called before a (re)post, when no operation is outstanding */
+    void clear() {
+        err = NIXL_SUCCESS;
+        flushEps.clear();
+        for (nixlUcxReq req : reqs) {
+            worker->uw.reqRelease(req);
+        }
+        reqs.clear();
+        if (notifBuf) {
+            notifBuf->pool->put(notifBuf);
+            notifBuf = nullptr;
+        }
     }
 
-    nixl_status_t release()
-    {
-        nixlUcxIntReq *req = head.next();
+    nixlUcxEngineWorker &getWorker() const {
+        return *worker;
+    }
 
-        if (!req) {
-            return NIXL_SUCCESS;
-        }
+    void setNotifBuf(nixlUcxAmBuffer *buf) {
+        notifBuf = buf;
+    }
 
-        // TODO: Error log: uncompleted requests found! Cancelling ...
-        while(req) {
-            nixlUcxIntReq *cur = req;
-            bool done = cur->is_complete();
-            req = cur->unlink();
-            if (!done) {
-                // TODO: Need process this properly.
-                // it may not be enough to cancel UCX request
-                uw->reqCancel((nixlUcxReq)cur);
-            }
-            _internalRequestReset(cur);
-            uw->reqRelease((nixlUcxReq)cur);
-        }
-        return NIXL_SUCCESS;
+    /* Counted before posting, as the callback can run before the post returns */
+    void addOp() {
+        refs++;
     }
 
+    /* Accounts for an operation that didn't get to completionCb */
+    nixl_status_t opPosted(nixl_status_t ret, nixlUcxReq req) {
+        switch(ret) {
+            case NIXL_IN_PROG:
+                /* Counted down by completionCb */
+                reqs.push_back(req);
+                return NIXL_SUCCESS;
+            case NIXL_SUCCESS:
+                put();
+                return NIXL_SUCCESS;
+            default:
+                // Error. The operations posted so far complete in the background
+                put();
+                return NIXL_ERR_BACKEND;
+        }
+    }
 
-    nixl_status_t status()
+    static void completionCb(void *request, ucs_status_t status, void *user_data)
     {
-        nixlUcxIntReq *req = head.next();
-        nixl_status_t out_ret = NIXL_SUCCESS;
+        nixlUcxBackendH *hndl = (nixlUcxBackendH*) user_data;
 
-        if (NULL == req) {
-            /* No pending transmissions */
-            return NIXL_SUCCESS;
+        if (status != UCS_OK) {
+            nixl_status_t expected = NIXL_SUCCESS;
+            hndl->err.compare_exchange_strong(expected, NIXL_ERR_BACKEND);
         }
+        hndl->put();
+    }
 
-        /* Go over all request updating their status */
-        while(req) {
-            nixl_status_t ret;
-            if (!req->is_complete()) {
-                ret = uw->test((nixlUcxReq)req);
-                switch (ret) {
-                    case NIXL_SUCCESS:
-                        /* Mark as completed */
-                        req->completed();
-                        break;
-                    case NIXL_IN_PROG:
-                        out_ret = NIXL_IN_PROG;
-                        break;
-                    default:
-                        /* Any other ret value is ERR and will be returned */
-                        return ret;
-                }
+    /* Outstanding operations are cancelled. Those UCX can't cancel still
+       complete, and the handle goes back to the pool after the last one. */
+    nixl_status_t release()
+    {
+        if (refs > 1) {
+            for (nixlUcxReq req : reqs) {
+                worker->uw.reqCancel(req);
             }
-            req = req->next();
         }
+        put();
+        return NIXL_SUCCESS;
+    }
 
-        /* Remove completed requests keeping the first one as
-        request representative */
-        req = head.unlink();
-        while(req) {
-            nixlUcxIntReq *next_req = req->unlink();
-            if (req->is_complete()) {
-                _internalRequestReset(req);
-                uw->reqRelease((nixlUcxReq)req);
-            } else {
-                /* Enqueue back */
-                append(req);
-            }
-            req = next_req;
+    nixl_status_t status()
+    {
+        if (refs > 1) {
+            worker->uw.progress();
+            if (refs > 1)
+                return NIXL_IN_PROG;
         }
-
-        return out_ret;
+        return err;
     }
 };
 
@@ -333,6 +386,108 @@ public:
  * Progress thread management
 *****************************************/
 
+void nixlUcxEngine::watchXfer(nixlUcxBackendH *handle)
+{
+    const std::lock_guard<std::mutex> lock(pthrWatchMtx);
+    handle->watched = true;
+    pthrWatch.push_back(handle);
+}
+
+void nixlUcxEngine::unwatchXfer(nixlUcxBackendH *handle)
+{
+    const std::lock_guard<std::mutex> lock(pthrWatchMtx);
+    if (!handle->watched) {
+        return;
+    }
+
+    handle->watched = false;
+    pthrWatch.erase(std::find(pthrWatch.begin(), pthrWatch.end(), handle));
+}
+
+bool nixlUcxEngine::watchProgress()
+{
+    size_t i = 0;
+    bool watched;
+
+    {
+        const std::lock_guard<std::mutex> lock(pthrWatchMtx);
+
+        while (i < pthrWatch.size()) {
+            nixlUcxBackendH *handle = pthrWatch[i];
+            nixl_status_t ret = handle->status();
+
+            if (ret == NIXL_IN_PROG) {
+                i++;
+                continue;
+            }
+
+            pthrWatch[i] = pthrWatch.back();
+            pthrWatch.pop_back();
+            handle->watched = false;
+            pthrDone.push_back({handle->cb, handle->cbArg, ret});
+        }
+
+        watched = !pthrWatch.empty();
+    }
+
+    /* Called without the lock, as the handle can be reposted from the callback */
+    for (auto &done : pthrDone) {
+        done.cb(done.cbArg, done.status);
+    }
+    pthrDone.clear();
+
+    return watched;
+}
+
+/* Called after posting work that the progress thread has to see through */
+void nixlUcxEngine::progressThreadWakeup(nixlUcxEngineWorker &w)
+{
+    if (!pthrEvents) {
+        return;
+    }
+
+    w.posts++;
+    if (pthrSleeping) {
+        w.uw.signal();
+    }
+}
+
+uint64_t nixlUcxEngine::progressThreadPosts() const
+{
+    uint64_t posts = 0;
+
+    for (auto &w : uws) {
+        posts += w->posts;
+    }
+    return posts;
+}
+
+/* Waits for events on any worker, unless some came or work was posted after
+   the progress round that started with the given count of posts. A post
+   either sees pthrSleeping set and signals the worker, or is counted here. */
+void nixlUcxEngine::progressThreadWait(uint64_t posts)
+{
+    struct epoll_event events[1];
+
+    pthrSleeping = true;
+
+    if (progressThreadPosts() != posts) {
+        pthrSleeping = false;
+        return;
+    }
+
+    for (auto &w : uws) {
+        if (w->uw.arm() != NIXL_SUCCESS) {
+            pthrSleeping = false;
+            return;
+        }
+    }
+
+    pthrSleeps++;
+    epoll_wait(pthrEpfd, events, 1, NIXL_UCX_PTHR_WAIT_MS);
+    pthrSleeping = false;
+}
+
 void nixlUcxEngine::progressFunc()
 {
     using namespace nixlTime;
@@ -340,12 +495,31 @@ void nixlUcxEngine::progressFunc()
 
     vramApplyCtx();
 
+    us_t idle_start = getUs();
+
     while (!pthrStop) {
+        uint64_t posts = pthrEvents ? progressThreadPosts() : 0;
+        int progressed = 0;
+        bool watched;
         int i;
         for(i = 0; i < noSyncIters; i++) {
-            uw->progress();
+            for (auto &w : uws) {
+                progressed += w->uw.progress();
+            }
         }
         notifProgress();
+        watched = watchProgress();
+
+        // Busy-poll while there is work, wait for events once idle for a while
+        if (pthrEvents) {
+            if (progressed || watched) {
+                idle_start = getUs();
+            } else if ((getUs() - idle_start) >= NIXL_UCX_PTHR_IDLE_US) {
+                progressThreadWait(posts);
+                idle_start = getUs();
+                continue;
+            }
+        }
         // TODO: once NIXL thread infrastructure is available - move it there!!!
 
         // {
@@ -392,6 +566,9 @@ void nixlUcxEngine::progressThreadStop()
     }
 
     pthrStop = 1;
+    if (pthrEvents) {
+        uws[0]->uw.signal();
+    }
     pthr.join();
 }
 
@@ -401,6 +578,29 @@ void nixlUcxEngine::progressThreadRestart()
     progressThreadStart();
 }
 
+/****************************************
+ * Worker management
+*****************************************/
+
+nixlUcxEngineWorker::nixlUcxEngineWorker(nixlUcxContext *ctx, size_t _id)
+: id(_id),
+  reqHPool(NIXL_UCX_REQ_H_POOL_SIZE, true),
+  amBufPool(NIXL_UCX_AM_BUF_POOL_SIZE, true),
+  uw(ctx),
+  posts(0),
+  epFlushes(0),
+  workerFlushes(0) {
+}
+
+nixlUcxEngineWorker &nixlUcxEngine::getWorker() const
+{
+    // Threads are numbered on first use and spread round robin over the workers
+    static std::atomic<size_t> thread_cnt{0};
+    thread_local size_t thread_id = thread_cnt++;
+
+    return *uws[thread_id % uws.size()];
+}
+
 /****************************************
  * Constructor/Destructor
 *****************************************/
@@ -408,7 +608,8 @@ void nixlUcxEngine::progressThreadRestart()
 nixlUcxEngine::nixlUcxEngine (const nixlBackendInitParams* init_params)
 : nixlBackendEngine (init_params) {
     std::vector<std::string> devs; /* Empty vector */
-    uint64_t                 n_addr;
+    size_t                   num_workers = 1;
+    nixlSerDes               addrs_ser;
     nixl_b_params_t* custom_params = init_params->customParams;
 
     if (init_params->enableProgTh) {
@@ -420,16 +621,77 @@ nixlUcxEngine::nixlUcxEngine (const nixlBackendInitParams* init_params)
 
     if (custom_params->count("device_list")!=0)
         devs = str_split((*custom_params)["device_list"], ", ");
+    stripeWeight = devs.empty() ? 1 : devs.size();
 
+    if (custom_params->count("num_workers")!=0) {
+        try {
+            num_workers = std::stoul((*custom_params)["num_workers"]);
+        } catch (const std::exception &e) {
+            num_workers = 0;
+        }
+        if (num_workers == 0) {
+            this->initErr = true;
+            return;
+        }
+    }
+
+    // The progress thread waits for events once idle, unless asked to poll
+    pthrEvents = init_params->enableProgTh;
+    if (custom_params->count("progress_mode")!=0) {
+        const std::string &mode = (*custom_params)["progress_mode"];
+        if (mode == "poll") {
+            pthrEvents = false;
+        } else if (mode != "adaptive") {
+            this->initErr = true;
+            return;
+        }
+    }
+    pthrEpfd = -1;
+    pthrSleeping = false;
+    pthrSleeps = 0;
+
+    /* Workers stay multi-threaded, as the progress thread and the users of a
+       handle can run on another thread than the one the worker is bound to */
     uc = new nixlUcxContext(devs, sizeof(nixlUcxIntReq),
-                           _internalRequestInit, _internalRequestFini, NIXL_UCX_MT_WORKER);
-    uw = new nixlUcxWorker(uc);
-    uw->epAddr(n_addr, workerSize);
-    workerAddr = (void*) n_addr;
+                           _internalRequestInit, _internalRequestFini, NIXL_UCX_MT_WORKER,
+                           pthrEvents);
+
+    for (size_t i = 0; i < num_workers; i++) {
+        uint64_t n_addr;
+        size_t   addr_size;
+
+        uws.emplace_back(std::make_unique<nixlUcxEngineWorker>(uc, i));
+        nixlUcxWorker &uw = uws.back()->uw;
+
+        uw.epAddr(n_addr, addr_size);
+        addrs_ser.addBuf("worker", (void*) n_addr, addr_size);
+        free((void*) n_addr);
 
-    uw->regAmCallback(CONN_CHECK, connectionCheckAmCb, this);
-    uw->regAmCallback(DISCONNECT, connectionTermAmCb, this);
-    uw->regAmCallback(NOTIF_STR, notifAmCb, this);
+        uw.regAmCallback(CONN_CHECK, connectionCheckAmCb, this);
+        uw.regAmCallback(DISCONNECT, connectionTermAmCb, this);
+        uw.regAmCallback(NOTIF_STR, notifAmCb, this);
+    }
+    workerAddrs = addrs_ser.exportStr();
+
+    if (pthrEvents) {
+        pthrEpfd = epoll_create1(EPOLL_CLOEXEC);
+        for (auto &w : uws) {
+            struct epoll_event ev = {};
+            int fd;
+
+            ev.events = EPOLLIN;
+            if ((pthrEpfd < 0) || w->uw.getEfd(fd) ||
+                epoll_ctl(pthrEpfd, EPOLL_CTL_ADD, fd, &ev)) {
+                // Keep polling if the workers can't be waited on
+                pthrEvents = false;
+                break;
+            }
+        }
+        if (!pthrEvents && (pthrEpfd >= 0)) {
+            close(pthrEpfd);
+            pthrEpfd = -1;
+        }
+    }
 
     if (init_params->enableProgTh) {
         pthrOn = true;
@@ -467,10 +729,12 @@ nixlUcxEngine::~nixlUcxEngine () {
     }
 
     progressThreadStop();
+    if (pthrEpfd >= 0) {
+        close(pthrEpfd);
+    }
     vramFiniCtx();
-    delete uw;
+    uws.clear();
     delete uc;
-    free(workerAddr);
 }
 
 /****************************************
@@ -494,8 +758,10 @@ nixl_status_t nixlUcxEngine::endConn(const std::string &remote_agent) {
 
     nixlUcxConnection &conn = remoteConnMap[remote_agent];
 
-    if(uw->disconnect_nb(conn.ep) < 0) {
-        return NIXL_ERR_BACKEND;
+    for (size_t i = 0; i < conn.eps.size(); i++) {
+        if(uws[i]->uw.disconnect_nb(conn.eps[i]) < 0) {
+            return NIXL_ERR_BACKEND;
+        }
     }
 
     //thread safety?
@@ -505,7 +771,7 @@ nixl_status_t nixlUcxEngine::endConn(const std::string &remote_agent) {
 }
 
 nixl_status_t nixlUcxEngine::getConnInfo(std::string &str) const {
-    str = nixlSerDes::_bytesToString(workerAddr, workerSize);
+    str = workerAddrs;
     return NIXL_SUCCESS;
 }
 
@@ -577,8 +843,7 @@ nixl_status_t nixlUcxEngine::connect(const std::string &remote_agent) {
     nixlUcxReq req;
 
     if (remote_agent == localAgent)
-        return loadRemoteConnInfo (remote_agent,
-                   nixlSerDes::_bytesToString(workerAddr, workerSize));
+        return loadRemoteConnInfo (remote_agent, workerAddrs);
 
     auto search = remoteConnMap.find(remote_agent);
 
@@ -592,18 +857,23 @@ nixl_status_t nixlUcxEngine::connect(const std::string &remote_agent) {
     //agent names should never be long enough to need RNDV
     flags |= UCP_AM_SEND_FLAG_EAGER;
 
-    ret = uw->sendAm(conn.ep, CONN_CHECK,
-                     &hdr, sizeof(struct nixl_ucx_am_hdr),
-                     (void*) localAgent.data(), localAgent.size(),
-                     flags, req);
+    // Wire up the endpoints of all the workers
+    for (size_t i = 0; i < conn.eps.size(); i++) {
+        nixlUcxWorker &uw = uws[i]->uw;
 
-    if(ret < 0) {
-        return ret;
-    }
+        ret = uw.sendAm(conn.eps[i], CONN_CHECK,
+                        &hdr, sizeof(struct nixl_ucx_am_hdr),
+                        (void*) localAgent.data(), localAgent.size(),
+                        flags, req);
 
-    //wait for AM to send
-    while(ret == NIXL_IN_PROG){
-        ret = uw->test(req);
+        if(ret < 0) {
+            return ret;
+        }
+
+        //wait for AM to send
+        while(ret == NIXL_IN_PROG){
+            ret = uw.test(req);
+        }
     }
 
     return NIXL_SUCCESS;
@@ -624,19 +894,20 @@ nixl_status_t nixlUcxEngine::disconnect(const std::string &remote_agent) {
         }
 
         nixlUcxConnection &conn = remoteConnMap[remote_agent];
+        nixlUcxEngineWorker &w = getWorker();
 
         hdr.op = DISCONNECT;
         //agent names should never be long enough to need RNDV
         flags |= UCP_AM_SEND_FLAG_EAGER;
 
-        ret = uw->sendAm(conn.ep, DISCONNECT,
-                        &hdr, sizeof(struct nixl_ucx_am_hdr),
-                        (void*) localAgent.data(), localAgent.size(),
-                        flags, req);
+        ret = w.uw.sendAm(conn.eps[w.id], DISCONNECT,
+                          &hdr, sizeof(struct nixl_ucx_am_hdr),
+                          (void*) localAgent.data(), localAgent.size(),
+                          flags, req);
 
         //don't care
         if(ret == NIXL_IN_PROG){
-            uw->reqRelease(req);
+            w.uw.reqRelease(req);
         }
     }
 
@@ -648,20 +919,38 @@ nixl_status_t nixlUcxEngine::disconnect(const std::string &remote_agent) {
 nixl_status_t nixlUcxEngine::loadRemoteConnInfo (const std::string &remote_agent,
                                                  const std::string &remote_conn_info)
 {
-    size_t size = remote_conn_info.size();
     nixlUcxConnection conn;
+    nixlSerDes ser_des;
+    std::vector<std::string> addrs;
+    ssize_t size;
     int ret;
-    //TODO: eventually std::byte?
-    char* addr = new char[size];
 
     if(remoteConnMap.find(remote_agent) != remoteConnMap.end()) {
         return NIXL_ERR_INVALID_PARAM;
     }
 
-    nixlSerDes::_stringToBytes((void*) addr, remote_conn_info, size);
-    ret = uw->connect(addr, size, conn.ep);
-    if (ret) {
-        return NIXL_ERR_BACKEND;
+    if (ser_des.importStr(remote_conn_info) != NIXL_SUCCESS) {
+        return NIXL_ERR_MISMATCH;
+    }
+    while ((size = ser_des.getBufLen("worker")) > 0) {
+        addrs.push_back(ser_des.getStr("worker"));
+    }
+    if (addrs.empty()) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    // Worker i talks to worker i of the remote, wrapping around if it has fewer
+    conn.eps.resize(uws.size());
+    for (size_t i = 0; i < uws.size(); i++) {
+        std::string &addr = addrs[i % addrs.size()];
+
+        ret = uws[i]->uw.connect((void*) addr.data(), addr.size(), conn.eps[i]);
+        if (ret) {
+            for (size_t j = 0; j < i; j++) {
+                uws[j]->uw.disconnect_nb(conn.eps[j]);
+            }
+            return NIXL_ERR_BACKEND;
+        }
     }
 
     conn.remoteAgent = remote_agent;
@@ -669,8 +958,6 @@ nixl_status_t nixlUcxEngine::loadRemoteConnInfo (const std::string &remote_agent
 
     remoteConnMap[remote_agent] = conn;
 
-    delete[] addr;
-
     return NIXL_SUCCESS;
 }
 
@@ -688,6 +975,7 @@ nixl_status_t nixlUcxEngine::registerMem (const nixlBlobDesc &mem,
 
     if (nixl_mem == VRAM_SEG) {
         bool need_restart;
+        const std::lock_guard<std::mutex> guard(cudaCtxMtx);
         if (vramUpdateCtx((void*)mem.addr, mem.devId, need_restart)) {
             return NIXL_ERR_NOT_SUPPORTED;
             //TODO Add to logging
@@ -697,14 +985,19 @@ nixl_status_t nixlUcxEngine::registerMem (const nixlBlobDesc &mem,
         }
     }
 
+    // Memory is mapped on the context, so any worker can register it
     // TODO: Add nixl_mem check?
-    ret = uw->memReg((void*) mem.addr, mem.len, priv->mem);
-    if (ret) {
-        return NIXL_ERR_BACKEND;
-    }
-    ret = uw->packRkey(priv->mem, rkey_addr, rkey_size);
-    if (ret) {
-        return NIXL_ERR_BACKEND;
+    nixlUcxWorker &uw = uws[0]->uw;
+    {
+        const std::lock_guard<std::mutex> guard(regMtx);
+        ret = uw.memReg((void*) mem.addr, mem.len, priv->mem);
+        if (ret) {
+            return NIXL_ERR_BACKEND;
+        }
+        ret = uw.packRkey(priv->mem, rkey_addr, rkey_size);
+        if (ret) {
+            return NIXL_ERR_BACKEND;
+        }
     }
     priv->rkeyStr = nixlSerDes::_bytesToString((void*) rkey_addr, rkey_size);
 
@@ -717,7 +1010,10 @@ nixl_status_t nixlUcxEngine::registerMem (const nixlBlobDesc &mem,
 nixl_status_t nixlUcxEngine::deregisterMem (nixlBackendMD* meta)
 {
     nixlUcxPrivateMetadata *priv = (nixlUcxPrivateMetadata*) meta;
-    uw->memDereg(priv->mem);
+    {
+        const std::lock_guard<std::mutex> guard(regMtx);
+        uws[0]->uw.memDereg(priv->mem);
+    }
     delete priv;
     return NIXL_SUCCESS;
 }
@@ -735,9 +1031,7 @@ nixl_status_t
 nixlUcxEngine::internalMDHelper (const nixl_blob_t &blob,
                                  const std::string &agent,
                                  nixlBackendMD* &output) {
-    nixlUcxConnection conn;
-    nixlUcxPublicMetadata *md = new nixlUcxPublicMetadata;
-     size_t size = blob.size();
+    size_t size = blob.size();
 
     auto search = remoteConnMap.find(agent);
 
@@ -745,18 +1039,27 @@ nixlUcxEngine::internalMDHelper (const nixl_blob_t &blob,
         //TODO: err: remote connection not found
         return NIXL_ERR_NOT_FOUND;
     }
-    conn = (nixlUcxConnection) search->second;
+
+    nixlUcxPublicMetadata *md = new nixlUcxPublicMetadata;
 
     //directly copy underlying conn struct
-    md->conn = conn;
+    md->conn = search->second;
 
     char *addr = new char[size];
     nixlSerDes::_stringToBytes(addr, blob, size);
 
-    int ret = uw->rkeyImport(conn.ep, addr, size, md->rkey);
-    if (ret) {
-        // TODO: error out. Should we indicate which desc failed or unroll everything prior
-        return NIXL_ERR_BACKEND;
+    md->rkeys.resize(uws.size());
+    for (size_t i = 0; i < uws.size(); i++) {
+        int ret = uws[i]->uw.rkeyImport(md->conn.eps[i], addr, size, md->rkeys[i]);
+        if (ret) {
+            // TODO: error out. Should we indicate which desc failed or unroll everything prior
+            for (size_t j = 0; j < i; j++) {
+                uws[j]->uw.rkeyDestroy(md->rkeys[j]);
+            }
+            delete[] addr;
+            delete md;
+            return NIXL_ERR_BACKEND;
+        }
     }
     output = (nixlBackendMD*) md;
 
@@ -786,7 +1089,9 @@ nixl_status_t nixlUcxEngine::unloadMD (nixlBackendMD* input) {
 
     nixlUcxPublicMetadata *md = (nixlUcxPublicMetadata*) input; //typecast?
 
-    uw->rkeyDestroy(md->rkey);
+    for (size_t i = 0; i < md->rkeys.size(); i++) {
+        uws[i]->uw.rkeyDestroy(md->rkeys[i]);
+    }
     delete md;
 
     return NIXL_SUCCESS;
@@ -796,23 +1101,6 @@ nixl_status_t nixlUcxEngine::unloadMD (nixlBackendMD* input) {
  * Data movement
 *****************************************/
 
-static nixl_status_t _retHelper(nixl_status_t ret,  nixlUcxBackendH *hndl, nixlUcxReq &req)
-{
-    /* if transfer wasn't immediately completed */
-    switch(ret) {
-        case NIXL_IN_PROG:
-            hndl->append((nixlUcxIntReq*)req);
-        case NIXL_SUCCESS:
-            // Nothing to do
-            break;
-        default:
-            // Error. Release all previously initiated ops and exit:
-            hndl->release();
-            return NIXL_ERR_BACKEND;
-    }
-    return NIXL_SUCCESS;
-}
-
 nixl_status_t nixlUcxEngine::prepXfer (const nixl_xfer_op_t &operation,
                                        const nixl_meta_dlist_t &local,
                                        const nixl_meta_dlist_t &remote,
@@ -820,8 +1108,13 @@ nixl_status_t nixlUcxEngine::prepXfer (const nixl_xfer_op_t &operation,
                                        nixlBackendReqH* &handle,
                                        const nixl_opt_b_args_t* opt_args)
 {
-    /* TODO: try to get from a pool first */
-    nixlUcxBackendH *intHandle = new nixlUcxBackendH(uw);
+    // The transfer stays on the worker of the thread that prepared it
+    nixlUcxEngineWorker &w = getWorker();
+    nixlUcxBackendH *intHandle = w.reqHPool.get(&w);
+
+    if (opt_args) {
+        intHandle->completion = opt_args->completion;
+    }
 
     handle = (nixlBackendReqH*)intHandle;
     return NIXL_SUCCESS;
@@ -839,6 +1132,8 @@ nixl_status_t nixlUcxEngine::postXfer (const nixl_xfer_op_t &operation,
     size_t i;
     nixl_status_t ret;
     nixlUcxBackendH *intHandle = (nixlUcxBackendH *)handle;
+    nixlUcxEngineWorker &w = intHandle->getWorker();
+    nixlUcxWorker *uw = &w.uw;
     nixlUcxPrivateMetadata *lmd;
     nixlUcxPublicMetadata *rmd;
     nixlUcxReq req;
@@ -848,6 +1143,8 @@ nixl_status_t nixlUcxEngine::postXfer (const nixl_xfer_op_t &operation,
         return NIXL_ERR_INVALID_PARAM;
     }
 
+    intHandle->clear();
+
     for(i = 0; i < lcnt; i++) {
         void *laddr = (void*) local[i].addr;
         size_t lsize = local[i].len;
@@ -863,36 +1160,83 @@ nixl_status_t nixlUcxEngine::postXfer (const nixl_xfer_op_t &operation,
 
         // TODO: remote_agent and msg should be cached in nixlUCxReq or another way
 
-        switch (operation) {
-        case NIXL_READ:
-            ret = uw->read(rmd->conn.ep, (uint64_t) raddr, rmd->rkey, laddr, lmd->mem, lsize, req);
-            break;
-        case NIXL_WRITE:
-            ret = uw->write(rmd->conn.ep, laddr, lmd->mem, (uint64_t) raddr, rmd->rkey, lsize, req);
-            break;
-        default:
+        if ((operation != NIXL_READ) && (operation != NIXL_WRITE)) {
             return NIXL_ERR_INVALID_PARAM;
         }
 
-        if (_retHelper(ret, intHandle, req)) {
+        nixlUcxEp &ep = rmd->conn.eps[w.id];
+
+        intHandle->addOp();
+        if (operation == NIXL_READ) {
+            ret = uw->read(ep, (uint64_t) raddr, rmd->rkeys[w.id], laddr, lmd->mem, lsize,
+                           req, nixlUcxBackendH::completionCb, intHandle);
+        } else {
+            ret = uw->write(ep, laddr, lmd->mem, (uint64_t) raddr, rmd->rkeys[w.id], lsize,
+                            req, nixlUcxBackendH::completionCb, intHandle);
+        }
+
+        ret = intHandle->opPosted(ret, req);
+        if (ret != NIXL_SUCCESS) {
             return ret;
         }
+
+        // Consecutive descs mostly go to the same endpoint
+        std::vector<nixlUcxEp*> &eps = intHandle->flushEps;
+        if (eps.empty() || !(*eps.back() == ep)) {
+            auto it = std::find_if(eps.begin(), eps.end(),
+                                   [&ep](nixlUcxEp* e) { return *e == ep; });
+            if (it == eps.end()) {
+                eps.push_back(&ep);
+            }
+        }
     }
 
-    rmd = (nixlUcxPublicMetadata*) remote[0].metadataP;
-    ret = uw->flushEp(rmd->conn.ep, req);
-    if (_retHelper(ret, intHandle, req)) {
-        return ret;
+    // A read is done once its data arrived, while a write reaches the target only
+    // after a flush. The data has to be there before the notification too.
+    const bool has_notif = opt_args && opt_args->hasNotif;
+    const bool remote_compl =
+            (intHandle->completion != nixl_xfer_compl_t::NIXL_XFER_COMPL_LOCAL);
+
+    if (has_notif || ((operation == NIXL_WRITE) && remote_compl)) {
+        if (intHandle->completion == nixl_xfer_compl_t::NIXL_XFER_COMPL_REMOTE_ALL) {
+            w.workerFlushes++;
+            intHandle->addOp();
+            ret = uw->flushWorker(req, nixlUcxBackendH::completionCb, intHandle);
+            ret = intHandle->opPosted(ret, req);
+            if (ret != NIXL_SUCCESS) {
+                return ret;
+            }
+        } else {
+            for (nixlUcxEp* ep : intHandle->flushEps) {
+                w.epFlushes++;
+                intHandle->addOp();
+                ret = uw->flushEp(*ep, req, nixlUcxBackendH::completionCb, intHandle);
+                ret = intHandle->opPosted(ret, req);
+                if (ret != NIXL_SUCCESS) {
+                    return ret;
+                }
+            }
+        }
     }
 
     if(opt_args && opt_args->hasNotif) {
-        ret = notifSendPriv(remote_agent, opt_args->notifMsg, req);
-        if (_retHelper(ret, intHandle, req)) {
+        ret = notifSendPriv(w, remote_agent, opt_args->notifMsg, req, intHandle);
+        if (ret != NIXL_SUCCESS) {
             return ret;
         }
     }
 
-    return intHandle->status();
+    ret = intHandle->status();
+    if ((ret == NIXL_IN_PROG) && opt_args && opt_args->xferCb) {
+        intHandle->cb = opt_args->xferCb;
+        intHandle->cbArg = opt_args->xferCbArg;
+        watchXfer(intHandle);
+    }
+    if (ret == NIXL_IN_PROG) {
+        progressThreadWakeup(w);
+    }
+
+    return ret;
 }
 
 nixl_status_t nixlUcxEngine::checkXfer (nixlBackendReqH* handle)
@@ -905,17 +1249,45 @@ nixl_status_t nixlUcxEngine::checkXfer (nixlBackendReqH* handle)
 nixl_status_t nixlUcxEngine::releaseReqH(nixlBackendReqH* handle)
 {
     nixlUcxBackendH *intHandle = (nixlUcxBackendH *)handle;
-    nixl_status_t status = intHandle->release();
 
-    /* TODO: return to a pool instead. */
-    delete intHandle;
+    if (pthrOn) {
+        unwatchXfer(intHandle);
+    }
+    return intHandle->release();
+}
 
-    return status;
+void nixlUcxEngine::getStats (nixl_stats_t &stats) const {
+    uint64_t hits, misses;
+    size_t   free_cnt;
+
+    stats["workers"] = uws.size();
+    stats["pthr.sleeps"] = pthrSleeps;
+
+    // Pools are per worker, their counters are summed up
+    for (auto &w : uws) {
+        w->reqHPool.getCounters(hits, misses, free_cnt);
+        stats["req_h_pool.hits"]   += hits;
+        stats["req_h_pool.misses"] += misses;
+        stats["req_h_pool.free"]   += free_cnt;
+
+        w->amBufPool.getCounters(hits, misses, free_cnt);
+        stats["notif_buf_pool.hits"]   += hits;
+        stats["notif_buf_pool.misses"] += misses;
+        stats["notif_buf_pool.free"]   += free_cnt;
+
+        stats["flush.ep"]     += w->epFlushes;
+        stats["flush.worker"] += w->workerFlushes;
+    }
 }
 
 int nixlUcxEngine::progress() {
+    int ret = 0;
+
     // TODO: add listen for connection handling if necessary
-    return uw->progress();
+    for (auto &w : uws) {
+        ret += w->uw.progress();
+    }
+    return ret;
 }
 
 /****************************************
@@ -923,14 +1295,12 @@ int nixlUcxEngine::progress() {
 *****************************************/
 
 //agent will provide cached msg
-nixl_status_t nixlUcxEngine::notifSendPriv(const std::string &remote_agent,
-                                           const std::string &msg, nixlUcxReq &req)
+nixl_status_t nixlUcxEngine::notifSendPriv(nixlUcxEngineWorker &w,
+                                           const std::string &remote_agent,
+                                           const std::string &msg, nixlUcxReq &req,
+                                           nixlUcxBackendH *hndl)
 {
-    nixlSerDes ser_des;
-    std::string *ser_msg;
-    nixlUcxConnection conn;
-    // TODO - temp fix, need to have an mpool
-    static struct nixl_ucx_am_hdr hdr;
+    nixlUcxAmBuffer *am_buf;
     uint32_t flags = 0;
     nixl_status_t ret;
 
@@ -941,26 +1311,41 @@ nixl_status_t nixlUcxEngine::notifSendPriv(const std::string &remote_agent,
         return NIXL_ERR_NOT_FOUND;
     }
 
-    conn = remoteConnMap[remote_agent];
+    nixlUcxEp &ep = search->second.eps[w.id];
 
-    hdr.op = NOTIF_STR;
     flags |= UCP_AM_SEND_FLAG_EAGER;
 
-    ser_des.addStr("name", localAgent);
-    ser_des.addStr("msg", msg);
-    // TODO: replace with mpool for performance
-    ser_msg = new std::string(ser_des.exportStr());
+    // The buffer keeps its capacity, so reusing it doesn't allocate
+    am_buf = w.amBufPool.get(&w.amBufPool);
+    am_buf->hdr.op = NOTIF_STR;
+    am_buf->ser.reset();
+    am_buf->ser.addStr("name", localAgent);
+    am_buf->ser.addStr("msg", msg);
+    std::string_view ser_msg = am_buf->ser.exportView();
+
+    if (hndl) {
+        // Kept by the handle, as its request is freed on completion
+        hndl->setNotifBuf(am_buf);
+        hndl->addOp();
+        ret = w.uw.sendAm(ep, NOTIF_STR,
+                          &am_buf->hdr, sizeof(struct nixl_ucx_am_hdr),
+                          (void*) ser_msg.data(), ser_msg.size(),
+                          flags, req, nixlUcxBackendH::completionCb, hndl);
+        return hndl->opPosted(ret, req);
+    }
 
-    ret = uw->sendAm(conn.ep, NOTIF_STR,
-                     &hdr, sizeof(struct nixl_ucx_am_hdr),
-                     (void*) ser_msg->data(), ser_msg->size(),
-                     flags, req);
+    ret = w.uw.sendAm(ep, NOTIF_STR,
+                      &am_buf->hdr, sizeof(struct nixl_ucx_am_hdr),
+                      (void*) ser_msg.data(), ser_msg.size(),
+                      flags, req);
 
     if (ret == NIXL_IN_PROG) {
         nixlUcxIntReq* nReq = (nixlUcxIntReq*)req;
-        nReq->amBuffer = ser_msg;
+        // A request released untracked by genNotif can still hold its buffer
+        nReq->putAmBuffer();
+        nReq->amBuffer = am_buf;
     } else {
-        delete ser_msg;
+        w.amBufPool.put(am_buf);
     }
     return ret;
 }
@@ -997,6 +1382,7 @@ nixlUcxEngine::notifAmCb(void *arg, const void *header,
         /* Append to the private list to allow batching */
         engine->notifPthrPriv.push_back(std::make_pair(remote_name, msg));
     } else {
+        const std::lock_guard<std::mutex> lock(engine->notifMtx);
         engine->notifMainList.push_back(std::make_pair(remote_name, msg));
     }
 
@@ -1004,17 +1390,6 @@ nixlUcxEngine::notifAmCb(void *arg, const void *header,
 }
 
 
-void nixlUcxEngine::notifCombineHelper(notif_list_t &src, notif_list_t &tgt)
-{
-    if (!src.size()) {
-        // Nothing to do. Exit
-        return;
-    }
-
-    move(src.begin(), src.end(), back_inserter(tgt));
-    src.erase(src.begin(), src.end());
-}
-
 void nixlUcxEngine::notifProgressCombineHelper(notif_list_t &src, notif_list_t &tgt)
 {
     notifMtx.lock();
@@ -1039,7 +1414,7 @@ nixl_status_t nixlUcxEngine::getNotifs(notif_list_t &notif_list)
 
     if(!pthrOn) while(progress());
 
-    notifCombineHelper(notifMainList, notif_list);
+    notifProgressCombineHelper(notifMainList, notif_list);
     notifProgressCombineHelper(notifPthr, notif_list);
 
     return NIXL_SUCCESS;
@@ -1047,15 +1422,17 @@ nixl_status_t nixlUcxEngine::getNotifs(notif_list_t &notif_list)
 
 nixl_status_t nixlUcxEngine::genNotif(const std::string &remote_agent, const std::string &msg)
 {
+    nixlUcxEngineWorker &w = getWorker();
     nixl_status_t ret;
     nixlUcxReq req;
 
-    ret = notifSendPriv(remote_agent, msg, req);
+    ret = notifSendPriv(w, remote_agent, msg, req);
 
     switch(ret) {
     case NIXL_IN_PROG:
         /* do not track the request */
-        uw->reqRelease(req);
+        w.uw.reqRelease(req);
+        progressThreadWakeup(w);
     case NIXL_SUCCESS:
         break;
     default:
@@ -22,6 +22,8 @@
 #include <iostream>
 #include <thread>
 #include <mutex>
+#include <memory>
+#include <atomic>
 
 #include "nixl.h"
 #include "backend/backend_engine.h"
@@ -30,7 +32,7 @@
 // Local includes
 #include "common/nixl_time.h"
 #include "ucx/ucx_utils.h"
-#include "common/list_elem.h"
+#include "common/obj_pool.h"
 
 enum ucx_cb_op_t {CONN_CHECK, NOTIF_STR, DISCONNECT};
 
@@ -41,7 +43,8 @@ struct nixl_ucx_am_hdr {
 class nixlUcxConnection : public nixlBackendConnMD {
     private:
         std::string remoteAgent;
-        nixlUcxEp ep;
+        // One endpoint per local worker
+        std::vector<nixlUcxEp> eps;
         volatile bool connected;
 
     public:
@@ -74,7 +77,8 @@ class nixlUcxPrivateMetadata : public nixlBackendMD {
 class nixlUcxPublicMetadata : public nixlBackendMD {
 
     public:
-        nixlUcxRkey rkey;
+        // Rkeys are unpacked on an endpoint, so one per local worker
+        std::vector<nixlUcxRkey> rkeys;
         nixlUcxConnection conn;
 
         nixlUcxPublicMetadata() : nixlBackendMD(false) {}
@@ -90,14 +94,46 @@ class nixlUcxPublicMetadata : public nixlBackendMD {
 // will be part of NIXL installation - we can have
 // HAVE_CUDA in h-files
 class nixlUcxCudaCtx;
+// Max number of released backend handles and notification buffers kept for reuse
+#define NIXL_UCX_REQ_H_POOL_SIZE  1024
+#define NIXL_UCX_AM_BUF_POOL_SIZE 256
+
+// Time without progress after which the progress thread waits for events,
+// and the longest it waits before checking again
+#define NIXL_UCX_PTHR_IDLE_US     1000
+#define NIXL_UCX_PTHR_WAIT_MS     100
+
+class nixlUcxBackendH;
+class nixlUcxAmBuffer;
+
+/* A worker of the engine, with the pools of the handles and notifications
+   posted on it. Each thread posts on the worker it is bound to. */
+class nixlUcxEngineWorker {
+    public:
+        const size_t id;
+        // Declared before the worker, whose requests can return buffers to them
+        // while it is destroyed
+        nixlObjPool<nixlUcxBackendH> reqHPool;
+        nixlObjPool<nixlUcxAmBuffer> amBufPool;
+        nixlUcxWorker uw;
+        // Work posted for the progress thread, to tell if it came before it slept
+        std::atomic<uint64_t> posts;
+        // Flushes of single endpoints and of the whole worker posted by transfers
+        std::atomic<uint64_t> epFlushes;
+        std::atomic<uint64_t> workerFlushes;
+
+        nixlUcxEngineWorker(nixlUcxContext *ctx, size_t _id);
+};
+
 class nixlUcxEngine : public nixlBackendEngine {
     private:
 
         /* UCX data */
         nixlUcxContext* uc;
-        nixlUcxWorker* uw;
-        void* workerAddr;
-        size_t workerSize;
+        std::vector<std::unique_ptr<nixlUcxEngineWorker>> uws;
+        // Serialized addresses of the workers
+        std::string workerAddrs;
+        uint64_t stripeWeight;
 
         /* Progress thread data */
         volatile bool pthrStop, pthrActive, pthrOn;
@@ -105,11 +141,34 @@ class nixlUcxEngine : public nixlBackendEngine {
         std::thread pthr;
         nixlTime::us_t pthrDelay;
 
+        /* Adaptive progress: once idle, the progress thread waits on the
+           event fds of the workers, and posting work wakes it up */
+        bool pthrEvents;
+        int pthrEpfd;
+        std::atomic<bool> pthrSleeping;
+        std::atomic<uint64_t> pthrSleeps;
+
+        /* Transfers with a completion callback, checked by the progress thread */
+        struct nixlUcxXferDone {
+            nixl_xfer_cb_t cb;
+            void *cbArg;
+            nixl_status_t status;
+        };
+        std::vector<nixlUcxBackendH*> pthrWatch;
+        std::vector<nixlUcxXferDone> pthrDone;
+        std::mutex pthrWatchMtx;
+
         /* CUDA data*/
         nixlUcxCudaCtx *cudaCtx;
         bool cuda_addr_wa;
-
-        /* Notifications */
+        // Registrations can run concurrently, but only one updates the context
+        std::mutex cudaCtxMtx;
+        // The context is created for NIXL_UCX_MT_WORKER, which leaves its memory
+        // mapping calls to the caller to serialize
+        std::mutex regMtx;
+
+        /* Notifications, notifMainList is protected by notifMtx since
+           several threads can progress the worker concurrently */
         notif_list_t notifMainList;
         std::mutex  notifMtx;
         notif_list_t notifPthrPriv, notifPthr;
@@ -130,9 +189,19 @@ class nixlUcxEngine : public nixlBackendEngine {
         void progressThreadStart();
         void progressThreadStop();
         void progressThreadRestart();
+        void progressThreadWakeup(nixlUcxEngineWorker &w);
+        uint64_t progressThreadPosts() const;
+        void progressThreadWait(uint64_t posts);
         bool isProgressThread(){
             return (std::this_thread::get_id() == pthr.get_id());
         }
+        void watchXfer(nixlUcxBackendH *handle);
+        void unwatchXfer(nixlUcxBackendH *handle);
+        // Returns true if transfers are still watched
+        bool watchProgress();
+
+        // Worker of the calling thread
+        nixlUcxEngineWorker &getWorker() const;
 
         // Connection helper
         static ucs_status_t
@@ -157,10 +226,12 @@ class nixlUcxEngine : public nixlBackendEngine {
                                       size_t header_length, void *data,
                                       size_t length,
                                       const ucp_am_recv_param_t *param);
-        nixl_status_t notifSendPriv(const std::string &remote_agent,
-                                    const std::string &msg, nixlUcxReq &req);
+        // With a handle, the send is counted as an operation of its transfer
+        nixl_status_t notifSendPriv(nixlUcxEngineWorker &w,
+                                    const std::string &remote_agent,
+                                    const std::string &msg, nixlUcxReq &req,
+                                    nixlUcxBackendH *hndl = nullptr);
         void notifProgress();
-        void notifCombineHelper(notif_list_t &src, notif_list_t &tgt);
         void notifProgressCombineHelper(notif_list_t &src, notif_list_t &tgt);
 
     public:
@@ -171,9 +242,19 @@ class nixlUcxEngine : public nixlBackendEngine {
         bool supportsLocal () const { return true; }
         bool supportsNotif () const { return true; }
         bool supportsProgTh () const { return pthrOn; }
+        // UCX workers are created in multi-threaded mode
+        bool supportsConcurrentXfer () const { return true; }
+        // Memory mapping and rkey packing are serialized by regMtx, the rest runs
+        // concurrently
+        bool supportsConcurrentReg () const { return true; }
+        // Completions are detected by the progress thread
+        bool supportsXferCb () const { return pthrOn; }
+        uint64_t getStripeWeight () const { return stripeWeight; }
 
         nixl_mem_list_t getSupportedMems () const;
 
+        void getStats (nixl_stats_t &stats) const;
+
         /* Object management */
         nixl_status_t getPublicData (const nixlBackendMD* meta,
                                      std::string &str) const;
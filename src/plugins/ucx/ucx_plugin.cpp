@@ -45,6 +45,8 @@ static const char* get_plugin_version() {
 static nixl_b_params_t get_backend_options() {
     nixl_b_params_t params;
     params["ucx_devices"] = "";
+    params["num_workers"] = "1";
+    params["progress_mode"] = "adaptive";
     return params;
 }
 
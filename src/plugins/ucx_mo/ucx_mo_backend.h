@@ -115,6 +115,8 @@ public:
     bool supportsLocal  () const { return false; }
     bool supportsNotif  () const { return true; }
     bool supportsProgTh () const { return pthrOn; }
+    // Each engine has its own device
+    uint64_t getStripeWeight () const { return _engineCnt; }
 
     nixl_mem_list_t getSupportedMems () const;
 
@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _NIXL_OBJ_POOL_H
+#define _NIXL_OBJ_POOL_H
+
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+// Free list of objects to be reused on the datapath, so neither the objects nor
+// the storage they own (e.g., vector capacity) are reallocated on every use.
+// Objects are created when the pool is empty, and up to maxFree of them are
+// kept when returned. Callers reset the state of an object they get.
+template <typename T>
+class nixlObjPool {
+private:
+    std::vector<T*> freeList;
+    size_t          maxFree;
+    bool            threadSafe;
+    mutable std::mutex lock;
+
+    uint64_t        hits   = 0;
+    uint64_t        misses = 0;
+
+    std::unique_lock<std::mutex> guard() const {
+        if (threadSafe)
+            return std::unique_lock<std::mutex>(lock);
+        return std::unique_lock<std::mutex>();
+    }
+
+public:
+    nixlObjPool(size_t max_free, bool thread_safe) :
+        maxFree(max_free), threadSafe(thread_safe)
+    {
+        freeList.reserve(max_free);
+    }
+
+    ~nixlObjPool() {
+        for (auto &obj : freeList)
+            delete obj;
+    }
+
+    nixlObjPool(const nixlObjPool&) = delete;
+    nixlObjPool& operator=(const nixlObjPool&) = delete;
+
+    template <typename... Args>
+    T* get(Args&&... args) {
+        {
+            auto g = guard();
+            if (!freeList.empty()) {
+                T* obj = freeList.back();
+                freeList.pop_back();
+                hits++;
+                return obj;
+            }
+            misses++;
+        }
+        return new T(std::forward<Args>(args)...);
+    }
+
+    void put(T* obj) {
+        {
+            auto g = guard();
+            if (freeList.size() < maxFree) {
+                freeList.push_back(obj);
+                return;
+            }
+        }
+        delete obj;
+    }
+
+    void getCounters(uint64_t &hit_cnt, uint64_t &miss_cnt, size_t &free_cnt) const {
+        auto g = guard();
+        hit_cnt  = hits;
+        miss_cnt = misses;
+        free_cnt = freeList.size();
+    }
+};
+
+#endif
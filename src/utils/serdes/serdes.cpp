@@ -14,11 +14,18 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <limits>
 #include "serdes.h"
 
-nixlSerDes::nixlSerDes() {
-    workingStr = "nixlSerDes|";
-    des_offset = 11;
+namespace {
+const std::string_view tagged_header = "nixlSerDes|";
+const std::string_view binary_header = "nixlSDv2";
+};
+
+nixlSerDes::nixlSerDes(const ser_fmt_t fmt) {
+    this->fmt  = fmt;
+    workingStr = (fmt == BINARY) ? binary_header : tagged_header;
+    des_offset = workingStr.size();
 
     mode = SERIALIZE;
 }
@@ -32,104 +39,147 @@ void nixlSerDes::_stringToBytes(void* fill_buf, const std::string &s, ssize_t si
     s.copy(reinterpret_cast<char*>(fill_buf), size); 
 }
 
-/* Ser/Des for Strings */
-nixl_status_t nixlSerDes::addStr(const std::string &tag, const std::string &str){
+bool nixlSerDes::peekField(std::string_view tag, size_t &val_offset, size_t &len) const {
+    std::string_view buf(workingStr);
+    size_t offset = des_offset;
+
+    if (fmt == BINARY) {
+        if ((offset >= buf.size()) || ((uint8_t) buf[offset] != tag.size()))
+            return false;
+        offset += 1;
+        if ((buf.size() - offset < tag.size() + sizeof(uint32_t)) ||
+            (buf.compare(offset, tag.size(), tag) != 0))
+            return false;
+        offset += tag.size();
+
+        uint32_t val_len;
+        memcpy(&val_len, buf.data() + offset, sizeof(val_len));
+        offset += sizeof(val_len);
+        if (buf.size() - offset < val_len)
+            return false;
+
+        val_offset = offset;
+        len        = val_len;
+        return true;
+    }
 
-    size_t len = str.size();
+    if ((offset > buf.size()) ||
+        (buf.size() - offset < tag.size() + sizeof(ssize_t)) ||
+        (buf.compare(offset, tag.size(), tag) != 0))
+        return false; //incorrect tag
+    offset += tag.size();
+
+    ssize_t val_len;
+    memcpy(&val_len, buf.data() + offset, sizeof(val_len));
+    offset += sizeof(val_len);
+    // Value is followed by the | delimiter
+    if ((val_len < 0) || (buf.size() - offset < (size_t) val_len + 1))
+        return false;
+
+    val_offset = offset;
+    len        = val_len;
+    return true;
+}
 
-    workingStr.append(tag);
-    workingStr.append(_bytesToString(&len, sizeof(size_t)));
-    workingStr.append(str);
-    workingStr.append("|");
+void nixlSerDes::skipField(const size_t val_offset, const size_t len) {
+    des_offset = val_offset + len + ((fmt == BINARY) ? 0 : 1);
+}
 
-    return NIXL_SUCCESS;
+/* Ser/Des for Strings */
+nixl_status_t nixlSerDes::addStr(std::string_view tag, std::string_view str){
+    return addBuf(tag, str.data(), str.size());
+}
+
+std::string nixlSerDes::getStr(std::string_view tag){
+    return std::string(getStrView(tag));
 }
 
-std::string nixlSerDes::getStr(const std::string &tag){
-
-    if(workingStr.compare(des_offset, tag.size(), tag) != 0){
-       //incorrect tag
-       return "";
-    } 
-    ssize_t len;
-
-    //skip tag
-    des_offset += tag.size();
-    
-    //get len
-    //_stringToBytes(&len, workingStr.data() + des_offset, sizeof(ssize_t));
-    _stringToBytes(&len, workingStr.substr(des_offset, sizeof(ssize_t)), sizeof(ssize_t));
-    des_offset += sizeof(ssize_t);
-
-    //get string
-    std::string ret = workingStr.substr(des_offset, len);
-    
-    //move past string plus | delimiter
-    des_offset += len + 1;
-
-    return ret;
+std::string_view nixlSerDes::getStrView(std::string_view tag){
+    size_t val_offset, len;
+
+    if (!peekField(tag, val_offset, len))
+        return std::string_view();
+
+    skipField(val_offset, len);
+    return std::string_view(workingStr).substr(val_offset, len);
 }
 
 /* Ser/Des for Byte buffers */
-nixl_status_t nixlSerDes::addBuf(const std::string &tag, const void* buf, ssize_t len){
+nixl_status_t nixlSerDes::addBuf(std::string_view tag, const void* buf, ssize_t len){
+
+    if (fmt == BINARY) {
+        if ((tag.size() > std::numeric_limits<uint8_t>::max()) || (len < 0) ||
+            ((size_t) len > std::numeric_limits<uint32_t>::max()))
+            return NIXL_ERR_INVALID_PARAM;
+
+        uint8_t  tag_len = tag.size();
+        uint32_t val_len = len;
+        workingStr.append(reinterpret_cast<const char*>(&tag_len), sizeof(tag_len));
+        workingStr.append(tag);
+        workingStr.append(reinterpret_cast<const char*>(&val_len), sizeof(val_len));
+        workingStr.append(reinterpret_cast<const char*>(buf), len);
+        return NIXL_SUCCESS;
+    }
 
     workingStr.append(tag);
-    workingStr.append(_bytesToString(&len, sizeof(ssize_t)));
-    workingStr.append(_bytesToString(buf, len));
+    workingStr.append(reinterpret_cast<const char*>(&len), sizeof(ssize_t));
+    workingStr.append(reinterpret_cast<const char*>(buf), len);
     workingStr.append("|");
 
     return NIXL_SUCCESS;
 }
 
-ssize_t nixlSerDes::getBufLen(const std::string &tag) const{
-    if(workingStr.compare(des_offset, tag.size(), tag) != 0){
-       //incorrect tag
-       return -1;
-    } 
+ssize_t nixlSerDes::getBufLen(std::string_view tag) const{
+    size_t val_offset, len;
 
-    ssize_t len;
-
-    //get len
-    //_stringToBytes(&len, workingStr.data() + des_offset + tag.size(), sizeof(ssize_t));
-    _stringToBytes(&len, workingStr.substr(des_offset + tag.size(), sizeof(ssize_t)), sizeof(ssize_t));
+    if (!peekField(tag, val_offset, len))
+        return -1;
 
     return len;
 }
 
-nixl_status_t nixlSerDes::getBuf(const std::string &tag, void *buf, ssize_t len){
-    if(workingStr.compare(des_offset, tag.size(), tag) != 0){
-       //incorrect tag
-       return NIXL_ERR_MISMATCH;
-    }
-    
-    //skip over tag and size, which we assume has been read previously
-    des_offset += tag.size() + sizeof(ssize_t);
+nixl_status_t nixlSerDes::getBuf(std::string_view tag, void *buf, ssize_t len){
+    size_t val_offset, val_len;
+
+    if (!peekField(tag, val_offset, val_len))
+        return NIXL_ERR_MISMATCH;
 
-    //_stringToBytes(buf, workingStr.data() + des_offset, len);
-    _stringToBytes(buf, workingStr.substr(des_offset, len), len);
+    // Length is assumed to be read previously through getBufLen
+    if ((len < 0) || ((size_t) len > val_len))
+        return NIXL_ERR_MISMATCH;
 
-    //bytes in string form are twice as long, skip those plus | delimiter
-    des_offset += len + 1;
+    memcpy(buf, workingStr.data() + val_offset, len);
+    skipField(val_offset, val_len);
 
     return NIXL_SUCCESS;
 }
 
 /* Ser/Des buffer management */
+void nixlSerDes::reset() {
+    workingStr.assign((fmt == BINARY) ? binary_header : tagged_header);
+    des_offset = workingStr.size();
+
+    mode = SERIALIZE;
+}
+
 std::string nixlSerDes::exportStr() const {
 	std::string ret_str = workingStr;
     return ret_str;
 }
 
 nixl_status_t nixlSerDes::importStr(const std::string &sdbuf) {
- 
-    if(sdbuf.compare(0, 11, "nixlSerDes|") != 0){
-       //incorrect tag
-       return NIXL_ERR_MISMATCH;
-    }    
+    std::string_view buf(sdbuf);
+
+    if (buf.substr(0, binary_header.size()) == binary_header)
+        fmt = BINARY;
+    else if (buf.substr(0, tagged_header.size()) == tagged_header)
+        fmt = TAGGED_STR;
+    else
+        return NIXL_ERR_MISMATCH; //incorrect header
 
     workingStr = sdbuf;
     mode = DESERIALIZE;
-    des_offset = 11;
+    des_offset = (fmt == BINARY) ? binary_header.size() : tagged_header.size();
 
     return NIXL_SUCCESS;
 }
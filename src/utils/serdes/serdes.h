@@ -19,32 +19,57 @@
 
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <cstdint>
 
 #include "nixl_types.h"
 
 class nixlSerDes {
+public:
+    /*
+     * TAGGED_STR: "nixlSerDes|" header, then per field the tag, its length as a
+     *             size_t, the value and a "|" delimiter. Kept readable for blobs
+     *             from agents that still produce it.
+     * BINARY:     "nixlSDv2" header, then per field a 1 byte tag length, the tag,
+     *             a 4 byte value length and the value.
+     */
+    typedef enum { TAGGED_STR, BINARY } ser_fmt_t;
+
 private:
     typedef enum { SERIALIZE, DESERIALIZE } ser_mode_t;
 
     std::string workingStr;
     ssize_t des_offset;
     ser_mode_t mode;
+    ser_fmt_t fmt;
+
+    // Offset and length of the value of the next field if it has the tag,
+    // without moving past it
+    bool peekField(std::string_view tag, size_t &val_offset, size_t &len) const;
+    void skipField(const size_t val_offset, const size_t len);
 
 public:
-    nixlSerDes();
+    nixlSerDes(const ser_fmt_t fmt = BINARY);
+
+    ser_fmt_t getFormat() const { return fmt; }
 
     /* Ser/Des for Strings */
-    nixl_status_t addStr(const std::string &tag, const std::string &str);
-    std::string getStr(const std::string &tag);
+    nixl_status_t addStr(std::string_view tag, std::string_view str);
+    std::string getStr(std::string_view tag);
+    // No copy, valid until the next importStr or the end of the object
+    std::string_view getStrView(std::string_view tag);
 
     /* Ser/Des for Byte buffers */
-    nixl_status_t addBuf(const std::string &tag, const void* buf, ssize_t len);
-    ssize_t getBufLen(const std::string &tag) const;
-    nixl_status_t getBuf(const std::string &tag, void *buf, ssize_t len);
+    nixl_status_t addBuf(std::string_view tag, const void* buf, ssize_t len);
+    ssize_t getBufLen(std::string_view tag) const;
+    nixl_status_t getBuf(std::string_view tag, void *buf, ssize_t len);
 
     /* Ser/Des buffer management */
     std::string exportStr() const;
+    // No copy, valid until the next change of the object
+    std::string_view exportView() const { return workingStr; }
+    // Starts a new serialization, keeping the allocated buffer
+    void reset();
     nixl_status_t importStr(const std::string &sdbuf);
 
     static std::string _bytesToString(const void *buf, ssize_t size);
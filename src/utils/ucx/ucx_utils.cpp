@@ -47,7 +47,8 @@ nixlUcxContext::nixlUcxContext(std::vector<std::string> devs,
                                size_t req_size,
                                nixlUcxContext::req_cb_t init_cb,
                                nixlUcxContext::req_cb_t fini_cb,
-                               nixl_ucx_mt_t __mt_type)
+                               nixl_ucx_mt_t __mt_type,
+                               bool wakeup)
 {
     ucp_params_t ucp_params;
     ucp_config_t *ucp_config;
@@ -58,6 +59,9 @@ nixlUcxContext::nixlUcxContext(std::vector<std::string> devs,
     ucp_params.field_mask = UCP_PARAM_FIELD_FEATURES | UCP_PARAM_FIELD_MT_WORKERS_SHARED |
                             UCP_PARAM_FIELD_ESTIMATED_NUM_EPS;
     ucp_params.features = UCP_FEATURE_RMA | UCP_FEATURE_AMO32 | UCP_FEATURE_AMO64 | UCP_FEATURE_AM;
+    if (wakeup) {
+        ucp_params.features |= UCP_FEATURE_WAKEUP;
+    }
     switch(mt_type) {
     case NIXL_UCX_MT_SINGLE:
     case NIXL_UCX_MT_WORKER:
@@ -372,16 +376,27 @@ int nixlUcxWorker::regAmCallback(unsigned msg_id, ucp_am_recv_callback_t cb, voi
     return 0;
 }
 
+static inline void _setCallback(ucp_request_param_t &param, nixlUcxCb cb, void *cb_arg)
+{
+    if (cb) {
+        param.op_attr_mask |= UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
+        param.cb.send       = cb;
+        param.user_data     = cb_arg;
+    }
+}
+
 nixl_status_t nixlUcxWorker::sendAm(nixlUcxEp &ep, unsigned msg_id,
                                     void* hdr, size_t hdr_len,
                                     void* buffer, size_t len,
-                                    uint32_t flags, nixlUcxReq &req)
+                                    uint32_t flags, nixlUcxReq &req,
+                                    nixlUcxCb cb, void *cb_arg)
 {
     ucs_status_ptr_t request;
     ucp_request_param_t param = {0};
 
     param.op_attr_mask |= UCP_OP_ATTR_FIELD_FLAGS;
     param.flags         = flags;
+    _setCallback(param, cb, cb_arg);
 
     request = ucp_am_send_nbx(ep.eph, msg_id, hdr, hdr_len, buffer, len, &param);
 
@@ -412,6 +427,42 @@ int nixlUcxWorker::getRndvData(void* data_desc, void* buffer, size_t len, const
     return 0;
 }
 
+/* ===========================================
+ * Events
+ * =========================================== */
+
+int nixlUcxWorker::getEfd(int &fd)
+{
+    ucs_status_t status;
+
+    status = ucp_worker_get_efd(worker, &fd);
+    if (status != UCS_OK) {
+        return -1;
+    }
+
+    return 0;
+}
+
+nixl_status_t nixlUcxWorker::arm()
+{
+    ucs_status_t status;
+
+    status = ucp_worker_arm(worker);
+    switch (status) {
+    case UCS_OK:
+        return NIXL_SUCCESS;
+    case UCS_ERR_BUSY:
+        return NIXL_IN_PROG;
+    default:
+        return NIXL_ERR_BACKEND;
+    }
+}
+
+void nixlUcxWorker::signal()
+{
+    ucp_worker_signal(worker);
+}
+
 /* ===========================================
  * Data transfer
  * =========================================== */
@@ -424,7 +475,8 @@ int nixlUcxWorker::progress()
 nixl_status_t nixlUcxWorker::read(nixlUcxEp &ep,
                                   uint64_t raddr, nixlUcxRkey &rk,
                                   void *laddr, nixlUcxMem &mem,
-                                  size_t size, nixlUcxReq &req)
+                                  size_t size, nixlUcxReq &req,
+                                  nixlUcxCb cb, void *cb_arg)
 {
     ucs_status_ptr_t request;
 
@@ -432,6 +484,7 @@ nixl_status_t nixlUcxWorker::read(nixlUcxEp &ep,
         .op_attr_mask               = UCP_OP_ATTR_FIELD_MEMH,
         .memh                       = mem.memh,
     };
+    _setCallback(param, cb, cb_arg);
 
     request = ucp_get_nbx(ep.eph, laddr, size, raddr, rk.rkeyh, &param);
     if (request == NULL ) {
@@ -449,7 +502,8 @@ nixl_status_t nixlUcxWorker::read(nixlUcxEp &ep,
 nixl_status_t nixlUcxWorker::write(nixlUcxEp &ep,
                                    void *laddr, nixlUcxMem &mem,
                                    uint64_t raddr, nixlUcxRkey &rk,
-                                   size_t size, nixlUcxReq &req)
+                                   size_t size, nixlUcxReq &req,
+                                   nixlUcxCb cb, void *cb_arg)
 {
     ucs_status_ptr_t request;
 
@@ -457,6 +511,7 @@ nixl_status_t nixlUcxWorker::write(nixlUcxEp &ep,
         .op_attr_mask               = UCP_OP_ATTR_FIELD_MEMH,
         .memh                       = mem.memh,
     };
+    _setCallback(param, cb, cb_arg);
 
     request = ucp_put_nbx(ep.eph, laddr, size, raddr, rk.rkeyh, &param);
     if (request == NULL ) {
@@ -493,12 +548,14 @@ nixl_status_t nixlUcxWorker::test(nixlUcxReq req)
     }
 }
 
-nixl_status_t nixlUcxWorker::flushEp(nixlUcxEp &ep, nixlUcxReq &req)
+nixl_status_t nixlUcxWorker::flushEp(nixlUcxEp &ep, nixlUcxReq &req,
+                                     nixlUcxCb cb, void *cb_arg)
 {
     ucp_request_param_t param;
     ucs_status_ptr_t request;
 
     param.op_attr_mask = 0;
+    _setCallback(param, cb, cb_arg);
     request = ucp_ep_flush_nbx(ep.eph, &param);
 
     if (request == NULL ) {
@@ -513,6 +570,26 @@ nixl_status_t nixlUcxWorker::flushEp(nixlUcxEp &ep, nixlUcxReq &req)
     return NIXL_IN_PROG;
 }
 
+nixl_status_t nixlUcxWorker::flushWorker(nixlUcxReq &req,
+                                         nixlUcxCb cb, void *cb_arg)
+{
+    ucp_request_param_t param;
+    ucs_status_ptr_t request;
+
+    param.op_attr_mask = 0;
+    _setCallback(param, cb, cb_arg);
+    request = ucp_worker_flush_nbx(worker, &param);
+
+    if (request == NULL ) {
+        return NIXL_SUCCESS;
+    } else if (UCS_PTR_IS_ERR(request)) {
+        return NIXL_ERR_BACKEND;
+    }
+
+    req = (void*)request;
+    return NIXL_IN_PROG;
+}
+
 void nixlUcxWorker::reqRelease(nixlUcxReq req)
 {
     ucp_request_free((void*)req);
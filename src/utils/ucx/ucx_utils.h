@@ -36,6 +36,8 @@ private:
     ucp_ep_h  eph;
 
 public:
+    bool operator==(const nixlUcxEp &other) const { return eph == other.eph; }
+
     friend class nixlUcxWorker;
 };
 
@@ -59,6 +61,11 @@ public:
 
 using nixlUcxReq = void*;
 
+/* Completion callback of an operation that didn't complete immediately, called
+   from the thread progressing the worker, which takes over its request. Without
+   one, the request returned by the operation has to be tested and released. */
+using nixlUcxCb = ucp_send_nbx_callback_t;
+
 class nixlUcxContext {
 private:
     /* Local UCX stuff */
@@ -67,9 +74,10 @@ private:
 public:
 
     using req_cb_t = void(void *request);
+    // With wakeup, the workers can be waited on through their event fd
     nixlUcxContext(std::vector<std::string> devices,
                    size_t req_size, req_cb_t init_cb, req_cb_t fini_cb,
-                   nixl_ucx_mt_t mt_type);
+                   nixl_ucx_mt_t mt_type, bool wakeup = false);
     ~nixlUcxContext();
 
     static bool mtLevelIsSupproted(nixl_ucx_mt_t mt_type);
@@ -107,21 +115,35 @@ public:
     nixl_status_t sendAm(nixlUcxEp &ep, unsigned msg_id,
                          void* hdr, size_t hdr_len,
                          void* buffer, size_t len,
-                         uint32_t flags, nixlUcxReq &req);
+                         uint32_t flags, nixlUcxReq &req,
+                         nixlUcxCb cb = nullptr, void *cb_arg = nullptr);
     int getRndvData(void* data_desc, void* buffer, size_t len,
                     const ucp_request_param_t *param, nixlUcxReq &req);
 
+    /* Events, for a context created with wakeup */
+    int getEfd(int &fd);
+    // NIXL_IN_PROG if events are pending, which have to be progressed first
+    nixl_status_t arm();
+    // Wakes up a thread waiting on the event fd, from any thread
+    void signal();
+
     /* Data access */
     int progress();
-    nixl_status_t flushEp(nixlUcxEp &ep, nixlUcxReq &req);
+    nixl_status_t flushEp(nixlUcxEp &ep, nixlUcxReq &req,
+                          nixlUcxCb cb = nullptr, void *cb_arg = nullptr);
+    // Flushes all the endpoints of the worker
+    nixl_status_t flushWorker(nixlUcxReq &req,
+                              nixlUcxCb cb = nullptr, void *cb_arg = nullptr);
     nixl_status_t read(nixlUcxEp &ep,
                        uint64_t raddr, nixlUcxRkey &rk,
                        void *laddr, nixlUcxMem &mem,
-                       size_t size, nixlUcxReq &req);
+                       size_t size, nixlUcxReq &req,
+                       nixlUcxCb cb = nullptr, void *cb_arg = nullptr);
     nixl_status_t write(nixlUcxEp &ep,
                         void *laddr, nixlUcxMem &mem,
                         uint64_t raddr, nixlUcxRkey &rk,
-                        size_t size, nixlUcxReq &req);
+                        size_t size, nixlUcxReq &req,
+                        nixlUcxCb cb = nullptr, void *cb_arg = nullptr);
     nixl_status_t test(nixlUcxReq req);
 
     void reqRelease(nixlUcxReq req);
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEST_GTEST_AGENT_FIXTURE_H
+#define TEST_GTEST_AGENT_FIXTURE_H
+
+#include <gtest/gtest.h>
+#include "nixl.h"
+
+namespace gtest {
+
+// Agents with MOCK_DRAM backends, for the tests of the agent API. Memory is
+// never accessed by the mock, so the addresses are arbitrary.
+class AgentTestFixture : public testing::Test {
+protected:
+    const uintptr_t addr = 0;
+    const size_t len = 1024;
+    const uint64_t dev_id = 0;
+
+    nixlAgentConfig createConfig() {
+        return nixlAgentConfig(false, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT,
+                               0, 100000);
+    }
+
+    nixlBackendH* createBackend(nixlAgent &agent, const nixl_b_params_t &params = {}) {
+        nixlBackendH* backend = nullptr;
+        EXPECT_EQ(agent.createBackend("MOCK_DRAM", params, backend), NIXL_SUCCESS);
+        EXPECT_NE(backend, nullptr);
+        return backend;
+    }
+
+    nixl_opt_args_t createExtraParams(nixlBackendH* backend) {
+        nixl_opt_args_t extra_params;
+        extra_params.backends = {backend};
+        return extra_params;
+    }
+
+    void registerMem(nixlAgent &agent, const nixl_opt_args_t &extra_params,
+                     const uintptr_t offset = 0, const size_t size = 0) {
+        nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+        reg_list.addDesc(nixlBlobDesc(addr + offset, size ? size : len, dev_id, ""));
+        EXPECT_EQ(agent.registerMem(reg_list, &extra_params), NIXL_SUCCESS);
+    }
+
+    nixlDescList<nixlBasicDesc> xferList(const uintptr_t offset = 0, const size_t size = 0) {
+        nixlDescList<nixlBasicDesc> desc_list(DRAM_SEG);
+        desc_list.addDesc(nixlBasicDesc(addr + offset, size ? size : len, dev_id));
+        return desc_list;
+    }
+
+    nixl_stats_t getStats(const nixlAgent &agent) {
+        nixl_stats_t stats;
+        EXPECT_EQ(agent.getAgentStats(stats), NIXL_SUCCESS);
+        return stats;
+    }
+};
+
+} // namespace gtest
+
+#endif
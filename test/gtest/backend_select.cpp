@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include "backend_select.h"
+
+namespace gtest {
+namespace backend_select {
+
+namespace {
+
+// The selector only uses the engines as keys outside of its stats
+nixlBackendEngine* fakeEngine(const uintptr_t id) {
+    return reinterpret_cast<nixlBackendEngine*>(id);
+}
+
+// Completion time of a transfer with the given latency per descriptor and bandwidth
+double xferTime(const double desc_ns, const double byte_ns,
+                const double bytes, const double descs) {
+    return desc_ns * descs + byte_ns * bytes;
+}
+
+void addSamples(nixlCostSelector &selector, nixlBackendEngine* engine,
+                const double desc_ns, const double byte_ns) {
+    for (size_t bytes : {4096, 65536, 1 << 20, 16 << 20})
+        for (int descs : {1, 16})
+            selector.addSample(engine, "remote", bytes, descs,
+                               xferTime(desc_ns, byte_ns, bytes, descs));
+}
+
+} // anonymous namespace
+
+TEST(XferCostModelTest, FitsLatencyAndBandwidth) {
+    nixlXferCostModel model;
+    double desc_ns, byte_ns;
+    const double lat = 2000, inv_bw = 0.05;
+
+    // Varying sizes and descriptor counts, so both terms can be told apart
+    const double shapes[][2] = {{4096, 1}, {1 << 20, 1}, {65536, 8}, {16 << 20, 4},
+                                {8192, 32}, {1 << 22, 2}};
+    for (int i = 0; i < NIXL_XFER_COST_MIN_SAMPLES - 1; ++i)
+        model.addSample(shapes[i][0], shapes[i][1],
+                        xferTime(lat, inv_bw, shapes[i][0], shapes[i][1]));
+    EXPECT_FALSE(model.getCoeffs(desc_ns, byte_ns));
+
+    for (int i = NIXL_XFER_COST_MIN_SAMPLES - 1; i < 6; ++i)
+        model.addSample(shapes[i][0], shapes[i][1],
+                        xferTime(lat, inv_bw, shapes[i][0], shapes[i][1]));
+    ASSERT_TRUE(model.getCoeffs(desc_ns, byte_ns));
+    EXPECT_NEAR(desc_ns, lat, lat * 1e-6);
+    EXPECT_NEAR(byte_ns, inv_bw, inv_bw * 1e-6);
+    EXPECT_EQ(model.getSamples(), 6u);
+}
+
+TEST(XferCostModelTest, SameShapeSamples) {
+    nixlXferCostModel model;
+    double desc_ns, byte_ns;
+
+    // The split can't be told, but the time of that shape is predicted
+    for (int i = 0; i < NIXL_XFER_COST_MIN_SAMPLES; ++i)
+        model.addSample(65536, 4, 10000);
+    ASSERT_TRUE(model.getCoeffs(desc_ns, byte_ns));
+    EXPECT_GE(desc_ns, 0);
+    EXPECT_GE(byte_ns, 0);
+    EXPECT_NEAR(desc_ns * 4 + byte_ns * 65536, 10000, 1e-3);
+}
+
+TEST(XferCostModelTest, NoNegativeCoeffs) {
+    nixlXferCostModel model;
+    double desc_ns, byte_ns;
+
+    // Bigger transfers with more descriptors take less time, as noise can make them
+    model.addSample(1 << 20, 1, 100000);
+    model.addSample(1 << 20, 64, 90000);
+    model.addSample(2 << 20, 1, 200000);
+    model.addSample(2 << 20, 64, 190000);
+    ASSERT_TRUE(model.getCoeffs(desc_ns, byte_ns));
+    EXPECT_EQ(desc_ns, 0);
+    EXPECT_GT(byte_ns, 0);
+}
+
+TEST(CostSelectorTest, UnmeasuredFirst) {
+    nixlCostSelector selector;
+    nixlBackendEngine* measured   = fakeEngine(1);
+    nixlBackendEngine* unmeasured = fakeEngine(2);
+    addSamples(selector, measured, 100, 0.01);
+
+    std::vector<nixlBackendEngine*> engines = {measured, unmeasured};
+    selector.order(engines, "remote", 4096, 1);
+    EXPECT_EQ(engines[0], unmeasured);
+
+    // Measured for another agent only
+    addSamples(selector, unmeasured, 100, 0.001);
+    engines = {measured, unmeasured};
+    selector.order(engines, "other", 4096, 1);
+    EXPECT_EQ(engines, (std::vector<nixlBackendEngine*>{measured, unmeasured}));
+}
+
+TEST(CostSelectorTest, OrdersByPredictedTime) {
+    nixlCostSelector selector;
+    // Low latency and bandwidth, and high latency and bandwidth
+    nixlBackendEngine* low_lat = fakeEngine(1);
+    nixlBackendEngine* high_bw = fakeEngine(2);
+    addSamples(selector, low_lat, 1000, 0.1);
+    addSamples(selector, high_bw, 20000, 0.01);
+
+    // They cross over at about 200KB
+    std::vector<nixlBackendEngine*> engines = {high_bw, low_lat};
+    selector.order(engines, "remote", 4096, 1);
+    EXPECT_EQ(engines, (std::vector<nixlBackendEngine*>{low_lat, high_bw}));
+
+    engines = {low_lat, high_bw};
+    selector.order(engines, "remote", 1 << 20, 1);
+    EXPECT_EQ(engines, (std::vector<nixlBackendEngine*>{high_bw, low_lat}));
+
+    // Latency adds up with the descriptors
+    engines = {low_lat, high_bw};
+    selector.order(engines, "remote", 1 << 20, 1000);
+    EXPECT_EQ(engines, (std::vector<nixlBackendEngine*>{low_lat, high_bw}));
+}
+
+TEST(CostSelectorTest, StaleModelsMeasuredAgain) {
+    nixlCostSelector selector;
+    nixlBackendEngine* fast = fakeEngine(1);
+    nixlBackendEngine* slow = fakeEngine(2);
+    addSamples(selector, slow, 1000, 1);
+
+    std::vector<nixlBackendEngine*> engines;
+    for (int i = 0; i < NIXL_XFER_COST_STALE; ++i) {
+        addSamples(selector, fast, 1000, 0.01);
+        engines = {slow, fast};
+        selector.order(engines, "remote", 65536, 1);
+        EXPECT_EQ(engines[0], fast);
+    }
+
+    // Not sampled for a while, so tried again
+    addSamples(selector, fast, 1000, 0.01);
+    engines = {slow, fast};
+    selector.order(engines, "remote", 65536, 1);
+    EXPECT_EQ(engines[0], slow);
+}
+
+} // namespace backend_select
+} // namespace gtest
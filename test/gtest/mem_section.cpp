@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include "mem_section.h"
+
+namespace gtest {
+namespace mem_section {
+
+namespace {
+
+nixlSectionDesc sectionDesc(const uintptr_t addr, const size_t len, const uint64_t dev_id) {
+    nixlSectionDesc desc(addr, len, dev_id);
+    desc.metadataP = nullptr;
+    return desc;
+}
+
+// Same lookup as the index, by going through all the entries
+bool scanCover(const std::vector<nixlSectionDesc> &descs, const nixlBasicDesc &query) {
+    for (auto &desc : descs)
+        if (desc.covers(query))
+            return true;
+    return false;
+}
+
+void checkIndex(const nixlSectionIndex &index, const std::vector<nixlSectionDesc> &descs,
+                std::mt19937 &rng) {
+    EXPECT_EQ(index.descCount(), (int) descs.size());
+    EXPECT_TRUE(std::is_sorted(index.begin(), index.end()));
+    EXPECT_EQ(std::distance(index.begin(), index.end()), (long) descs.size());
+
+    std::uniform_int_distribution<uintptr_t> addr_dist(0, 1 << 20);
+    std::uniform_int_distribution<size_t>    len_dist(1, 4096);
+    std::uniform_int_distribution<uint64_t>  dev_dist(0, 2);
+    for (int i = 0; i < 2000; ++i) {
+        nixlBasicDesc query(addr_dist(rng), len_dist(rng), dev_dist(rng));
+        const nixlSectionDesc* found = index.cover(query);
+        EXPECT_EQ(found != nullptr, scanCover(descs, query));
+        if (found) {
+            EXPECT_TRUE(found->covers(query));
+        }
+    }
+
+    // Queries within the entries, which are always covered
+    for (int i = 0; i < 200 && !descs.empty(); ++i) {
+        const nixlSectionDesc &desc = descs[rng() % descs.size()];
+        nixlBasicDesc query(desc.addr + desc.len / 4, desc.len / 2, desc.devId);
+        const nixlSectionDesc* found = index.cover(query);
+        ASSERT_NE(found, nullptr);
+        EXPECT_TRUE(found->covers(query));
+        EXPECT_NE(index.find(desc), nullptr);
+    }
+}
+
+} // anonymous namespace
+
+TEST(SectionIndexTest, CoverWithOverlaps) {
+    nixlSectionIndex index(DRAM_SEG);
+    std::vector<nixlSectionDesc> descs;
+    std::mt19937 rng(1234);
+
+    // Mostly short registrations, and a few long ones overlapping many of them
+    std::uniform_int_distribution<uintptr_t> addr_dist(0, 1 << 20);
+    std::uniform_int_distribution<size_t>    short_dist(1, 8192);
+    std::uniform_int_distribution<size_t>    long_dist(1 << 16, 1 << 18);
+    for (int i = 0; i < 4000; ++i) {
+        size_t len = (i % 100 == 0) ? long_dist(rng) : short_dist(rng);
+        descs.push_back(sectionDesc(addr_dist(rng), len, rng() % 3));
+        index.addDesc(descs.back());
+    }
+    checkIndex(index, descs, rng);
+
+    // Removing the long ones, they're no longer found
+    for (auto it = descs.begin(); it != descs.end();) {
+        if (it->len >= (1 << 16)) {
+            EXPECT_TRUE(index.remDesc(*it));
+            it = descs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    checkIndex(index, descs, rng);
+
+    std::shuffle(descs.begin(), descs.end(), rng);
+    while (descs.size() > 100) {
+        EXPECT_TRUE(index.remDesc(descs.back()));
+        descs.pop_back();
+    }
+    checkIndex(index, descs, rng);
+
+    EXPECT_FALSE(index.remDesc(nixlBasicDesc(1 << 21, 1, 0)));
+    for (auto &desc : descs)
+        EXPECT_TRUE(index.remDesc(desc));
+    EXPECT_TRUE(index.isEmpty());
+    EXPECT_EQ(index.cover(nixlBasicDesc(0, 1, 0)), nullptr);
+}
+
+TEST(SectionIndexTest, DuplicateEntries) {
+    nixlSectionIndex index(DRAM_SEG);
+
+    // Registered twice, removed one at a time
+    nixlSectionDesc desc = sectionDesc(4096, 4096, 0);
+    index.addDesc(desc);
+    index.addDesc(desc);
+    EXPECT_EQ(index.descCount(), 2);
+
+    nixlBasicDesc query(5000, 100, 0);
+    EXPECT_TRUE(index.remDesc(desc));
+    EXPECT_NE(index.cover(query), nullptr);
+    EXPECT_TRUE(index.remDesc(desc));
+    EXPECT_EQ(index.cover(query), nullptr);
+    EXPECT_FALSE(index.remDesc(desc));
+}
+
+TEST(SectionIndexTest, InterleavedRanges) {
+    nixlSectionIndex index(DRAM_SEG);
+    const size_t block_len = 1024;
+    const size_t count     = 16;
+
+    // Blocks of two slabs in turn, so their spans cover each other's blocks
+    nixlSectionRange even, odd;
+    even.first    = nixlBasicDesc(0, block_len, 0);
+    even.stride   = 2 * block_len;
+    even.count    = count;
+    even.metaBlob = "even";
+    odd           = even;
+    odd.first     = nixlBasicDesc(block_len, block_len, 0);
+    odd.metaBlob  = "odd";
+    index.addRange(even);
+    index.addRange(odd);
+    EXPECT_EQ(index.rangeCount(), 2);
+
+    size_t idx;
+    for (size_t i = 0; i < 2 * count; ++i) {
+        nixlBasicDesc query(i * block_len + 10, block_len / 2, 0);
+        const nixlSectionRange* range = index.coverRange(query, idx);
+        ASSERT_NE(range, nullptr);
+        EXPECT_EQ(range->metaBlob, (i % 2) ? "odd" : "even");
+        EXPECT_EQ(idx, i / 2);
+    }
+
+    // Crossing two blocks, or on another device
+    EXPECT_EQ(index.coverRange(nixlBasicDesc(block_len / 2, block_len, 0), idx), nullptr);
+    EXPECT_EQ(index.coverRange(nixlBasicDesc(0, block_len, 1), idx), nullptr);
+
+    // Splits the odd range, the even one still covers its blocks
+    nixlBasicDesc block = odd.block(5);
+    EXPECT_TRUE(index.remRangeBlock(block));
+    EXPECT_FALSE(index.remRangeBlock(block));
+    EXPECT_EQ(index.rangeCount(), 3);
+    EXPECT_EQ(index.coverRange(block, idx), nullptr);
+    ASSERT_NE(index.coverRange(odd.block(6), idx), nullptr);
+    EXPECT_EQ(idx, 0u);
+    ASSERT_NE(index.coverRange(even.block(5), idx), nullptr);
+    EXPECT_EQ(idx, 5u);
+}
+
+} // namespace mem_section
+} // namespace gtest
@@ -0,0 +1,403 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "agent_fixture.h"
+
+namespace gtest {
+namespace metadata {
+
+// An initiator agent with the metadata of a target agent loaded
+class MetadataTestFixture : public AgentTestFixture {
+protected:
+    const std::string target_name = "target_agent";
+
+    // Transfer from the first local region to the given remote descriptors
+    nixl_status_t tryXfer(nixlAgent &initiator, const nixl_opt_args_t &extra_params,
+                          const nixlDescList<nixlBasicDesc> &remote_list,
+                          const std::string &remote_name) {
+        nixlXferReqH* req = nullptr;
+        nixlDescList<nixlBasicDesc> local_list = xferList(0, remote_list[0].len);
+        nixl_status_t ret = initiator.createXferReq(NIXL_WRITE, local_list, remote_list,
+                                                    remote_name, req, &extra_params);
+        if (ret != NIXL_SUCCESS)
+            return ret;
+        ret = initiator.postXferReq(req);
+        EXPECT_EQ(initiator.releaseXferReq(req), NIXL_SUCCESS);
+        return ret;
+    }
+};
+
+TEST_F(MetadataTestFixture, Deltas) {
+    nixlAgent target(target_name, createConfig());
+    nixlAgent initiator("initiator_agent", createConfig());
+    nixl_opt_args_t target_params = createExtraParams(createBackend(target));
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(initiator));
+    registerMem(target, target_params);
+    registerMem(initiator, extra_params);
+
+    nixl_blob_t md;
+    std::string name;
+    uint64_t gen = 0, since = 0;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(name, target_name);
+    EXPECT_EQ(initiator.getRemoteMDGen(target_name, gen), NIXL_SUCCESS);
+    const uint64_t bytes = getStats(initiator)["remote_md.bytes"];
+    EXPECT_GT(bytes, 0u);
+
+    // Same blob again is a no-op
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.getRemoteMDGen(target_name, since), NIXL_SUCCESS);
+    EXPECT_EQ(since, gen);
+
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    reg_list.addDesc(nixlBlobDesc(addr + 4 * len, len, dev_id, ""));
+    nixl_blob_t delta;
+
+    EXPECT_EQ(target.registerMem(reg_list, &target_params), NIXL_SUCCESS);
+    EXPECT_EQ(target.getLocalMDDelta(since, delta), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(delta, name), NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(4 * len), target_name), NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(), target_name), NIXL_SUCCESS);
+    EXPECT_GT(getStats(initiator)["remote_md.bytes"], bytes);
+
+    EXPECT_EQ(target.deregisterMem(reg_list, &target_params), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.getRemoteMDGen(target_name, since), NIXL_SUCCESS);
+    EXPECT_EQ(target.getLocalMDDelta(since, delta), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(delta, name), NIXL_SUCCESS);
+    EXPECT_NE(tryXfer(initiator, extra_params, xferList(4 * len), target_name), NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(), target_name), NIXL_SUCCESS);
+    // Bytes of the held entries, not of all the blobs loaded
+    EXPECT_EQ(getStats(initiator)["remote_md.bytes"], bytes);
+
+    uint64_t last_gen = 0;
+    EXPECT_EQ(initiator.getRemoteMDGen(target_name, last_gen), NIXL_SUCCESS);
+    EXPECT_EQ(last_gen, gen + 2);
+
+    // A delta made from another generation doesn't apply
+    nixl_blob_t stale;
+    EXPECT_EQ(target.getLocalMDDelta(gen, stale), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(stale, name), NIXL_ERR_MISMATCH);
+}
+
+TEST_F(MetadataTestFixture, DeltaReset) {
+    nixlAgent target(target_name, createConfig());
+    nixlAgent initiator("initiator_agent", createConfig());
+    nixl_opt_args_t target_params = createExtraParams(createBackend(target));
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(initiator));
+    registerMem(target, target_params);
+    registerMem(initiator, extra_params);
+
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    reg_list.addDesc(nixlBlobDesc(addr + 4 * len, len, dev_id, ""));
+    EXPECT_EQ(target.registerMem(reg_list, &target_params), NIXL_SUCCESS);
+
+    nixl_blob_t md;
+    std::string name;
+    uint64_t since = 0, gen = 0;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.getRemoteMDGen(target_name, since), NIXL_SUCCESS);
+    const uint64_t bytes = getStats(initiator)["remote_md.bytes"];
+
+    // A new backend drops the changes, so the delta replaces all the metadata
+    nixlBackendH* backend = nullptr;
+    EXPECT_EQ(target.deregisterMem(reg_list, &target_params), NIXL_SUCCESS);
+    EXPECT_EQ(target.createBackend("MOCK_DRAM_2", {}, backend), NIXL_SUCCESS);
+
+    nixl_blob_t reset;
+    EXPECT_EQ(target.getLocalMDDelta(since, reset), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(reset, name), NIXL_SUCCESS);
+    EXPECT_NE(tryXfer(initiator, extra_params, xferList(4 * len), target_name), NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(), target_name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.getRemoteMDGen(target_name, gen), NIXL_SUCCESS);
+    EXPECT_GT(gen, since);
+    // Only the registration left is held
+    const uint64_t reset_bytes = getStats(initiator)["remote_md.bytes"];
+    EXPECT_GT(reset_bytes, 0u);
+    EXPECT_LT(reset_bytes, bytes);
+
+    // Loaded again, it's still the same metadata
+    EXPECT_EQ(initiator.loadRemoteMD(reset, name), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(initiator)["remote_md.bytes"], reset_bytes);
+}
+
+TEST_F(MetadataTestFixture, ResetStalesRequests) {
+    nixlAgent target(target_name, createConfig());
+    nixlAgent initiator("initiator_agent", createConfig());
+    nixl_opt_args_t target_params = createExtraParams(createBackend(target));
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(initiator));
+    registerMem(target, target_params);
+    registerMem(initiator, extra_params);
+
+    nixl_blob_t md;
+    std::string name;
+    uint64_t since = 0;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.getRemoteMDGen(target_name, since), NIXL_SUCCESS);
+
+    nixlXferReqH* req = nullptr;
+    EXPECT_EQ(initiator.createXferReq(NIXL_WRITE, xferList(), xferList(), target_name,
+                                      req, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.postXferReq(req), NIXL_SUCCESS);
+
+    // The replaced metadata is kept while the request holds it
+    nixlBackendH* backend = nullptr;
+    EXPECT_EQ(target.createBackend("MOCK_DRAM_2", {}, backend), NIXL_SUCCESS);
+    nixl_blob_t reset;
+    EXPECT_EQ(target.getLocalMDDelta(since, reset), NIXL_SUCCESS);
+    const uint64_t unloads = getStats(initiator)["backend.MOCK_DRAM.md_unloads"];
+    EXPECT_EQ(initiator.loadRemoteMD(reset, name), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(initiator)["backend.MOCK_DRAM.md_unloads"], unloads);
+
+    // The request is freed by the failed post, along with the old metadata
+    EXPECT_EQ(initiator.postXferReq(req), NIXL_ERR_NOT_FOUND);
+    EXPECT_EQ(initiator.loadRemoteMD(reset, name), NIXL_SUCCESS);
+    EXPECT_GT(getStats(initiator)["backend.MOCK_DRAM.md_unloads"], unloads);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(), target_name), NIXL_SUCCESS);
+}
+
+TEST_F(MetadataTestFixture, RemovalKeepsUsedMD) {
+    nixlAgent target(target_name, createConfig());
+    nixlAgent initiator("initiator_agent", createConfig());
+    nixl_opt_args_t target_params = createExtraParams(createBackend(target));
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(initiator));
+    registerMem(target, target_params);
+    registerMem(initiator, extra_params);
+
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    reg_list.addDesc(nixlBlobDesc(addr + 4 * len, len, dev_id, ""));
+    EXPECT_EQ(target.registerMem(reg_list, &target_params), NIXL_SUCCESS);
+
+    nixl_blob_t md;
+    std::string name;
+    uint64_t since = 0;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.getRemoteMDGen(target_name, since), NIXL_SUCCESS);
+
+    nixlXferReqH* req = nullptr;
+    EXPECT_EQ(initiator.createXferReq(NIXL_WRITE, xferList(0, len), xferList(4 * len, len),
+                                      target_name, req, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.postXferReq(req), NIXL_SUCCESS);
+
+    nixl_blob_t delta;
+    EXPECT_EQ(target.deregisterMem(reg_list, &target_params), NIXL_SUCCESS);
+    EXPECT_EQ(target.getLocalMDDelta(since, delta), NIXL_SUCCESS);
+    const uint64_t unloads = getStats(initiator)["backend.MOCK_DRAM.md_unloads"];
+    EXPECT_EQ(initiator.loadRemoteMD(delta, name), NIXL_SUCCESS);
+    EXPECT_NE(tryXfer(initiator, extra_params, xferList(4 * len), target_name), NIXL_SUCCESS);
+
+    // The existing request still has the metadata of the removed registration,
+    // unloaded once it is released
+    EXPECT_EQ(initiator.postXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(initiator)["backend.MOCK_DRAM.md_unloads"], unloads);
+    EXPECT_EQ(initiator.releaseXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(initiator)["backend.MOCK_DRAM.md_unloads"], unloads + 1);
+}
+
+TEST_F(MetadataTestFixture, TaggedStrFormat) {
+    nixlAgentConfig cfg = createConfig();
+    cfg.taggedStrMD = true;
+    nixlAgent target(target_name, cfg);
+    nixlAgent initiator("initiator_agent", createConfig());
+    nixl_opt_args_t target_params = createExtraParams(createBackend(target));
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(initiator));
+    registerMem(target, target_params);
+    registerMem(initiator, extra_params);
+
+    // Same header as the blobs of agents from before the binary format
+    nixl_blob_t md;
+    std::string name;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(md.rfind("nixlSerDes|", 0), 0u);
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(), target_name), NIXL_SUCCESS);
+}
+
+TEST_F(MetadataTestFixture, StridedRegistrations) {
+    nixlAgent target(target_name, createConfig());
+    nixlAgent initiator("initiator_agent", createConfig());
+    nixl_opt_args_t target_params = createExtraParams(createBackend(target));
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(initiator));
+    registerMem(initiator, extra_params);
+
+    // Blocks with a gap between them, sent as one range record
+    const int blocks = 64;
+    const size_t stride = 2 * len;
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    for (int i = 0; i < blocks; ++i)
+        reg_list.addDesc(nixlBlobDesc(addr + i * stride, len, dev_id, ""));
+    EXPECT_EQ(target.registerMem(reg_list, &target_params), NIXL_SUCCESS);
+
+    nixl_blob_t md, partial_md;
+    std::string name;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(target.getLocalPartialMD(reg_list, partial_md, &target_params), NIXL_SUCCESS);
+    EXPECT_LT(md.size() * 4, partial_md.size());
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+
+    for (int i = 0; i < blocks; ++i)
+        EXPECT_EQ(tryXfer(initiator, extra_params, xferList(i * stride + len / 2, len / 2),
+                          target_name), NIXL_SUCCESS);
+
+    // Not covered by a block
+    EXPECT_NE(tryXfer(initiator, extra_params, xferList(len, len / 2), target_name),
+              NIXL_SUCCESS);
+
+    // A block removed through a delta is no longer part of the range
+    uint64_t since = 0;
+    nixl_blob_t delta;
+    nixlDescList<nixlBlobDesc> rem_list(DRAM_SEG);
+    rem_list.addDesc(nixlBlobDesc(addr + 5 * stride, len, dev_id, ""));
+    EXPECT_EQ(target.deregisterMem(rem_list, &target_params), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.getRemoteMDGen(target_name, since), NIXL_SUCCESS);
+    EXPECT_EQ(target.getLocalMDDelta(since, delta), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(delta, name), NIXL_SUCCESS);
+
+    EXPECT_NE(tryXfer(initiator, extra_params, xferList(5 * stride), target_name),
+              NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(6 * stride, len / 2), target_name),
+              NIXL_SUCCESS);
+}
+
+TEST_F(MetadataTestFixture, LazyRemoteMD) {
+    nixlAgentConfig cfg = createConfig();
+    nixlAgent target(target_name, cfg);
+    cfg.lazyRemoteMD = true;
+    nixlAgent initiator("initiator_agent", cfg);
+    nixl_opt_args_t target_params = createExtraParams(createBackend(target));
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(initiator));
+    registerMem(initiator, extra_params);
+
+    // Growing sizes, so they are not sent as a range record
+    const int regions = 16;
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    for (int i = 0; i < regions; ++i)
+        reg_list.addDesc(nixlBlobDesc(addr + i * 4 * len, len + i, dev_id, ""));
+    EXPECT_EQ(target.registerMem(reg_list, &target_params), NIXL_SUCCESS);
+
+    nixl_blob_t md;
+    std::string name;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(initiator)["remote_md.pending"], (uint64_t) regions);
+
+    // Each region is loaded on its first use
+    for (int i = 0; i < regions; i += 2)
+        EXPECT_EQ(tryXfer(initiator, extra_params, xferList(i * 4 * len), target_name),
+                  NIXL_SUCCESS);
+    EXPECT_EQ(getStats(initiator)["remote_md.pending"], (uint64_t) regions / 2);
+
+    // Not covered by any of them, loaded or not
+    EXPECT_NE(tryXfer(initiator, extra_params, xferList(2 * len), target_name), NIXL_SUCCESS);
+}
+
+TEST_F(MetadataTestFixture, RemoteMDLimit) {
+    nixlAgentConfig cfg = createConfig();
+    const int targets = 4;
+    std::vector<nixlAgent> target_agents;
+    std::vector<nixl_blob_t> target_mds(targets);
+    for (int i = 0; i < targets; ++i) {
+        target_agents.emplace_back("target_agent_" + std::to_string(i), cfg);
+        registerMem(target_agents[i], createExtraParams(createBackend(target_agents[i])));
+        EXPECT_EQ(target_agents[i].getLocalMD(target_mds[i]), NIXL_SUCCESS);
+    }
+
+    cfg.remoteMaxAgents = 2;
+    nixlAgent initiator("initiator_agent", cfg);
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(initiator));
+    registerMem(initiator, extra_params);
+
+    std::string name;
+    EXPECT_EQ(initiator.loadRemoteMD(target_mds[0], name), NIXL_SUCCESS);
+    // All targets hold the same registrations
+    const uint64_t bytes = getStats(initiator)["remote_md.bytes"];
+    EXPECT_EQ(initiator.loadRemoteMD(target_mds[1], name), NIXL_SUCCESS);
+
+    // Agent 0 is used last, so loading agent 2 drops agent 1
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(), "target_agent_0"), NIXL_SUCCESS);
+
+    EXPECT_EQ(initiator.loadRemoteMD(target_mds[2], name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_0", xferList()), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_1", xferList()), NIXL_ERR_NOT_FOUND);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_2", xferList()), NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(), "target_agent_1"),
+              NIXL_ERR_NOT_FOUND);
+
+    nixl_stats_t stats = getStats(initiator);
+    EXPECT_EQ(stats["remote_md.agents"], 2u);
+    EXPECT_EQ(stats["remote_md.evictions"], 1u);
+    EXPECT_EQ(stats["remote_md.bytes"], 2 * bytes);
+
+    // Loading it again makes room by dropping the least recently used one
+    EXPECT_EQ(initiator.loadRemoteMD(target_mds[1], name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_0", xferList()), NIXL_ERR_NOT_FOUND);
+    EXPECT_EQ(getStats(initiator)["remote_md.evictions"], 2u);
+}
+
+TEST_F(MetadataTestFixture, RemoteMDLimitKeepsUsedAgents) {
+    nixlAgentConfig cfg = createConfig();
+    const int targets = 3;
+    std::vector<nixlAgent> target_agents;
+    std::vector<nixl_blob_t> target_mds(targets);
+    for (int i = 0; i < targets; ++i) {
+        target_agents.emplace_back("target_agent_" + std::to_string(i), cfg);
+        registerMem(target_agents[i], createExtraParams(createBackend(target_agents[i])));
+        EXPECT_EQ(target_agents[i].getLocalMD(target_mds[i]), NIXL_SUCCESS);
+    }
+
+    cfg.remoteMaxAgents = 2;
+    nixlAgent initiator("initiator_agent", cfg);
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(initiator));
+    registerMem(initiator, extra_params);
+
+    std::string name;
+    EXPECT_EQ(initiator.loadRemoteMD(target_mds[0], name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(target_mds[1], name), NIXL_SUCCESS);
+
+    // Agent 0 is the least recently used, but its request is not released
+    nixlXferReqH* req = nullptr;
+    EXPECT_EQ(initiator.createXferReq(NIXL_WRITE, xferList(), xferList(), "target_agent_0",
+                                      req, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(), "target_agent_1"), NIXL_SUCCESS);
+
+    EXPECT_EQ(initiator.loadRemoteMD(target_mds[2], name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_0", xferList()), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_1", xferList()), NIXL_ERR_NOT_FOUND);
+
+    // Its post makes it the most recently used, once released it can be dropped
+    EXPECT_EQ(initiator.postXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.releaseXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(target_mds[1], name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_0", xferList()), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_2", xferList()), NIXL_ERR_NOT_FOUND);
+
+    // Same for prepared lists
+    nixlDlistH* dlist = nullptr;
+    EXPECT_EQ(initiator.prepXferDlist("target_agent_1", xferList(), dlist), NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(initiator, extra_params, xferList(), "target_agent_0"), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(target_mds[2], name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_1", xferList()), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.checkRemoteMD("target_agent_0", xferList()), NIXL_ERR_NOT_FOUND);
+    EXPECT_EQ(initiator.releasedDlistH(dlist), NIXL_SUCCESS);
+
+    EXPECT_EQ(getStats(initiator)["remote_md.evictions"], 3u);
+}
+
+} // namespace metadata
+} // namespace gtest
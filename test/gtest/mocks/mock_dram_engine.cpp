@@ -15,19 +15,58 @@
  * limitations under the License.
  */
 #include "mock_dram_engine.h"
+#include <chrono>
+#include <thread>
 
 namespace mocks {
 
-MockDramBackendEngine::~MockDramBackendEngine() {}
+MockDramBackendEngine::~MockDramBackendEngine() {
+  if (cbThread.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(cbLock);
+      cbStop = true;
+    }
+    cbCV.notify_one();
+    cbThread.join();
+  }
+}
+
+void MockDramBackendEngine::cbWorker() {
+  std::unique_lock<std::mutex> guard(cbLock);
+  while (!cbStop) {
+    if (cbQueue.empty()) {
+      cbCV.wait(guard);
+      continue;
+    }
+    std::vector<MockDramReqH *> done;
+    done.swap(cbQueue);
+
+    // The handle might be reposted or released within the callback
+    guard.unlock();
+    for (auto &req : done)
+      req->cb(req->cbArg, NIXL_SUCCESS);
+    guard.lock();
+  }
+}
 
 nixl_status_t MockDramBackendEngine::registerMem(const nixlBlobDesc &mem, const nixl_mem_t &nixl_mem,
                                                 nixlBackendMD *&out) {
-  sharedState++;
+  regAccess();
+  if (regFailAt && (++regCalls == regFailAt))
+    return NIXL_ERR_BACKEND;
+  uint64_t overlap = ++regOverlap;
+  uint64_t overlap_max = regOverlapMax;
+  while ((overlap > overlap_max) &&
+         !regOverlapMax.compare_exchange_weak(overlap_max, overlap))
+    ;
+  if (regDelay)
+    std::this_thread::sleep_for(std::chrono::microseconds(regDelay));
+  regOverlap--;
   return NIXL_SUCCESS;
 }
 
 nixl_status_t MockDramBackendEngine::deregisterMem(nixlBackendMD *meta) {
-  sharedState++;
+  regAccess();
   return NIXL_SUCCESS;
 }
 
@@ -42,7 +81,8 @@ nixl_status_t MockDramBackendEngine::disconnect(const std::string &remote_agent)
 }
 
 nixl_status_t MockDramBackendEngine::unloadMD(nixlBackendMD *input) {
-  sharedState++;
+  regAccess();
+  mdUnloads++;
   return NIXL_SUCCESS;
 }
 
@@ -52,7 +92,10 @@ nixl_status_t MockDramBackendEngine::prepXfer(const nixl_xfer_op_t &operation,
                                              const std::string &remote_agent,
                                              nixlBackendReqH *&handle,
                                              const nixl_opt_b_args_t *opt_args) {
-  sharedState++;
+  xferAccess();
+  if (opt_args && opt_args->completion == nixl_xfer_compl_t::NIXL_XFER_COMPL_LOCAL)
+    localComplPreps++;
+  handle = new MockDramReqH();
   return NIXL_SUCCESS;
 }
 
@@ -62,17 +105,44 @@ nixl_status_t MockDramBackendEngine::postXfer(const nixl_xfer_op_t &operation,
                                              const std::string &remote_agent,
                                              nixlBackendReqH *&handle,
                                              const nixl_opt_b_args_t *opt_args) {
-  sharedState++;
-  return NIXL_SUCCESS;
+  xferAccess();
+  if (postFailAt && (xferPosts + 1 == postFailAt)) {
+    xferPosts++;
+    return NIXL_ERR_BACKEND;
+  }
+  xferPosts++;
+  for (const auto &desc : local)
+    xferBytes += desc.len;
+  if (opt_args && opt_args->hasNotif)
+    notifPosts++;
+
+  MockDramReqH *req = (MockDramReqH *)handle;
+  if (xferCb && opt_args && opt_args->xferCb) {
+    req->cb = opt_args->xferCb;
+    req->cbArg = opt_args->xferCbArg;
+    {
+      std::lock_guard<std::mutex> guard(cbLock);
+      cbQueue.push_back(req);
+    }
+    cbCV.notify_one();
+    return NIXL_IN_PROG;
+  }
+
+  req->checksLeft = xferChecks;
+  return (xferChecks > 0) ? NIXL_IN_PROG : NIXL_SUCCESS;
 }
 
 nixl_status_t MockDramBackendEngine::checkXfer(nixlBackendReqH *handle) {
-  sharedState++;
-  return NIXL_SUCCESS;
+  xferAccess();
+  MockDramReqH *req = (MockDramReqH *)handle;
+  if (req->checksLeft > 0)
+    req->checksLeft--;
+  return (req->checksLeft > 0) ? NIXL_IN_PROG : NIXL_SUCCESS;
 }
 
 nixl_status_t MockDramBackendEngine::releaseReqH(nixlBackendReqH *handle) {
-  sharedState++;
+  xferAccess();
+  delete (MockDramReqH *)handle;
   return NIXL_SUCCESS;
 }
 
@@ -92,7 +162,7 @@ nixl_status_t MockDramBackendEngine::loadRemoteMD(const nixlBlobDesc &input,
 
 nixl_status_t MockDramBackendEngine::loadLocalMD(nixlBackendMD *input,
                                                 nixlBackendMD *&output) {
-  sharedState++;
+  regAccess();
   return NIXL_SUCCESS;
 }
 
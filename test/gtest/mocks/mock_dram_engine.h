@@ -20,12 +20,49 @@
 #include "backend/backend_engine.h"
 #include "backend/backend_plugin.h"
 #include <cassert>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace mocks {
 
+// Transfers are done after a number of checkXfer calls, or reported through the
+// completion callback by the engine thread
+class MockDramReqH : public nixlBackendReqH {
+public:
+  size_t checksLeft = 0;
+  nixl_xfer_cb_t cb = nullptr;
+  void *cbArg = nullptr;
+};
+
 class MockDramBackendEngine : public nixlBackendEngine {
 public:
-  MockDramBackendEngine(const nixlBackendInitParams *init_params) : nixlBackendEngine(init_params), sharedState(1) {}
+  MockDramBackendEngine(const nixlBackendInitParams *init_params) : nixlBackendEngine(init_params), sharedState(1) {
+    auto it = init_params->customParams->find("concurrent_xfer");
+    concurrentXfer = (it != init_params->customParams->end()) && (it->second == "true");
+    it = init_params->customParams->find("chunk_size");
+    chunkSize = (it != init_params->customParams->end()) ? std::stoul(it->second) : 0;
+    it = init_params->customParams->find("concurrent_reg");
+    concurrentReg = (it != init_params->customParams->end()) && (it->second == "true");
+    it = init_params->customParams->find("reg_delay_us");
+    regDelay = (it != init_params->customParams->end()) ? std::stoul(it->second) : 0;
+    it = init_params->customParams->find("reg_fail_at");
+    regFailAt = (it != init_params->customParams->end()) ? std::stoul(it->second) : 0;
+    it = init_params->customParams->find("notif");
+    notif = (it != init_params->customParams->end()) && (it->second == "true");
+    it = init_params->customParams->find("xfer_checks");
+    xferChecks = (it != init_params->customParams->end()) ? std::stoul(it->second) : 0;
+    it = init_params->customParams->find("post_fail_at");
+    postFailAt = (it != init_params->customParams->end()) ? std::stoul(it->second) : 0;
+    it = init_params->customParams->find("xfer_cb");
+    xferCb = (it != init_params->customParams->end()) && (it->second == "true");
+    it = init_params->customParams->find("stripe_weight");
+    stripeWeight = (it != init_params->customParams->end()) ? std::stoul(it->second) : 1;
+    if (xferCb)
+      cbThread = std::thread(&MockDramBackendEngine::cbWorker, this);
+  }
   ~MockDramBackendEngine();
 
   bool supportsRemote() const override {
@@ -38,12 +75,40 @@ public:
   }
   bool supportsNotif() const override {
     assert(sharedState > 0);
-    return false;
+    return notif;
   }
   bool supportsProgTh() const override {
     assert(sharedState > 0);
     return false;
   }
+  bool supportsConcurrentXfer() const override {
+    assert(sharedState > 0);
+    return concurrentXfer;
+  }
+  bool supportsConcurrentReg() const override {
+    assert(sharedState > 0);
+    return concurrentReg;
+  }
+  bool supportsXferCb() const override {
+    assert(sharedState > 0);
+    return xferCb;
+  }
+  size_t getChunkSize() const override {
+    assert(sharedState > 0);
+    return chunkSize;
+  }
+  uint64_t getStripeWeight() const override {
+    assert(sharedState > 0);
+    return stripeWeight;
+  }
+  void getStats(nixl_stats_t &stats) const override {
+    stats["xfer_posts"] = xferPosts;
+    stats["xfer_bytes"] = xferBytes;
+    stats["local_compl_preps"] = localComplPreps;
+    stats["notif_posts"] = notifPosts;
+    stats["reg_overlap_max"] = regOverlapMax;
+    stats["md_unloads"] = mdUnloads;
+  }
   nixl_mem_list_t getSupportedMems() const override {
     assert(sharedState > 0);
     return nixl_mem_list_t{DRAM_SEG};
@@ -74,6 +139,7 @@ public:
   }
   nixl_status_t getConnInfo(std::string &str) const override {
     assert(sharedState > 0);
+    str = "mock_dram";
     return NIXL_SUCCESS;
   }
   nixl_status_t loadRemoteConnInfo(const std::string &remote_agent,
@@ -92,6 +158,57 @@ private:
   // This represents an engine shared state that is read in every const method and modified in non-cost ones
   // The purpose is to trigger thread sanitizer in multi-threading tests
   int sharedState;
+  // When set, the datapath methods only read the shared state, so the agent can call them concurrently
+  bool concurrentXfer;
+  // Reported as the max descriptor size, to have the agent split longer ones
+  size_t chunkSize;
+  // When set, the registration methods only read the shared state, as xferAccess does
+  bool concurrentReg;
+  // Time each registerMem takes, as pinning memory would
+  size_t regDelay;
+  // Number of the registerMem call that fails, counting from 1, 0 for none
+  size_t regFailAt;
+  std::atomic<size_t> regCalls{0};
+  // Notifications are accepted and counted, but never delivered
+  bool notif;
+  // Number of checkXfer calls until a transfer is done, 0 to be done on post
+  size_t xferChecks;
+  // Number of the postXfer call that fails, counting from 1, 0 for none
+  size_t postFailAt;
+  // When set, transfers are done by cbThread, which calls their callback
+  bool xferCb;
+  std::thread cbThread;
+  std::mutex cbLock;
+  std::condition_variable cbCV;
+  std::vector<MockDramReqH *> cbQueue;
+  bool cbStop = false;
+
+  void cbWorker();
+  // Share of the transfers striped across several backends
+  uint64_t stripeWeight;
+  // Reported in the stats of the agent
+  std::atomic<uint64_t> xferPosts{0};
+  std::atomic<uint64_t> xferBytes{0};
+  std::atomic<uint64_t> localComplPreps{0};
+  std::atomic<uint64_t> notifPosts{0};
+  std::atomic<uint64_t> mdUnloads{0};
+  // Most registerMem calls seen running at the same time
+  std::atomic<uint64_t> regOverlap{0};
+  std::atomic<uint64_t> regOverlapMax{0};
+
+  void regAccess() {
+    if (concurrentReg)
+      assert(sharedState > 0);
+    else
+      sharedState++;
+  }
+
+  void xferAccess() {
+    if (concurrentXfer)
+      assert(sharedState > 0);
+    else
+      sharedState++;
+  }
 };
 } // namespace mocks
 
@@ -18,7 +18,12 @@
 #include "nixl.h"
 #include "plugin_manager.h"
 #include <thread>
+#include <atomic>
+#include <poll.h>
 #include <filesystem>
+#include <chrono>
+#include <iostream>
+#include <string>
 
 namespace gtest {
 namespace multi_threading {
@@ -30,7 +35,7 @@ protected:
     uint64_t dev_id = 0;
 
     nixlAgent createAgent() {
-        nixlAgentConfig cfg(false, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT);
+        nixlAgentConfig cfg(false, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT, 0, 100000);
         return nixlAgent("test_agent", cfg);
     }
 
@@ -156,6 +161,333 @@ TEST_F(MultiThreadingTestFixture, ConcurrentTransfers) {
     t2.join();
 }
 
+TEST_F(MultiThreadingTestFixture, ConcurrentPostScaling) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* backend = nullptr;
+    nixl_b_params_t params = {{"concurrent_xfer", "true"}};
+    ASSERT_EQ(agent.createBackend("MOCK_DRAM", params, backend), NIXL_SUCCESS);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    verifyMemoryRegistration(agent, extra_params);
+
+    nixlDescList<nixlBasicDesc> src_list(DRAM_SEG);
+    nixlDescList<nixlBasicDesc> dst_list(DRAM_SEG);
+    src_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+    dst_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+    const int posts_per_thread = 10000;
+    std::string summary;
+
+    for (int num_threads : {1, 2, 4, 8, 16}) {
+        std::vector<nixlXferReqH*> reqs(num_threads, nullptr);
+        for (auto &req : reqs)
+            ASSERT_EQ(agent.createXferReq(NIXL_WRITE, src_list, dst_list, "test_agent",
+                                          req, &extra_params), NIXL_SUCCESS);
+
+        std::vector<int> errors(num_threads, 0);
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < posts_per_thread; ++i) {
+                    if (agent.postXferReq(reqs[t]) < 0)
+                        errors[t]++;
+                    if (agent.getXferStatus(reqs[t]) != NIXL_SUCCESS)
+                        errors[t]++;
+                }
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        for (int t = 0; t < num_threads; ++t) {
+            EXPECT_EQ(errors[t], 0);
+            EXPECT_EQ(agent.releaseXferReq(reqs[t]), NIXL_SUCCESS);
+        }
+
+        const int posts_per_sec = num_threads * posts_per_thread / elapsed.count();
+        RecordProperty("posts_per_sec_" + std::to_string(num_threads) + "_threads",
+                       posts_per_sec);
+        summary += " " + std::to_string(num_threads) + ":" + std::to_string(posts_per_sec);
+    }
+
+    // Posts/s by thread count
+    std::cout << "[          ] posts/s by threads" << summary << std::endl;
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentPostToCQ) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    verifyMemoryRegistration(agent, extra_params);
+
+    nixlXferCQ* cq = nullptr;
+    ASSERT_EQ(agent.createXferCQ(cq), NIXL_SUCCESS);
+    int fd = -1;
+    ASSERT_EQ(agent.getXferCQFd(cq, fd), NIXL_SUCCESS);
+    extra_params.xferCQ = cq;
+
+    const size_t reqs_per_thread = 64;
+    std::vector<nixlXferReqH*> reqs[2];
+
+    auto post_sequence = [&](std::vector<nixlXferReqH*> &thread_reqs) {
+        nixlDescList<nixlBasicDesc> src_list(DRAM_SEG);
+        nixlDescList<nixlBasicDesc> dst_list(DRAM_SEG);
+        src_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+        dst_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+        thread_reqs.assign(reqs_per_thread, nullptr);
+        for (auto &req : thread_reqs) {
+            EXPECT_EQ(agent.createXferReq(NIXL_WRITE, src_list, dst_list, "test_agent",
+                                          req, &extra_params), NIXL_SUCCESS);
+            EXPECT_GE(agent.postXferReq(req, &extra_params), 0);
+        }
+    };
+
+    std::thread t1(post_sequence, std::ref(reqs[0]));
+    std::thread t2(post_sequence, std::ref(reqs[1]));
+
+    std::vector<nixlXferReqH*> done;
+    while (done.size() < 2 * reqs_per_thread) {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        ASSERT_GE(poll(&pfd, 1, 1000), 1);
+        agent.pollXferCQ(cq, done, 16);
+    }
+
+    t1.join();
+    t2.join();
+
+    for (auto &req : done) {
+        EXPECT_EQ(agent.getXferStatus(req), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    }
+
+    struct pollfd pfd = {fd, POLLIN, 0};
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+    EXPECT_EQ(agent.releaseXferCQ(cq), NIXL_SUCCESS);
+}
+
+namespace {
+
+struct chainCtx {
+    nixlAgent*       agent;
+    nixl_opt_args_t* extraParams;
+    int              remaining;
+    int              errors;
+};
+
+// Posts the same request again from its completion callback, till the chain ends
+void chainCb(nixlXferReqH* req_hndl, nixl_status_t status, void* ctx) {
+    chainCtx* chain = (chainCtx*) ctx;
+    if (status != NIXL_SUCCESS)
+        chain->errors++;
+    if (--chain->remaining > 0 && chain->agent->postXferReq(req_hndl, chain->extraParams) < 0)
+        chain->errors++;
+}
+
+} // anonymous namespace
+
+TEST_F(MultiThreadingTestFixture, ConcurrentCompletionCallbacks) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    verifyMemoryRegistration(agent, extra_params);
+
+    auto chain_sequence = [&]() {
+        nixlDescList<nixlBasicDesc> src_list(DRAM_SEG);
+        nixlDescList<nixlBasicDesc> dst_list(DRAM_SEG);
+        src_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+        dst_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+        nixlXferReqH* req = nullptr;
+        nixl_opt_args_t cb_params = extra_params;
+        chainCtx chain = {&agent, &cb_params, 16, 0};
+        cb_params.completionCb  = chainCb;
+        cb_params.completionCtx = &chain;
+
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, src_list, dst_list, "test_agent",
+                                      req, &extra_params), NIXL_SUCCESS);
+        EXPECT_GE(agent.postXferReq(req, &cb_params), 0);
+        while (chain.remaining > 0)
+            agent.progressXfers();
+
+        EXPECT_EQ(chain.errors, 0);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    };
+
+    std::thread t1(chain_sequence);
+    std::thread t2(chain_sequence);
+
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(agent.progressXfers(), NIXL_SUCCESS);
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentMetadataDeltas) {
+    nixlAgentConfig cfg(false, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT, 0, 100000);
+    nixlAgent target("target_agent", cfg);
+    nixlAgent initiator("initiator_agent", cfg);
+    nixlBackendH* target_backend = verifyMockDramBackendCreation(target);
+    nixlBackendH* backend = verifyMockDramBackendCreation(initiator);
+    nixl_opt_args_t target_params = createExtraParams(target_backend);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    verifyMemoryRegistration(target, target_params);
+    verifyMemoryRegistration(initiator, extra_params);
+
+    nixl_blob_t md;
+    std::string name;
+    uint64_t gen = 0;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(name, "target_agent");
+    // Same blob again is a no-op
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.getRemoteMDGen("target_agent", gen), NIXL_SUCCESS);
+
+    nixlDescList<nixlBasicDesc> local_list(DRAM_SEG);
+    local_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+    const int rounds = 32;
+    std::atomic<bool> done{false};
+
+    // Target registers and deregisters a second region, the initiator keeps
+    // transferring to the first one while loading the deltas.
+    auto update_sequence = [&]() {
+        nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+        reg_list.addDesc(nixlBlobDesc(addr + 4 * len, len, dev_id, ""));
+        nixlDescList<nixlBasicDesc> remote_list(DRAM_SEG);
+        remote_list.addDesc(nixlBasicDesc(addr + 4 * len, len, dev_id));
+
+        for (int i = 0; i < rounds; ++i) {
+            uint64_t since = 0;
+            nixl_blob_t delta;
+            nixlXferReqH* req = nullptr;
+
+            EXPECT_EQ(target.registerMem(reg_list, &target_params), NIXL_SUCCESS);
+            EXPECT_EQ(initiator.getRemoteMDGen("target_agent", since), NIXL_SUCCESS);
+            EXPECT_EQ(target.getLocalMDDelta(since, delta), NIXL_SUCCESS);
+            EXPECT_EQ(initiator.loadRemoteMD(delta, name), NIXL_SUCCESS);
+            EXPECT_EQ(initiator.createXferReq(NIXL_WRITE, local_list, remote_list,
+                                              "target_agent", req, &extra_params),
+                      NIXL_SUCCESS);
+            EXPECT_EQ(initiator.releaseXferReq(req), NIXL_SUCCESS);
+
+            EXPECT_EQ(target.deregisterMem(reg_list, &target_params), NIXL_SUCCESS);
+            EXPECT_EQ(initiator.getRemoteMDGen("target_agent", since), NIXL_SUCCESS);
+            EXPECT_EQ(target.getLocalMDDelta(since, delta), NIXL_SUCCESS);
+            EXPECT_EQ(initiator.loadRemoteMD(delta, name), NIXL_SUCCESS);
+            EXPECT_NE(initiator.createXferReq(NIXL_WRITE, local_list, remote_list,
+                                              "target_agent", req, &extra_params),
+                      NIXL_SUCCESS);
+        }
+        done = true;
+    };
+
+    auto transfer_sequence = [&]() {
+        while (!done) {
+            nixlXferReqH* req = nullptr;
+            EXPECT_EQ(initiator.createXferReq(NIXL_WRITE, local_list, local_list,
+                                              "target_agent", req, &extra_params),
+                      NIXL_SUCCESS);
+            EXPECT_EQ(initiator.postXferReq(req), NIXL_SUCCESS);
+            EXPECT_EQ(initiator.releaseXferReq(req), NIXL_SUCCESS);
+        }
+    };
+
+    std::thread t1(update_sequence);
+    std::thread t2(transfer_sequence);
+
+    t1.join();
+    t2.join();
+
+    uint64_t last_gen = 0;
+    EXPECT_EQ(initiator.getRemoteMDGen("target_agent", last_gen), NIXL_SUCCESS);
+    EXPECT_EQ(last_gen, gen + 2 * rounds);
+
+    // A delta made from an older generation doesn't apply
+    nixl_blob_t stale;
+    EXPECT_EQ(target.getLocalMDDelta(gen, stale), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(stale, name), NIXL_ERR_MISMATCH);
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentLazyRemoteMD) {
+    nixlAgentConfig cfg(false, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT, 0, 100000);
+    nixlAgent target("target_agent", cfg);
+    cfg.lazyRemoteMD = true;
+    nixlAgent initiator("initiator_agent", cfg);
+    cfg.preResolveRemoteMD = true;
+    nixlAgent resolver("resolver_agent", cfg);
+
+    nixlBackendH* target_backend = verifyMockDramBackendCreation(target);
+    nixlBackendH* backend = verifyMockDramBackendCreation(initiator);
+    verifyMockDramBackendCreation(resolver);
+    nixl_opt_args_t target_params = createExtraParams(target_backend);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    verifyMemoryRegistration(initiator, extra_params);
+
+    // Growing sizes, so they are not sent as a range record
+    const int regions = 64;
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    for (int i = 0; i < regions; ++i)
+        reg_list.addDesc(nixlBlobDesc(addr + i * 4 * len, len + i, dev_id, ""));
+    EXPECT_EQ(target.registerMem(reg_list, &target_params), NIXL_SUCCESS);
+
+    nixl_blob_t md;
+    std::string name;
+    nixl_stats_t stats;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(initiator.getAgentStats(stats), NIXL_SUCCESS);
+    EXPECT_EQ(stats["remote_md.pending"], (uint64_t) regions);
+
+    nixlDescList<nixlBasicDesc> local_list(DRAM_SEG);
+    local_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+    // Both threads use the even regions, so some are loaded concurrently
+    auto transfer_sequence = [&]() {
+        for (int i = 0; i < regions; i += 2) {
+            nixlDescList<nixlBasicDesc> remote_list(DRAM_SEG);
+            remote_list.addDesc(nixlBasicDesc(addr + i * 4 * len, len, dev_id));
+
+            nixlXferReqH* req = nullptr;
+            EXPECT_EQ(initiator.createXferReq(NIXL_WRITE, local_list, remote_list,
+                                              "target_agent", req, &extra_params),
+                      NIXL_SUCCESS);
+            EXPECT_EQ(initiator.postXferReq(req), NIXL_SUCCESS);
+            EXPECT_EQ(initiator.releaseXferReq(req), NIXL_SUCCESS);
+        }
+    };
+
+    std::thread t1(transfer_sequence);
+    std::thread t2(transfer_sequence);
+
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(initiator.getAgentStats(stats), NIXL_SUCCESS);
+    EXPECT_EQ(stats["remote_md.pending"], (uint64_t) regions / 2);
+
+    // The background thread loads them all
+    EXPECT_EQ(initiator.waitRemoteMDResolved(0), NIXL_ERR_NOT_SUPPORTED);
+    EXPECT_EQ(resolver.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(resolver.waitRemoteMDResolved(10000000), NIXL_SUCCESS);
+    EXPECT_EQ(resolver.getAgentStats(stats), NIXL_SUCCESS);
+    EXPECT_EQ(stats["remote_md.pending"], 0u);
+
+    // It runs alongside the other calls, so it needs the agent lock
+    cfg = nixlAgentConfig(false, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_NONE);
+    cfg.lazyRemoteMD       = true;
+    cfg.preResolveRemoteMD = true;
+    EXPECT_THROW(nixlAgent("unlocked_agent", cfg), std::invalid_argument);
+}
+
 TEST_F(MultiThreadingTestFixture, RegisterMemWithMockDram) {
     nixlAgent agent = createAgent();
     nixlBackendH* backend = verifyMockDramBackendCreation(agent);
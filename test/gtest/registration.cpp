@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <thread>
+#include "agent_fixture.h"
+
+namespace gtest {
+namespace registration {
+
+class RegistrationTestFixture : public AgentTestFixture {
+protected:
+    const std::string agent_name = "test_agent";
+
+    // Regions of region_len, one after the other from the start of the memory
+    nixlDescList<nixlBlobDesc> regList(const int regions, const size_t region_len) {
+        nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+        for (int i = 0; i < regions; ++i)
+            reg_list.addDesc(nixlBlobDesc(addr + i * region_len, region_len, dev_id, ""));
+        return reg_list;
+    }
+
+    nixl_status_t tryXfer(nixlAgent &agent, const nixl_opt_args_t &extra_params,
+                          const nixlDescList<nixlBasicDesc> &desc_list) {
+        nixlXferReqH* req = nullptr;
+        nixl_status_t ret = agent.createXferReq(NIXL_WRITE, desc_list, desc_list, agent_name,
+                                                req, &extra_params);
+        if (ret == NIXL_SUCCESS) {
+            EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+        }
+        return ret;
+    }
+};
+
+TEST_F(RegistrationTestFixture, PrepWithManyRegions) {
+    nixlAgent agent(agent_name, createConfig());
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+
+    const int regions = 4096;
+
+    // Registered out of order, and one region covering all the others
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    for (int i = regions - 1; i >= 0; --i)
+        reg_list.addDesc(nixlBlobDesc(addr + i * len, len, dev_id, ""));
+    EXPECT_EQ(agent.registerMem(reg_list, &extra_params), NIXL_SUCCESS);
+
+    nixlDescList<nixlBlobDesc> big_list(DRAM_SEG);
+    big_list.addDesc(nixlBlobDesc(addr, regions * len, dev_id + 1, ""));
+    EXPECT_EQ(agent.registerMem(big_list, &extra_params), NIXL_SUCCESS);
+
+    for (uint64_t prep_dev_id : {dev_id, dev_id + 1}) {
+        nixlDescList<nixlBasicDesc> query_list(DRAM_SEG);
+        for (int i = 0; i < regions; ++i)
+            query_list.addDesc(nixlBasicDesc(addr + i * len + len / 4, len / 2, prep_dev_id));
+
+        nixlDlistH* dlist_hndl = nullptr;
+        EXPECT_EQ(agent.prepXferDlist(NIXL_INIT_AGENT, query_list, dlist_hndl, &extra_params),
+                  NIXL_SUCCESS);
+        EXPECT_EQ(agent.releasedDlistH(dlist_hndl), NIXL_SUCCESS);
+    }
+
+    // Crossing two regions of the same device is not covered
+    nixlDlistH* dlist_hndl = nullptr;
+    EXPECT_NE(agent.prepXferDlist(NIXL_INIT_AGENT, xferList(len / 2), dlist_hndl,
+                                  &extra_params), NIXL_SUCCESS);
+
+    EXPECT_EQ(agent.deregisterMem(reg_list, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(agent.deregisterMem(big_list, &extra_params), NIXL_SUCCESS);
+}
+
+TEST_F(RegistrationTestFixture, ParallelRegistration) {
+    nixl_b_params_t params = {{"concurrent_reg", "true"}, {"reg_delay_us", "2000"}};
+    const int regions = 32;
+    nixlDescList<nixlBlobDesc> reg_list = regList(regions, len / regions);
+
+    nixlAgentConfig cfg = createConfig();
+    cfg.regThreads = 8;
+    nixlAgent agent(agent_name, cfg);
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+    EXPECT_EQ(agent.registerMem(reg_list, &extra_params), NIXL_SUCCESS);
+
+    nixlDescList<nixlBasicDesc> desc_list(DRAM_SEG);
+    for (int i = 0; i < regions; ++i)
+        desc_list.addDesc(reg_list[i]);
+    EXPECT_EQ(tryXfer(agent, extra_params, desc_list), NIXL_SUCCESS);
+
+    // Each call takes long enough for the threads to overlap
+    nixl_stats_t stats = getStats(agent);
+    EXPECT_EQ(stats["mem_reg.MOCK_DRAM.descs"], (uint64_t) regions);
+    EXPECT_GT(stats["backend.MOCK_DRAM.reg_overlap_max"], 1u);
+    EXPECT_LE(stats["backend.MOCK_DRAM.reg_overlap_max"], cfg.regThreads);
+    EXPECT_EQ(agent.deregisterMem(reg_list, &extra_params), NIXL_SUCCESS);
+}
+
+TEST_F(RegistrationTestFixture, AsyncRegistration) {
+    nixlAgent agent(agent_name, createConfig());
+    nixl_b_params_t params = {{"reg_delay_us", "2000"}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+
+    const int regions = 32;
+    const size_t region_len = len / regions;
+    nixlDescList<nixlBlobDesc> reg_list = regList(regions, region_len);
+
+    nixlRegH* reg_hndl = nullptr;
+    ASSERT_EQ(agent.registerMemAsync(reg_list, reg_hndl, &extra_params), NIXL_IN_PROG);
+
+    // The first regions are used while the rest are still being registered
+    int registered = 0;
+    while (agent.getRegStatus(reg_hndl, false, &registered) == NIXL_IN_PROG && registered == 0)
+        std::this_thread::yield();
+    EXPECT_EQ(tryXfer(agent, extra_params, xferList(0, region_len)), NIXL_SUCCESS);
+
+    EXPECT_EQ(agent.getRegStatus(reg_hndl, true, &registered), NIXL_SUCCESS);
+    EXPECT_EQ(registered, regions);
+    EXPECT_EQ(agent.releaseRegH(reg_hndl), NIXL_SUCCESS);
+
+    EXPECT_EQ(tryXfer(agent, extra_params, xferList((regions - 1) * region_len, region_len)),
+              NIXL_SUCCESS);
+    EXPECT_EQ(agent.deregisterMem(reg_list, &extra_params), NIXL_SUCCESS);
+}
+
+TEST_F(RegistrationTestFixture, AsyncRegistrationRollback) {
+    nixlAgentConfig cfg = createConfig();
+    cfg.regThreads = 4;
+    nixlAgent agent(agent_name, cfg);
+    nixl_b_params_t params = {{"reg_fail_at", "10"}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+
+    const int regions = 32;
+    const size_t region_len = len / regions;
+    nixlDescList<nixlBlobDesc> reg_list = regList(regions, region_len);
+
+    // The third batch fails, the first two are deregistered
+    nixlRegH* reg_hndl = nullptr;
+    int registered = -1;
+    ASSERT_EQ(agent.registerMemAsync(reg_list, reg_hndl, &extra_params), NIXL_IN_PROG);
+    EXPECT_EQ(agent.getRegStatus(reg_hndl, true, &registered), NIXL_ERR_BACKEND);
+    EXPECT_EQ(registered, 0);
+    EXPECT_EQ(agent.releaseRegH(reg_hndl), NIXL_ERR_BACKEND);
+
+    EXPECT_NE(tryXfer(agent, extra_params, xferList(0, region_len)), NIXL_SUCCESS);
+    EXPECT_NE(agent.deregisterMem(regList(1, region_len), &extra_params), NIXL_SUCCESS);
+
+    // Nothing is left behind, so the same regions can be registered again
+    EXPECT_EQ(agent.registerMem(reg_list, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(tryXfer(agent, extra_params, xferList(0, region_len)), NIXL_SUCCESS);
+    EXPECT_EQ(agent.deregisterMem(reg_list, &extra_params), NIXL_SUCCESS);
+
+    // Not allowed without the agent lock
+    nixlAgent unlocked_agent("unlocked_agent", nixlAgentConfig(false));
+    nixl_opt_args_t unlocked_params = createExtraParams(createBackend(unlocked_agent));
+    EXPECT_EQ(unlocked_agent.registerMemAsync(reg_list, reg_hndl, &unlocked_params),
+              NIXL_ERR_NOT_ALLOWED);
+}
+
+} // namespace registration
+} // namespace gtest
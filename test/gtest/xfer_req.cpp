@@ -0,0 +1,636 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <poll.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "agent_fixture.h"
+
+namespace gtest {
+namespace xfer_req {
+
+// The agent transfers to itself, with its own metadata loaded as the remote one
+class XferReqTestFixture : public AgentTestFixture {
+protected:
+    const std::string agent_name = "test_agent";
+
+    nixlAgent createAgent() {
+        return nixlAgent(agent_name, createConfig());
+    }
+
+    nixlXferReqH* createXferReq(nixlAgent &agent, const nixl_opt_args_t &extra_params) {
+        nixlXferReqH* req = nullptr;
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xferList(), xferList(), agent_name,
+                                      req, &extra_params), NIXL_SUCCESS);
+        EXPECT_NE(req, nullptr);
+        return req;
+    }
+};
+
+TEST_F(XferReqTestFixture, BatchRequestsAreRecycled) {
+    nixlAgent agent = createAgent();
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    const size_t reqs_count = 8;
+    for (int round = 0; round < 2; ++round) {
+        std::vector<nixlXferReqH*> reqs;
+        std::vector<nixl_status_t> status;
+        for (size_t i = 0; i < reqs_count; ++i)
+            reqs.push_back(createXferReq(agent, extra_params));
+
+        EXPECT_EQ(agent.postXferReqBatch(reqs, status), NIXL_SUCCESS);
+        EXPECT_EQ(status, std::vector<nixl_status_t>(reqs_count, NIXL_SUCCESS));
+        EXPECT_EQ(agent.getXferStatusBatch(reqs, status), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReqBatch(reqs), NIXL_SUCCESS);
+    }
+
+    // Requests of the second round are recycled from the first one
+    nixl_stats_t stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_req_pool_hits"], reqs_count);
+    EXPECT_EQ(stats["xfer_req_pool_misses"], reqs_count);
+    EXPECT_EQ(stats["xfer_req_pool_free"], reqs_count);
+
+    // Each request of a batch fails on its own
+    std::vector<nixlXferReqH*> reqs = {createXferReq(agent, extra_params), nullptr};
+    std::vector<nixl_status_t> status;
+    EXPECT_EQ(agent.postXferReqBatch(reqs, status), NIXL_ERR_INVALID_PARAM);
+    EXPECT_EQ(status[0], NIXL_SUCCESS);
+    EXPECT_EQ(status[1], NIXL_ERR_INVALID_PARAM);
+    EXPECT_EQ(agent.releaseXferReq(reqs[0]), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, BatchNotifications) {
+    nixlAgent agent = createAgent();
+    nixl_b_params_t params = {{"notif", "true"}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+    registerMem(agent, extra_params);
+
+    nixl_opt_args_t notif_params = extra_params;
+    notif_params.hasNotif = true;
+    notif_params.notifMsg = "notification";
+
+    // Set at creation, kept without extra_params, cleared by extra_params without one
+    std::vector<nixlXferReqH*> reqs = {createXferReq(agent, notif_params),
+                                       createXferReq(agent, notif_params)};
+    std::vector<nixl_status_t> status;
+    EXPECT_EQ(agent.postXferReqBatch(reqs, status), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(agent)["backend.MOCK_DRAM.notif_posts"], 2u);
+    EXPECT_EQ(agent.postXferReqBatch(reqs, status, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(agent)["backend.MOCK_DRAM.notif_posts"], 2u);
+    EXPECT_EQ(agent.postXferReqBatch(reqs, status), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(agent)["backend.MOCK_DRAM.notif_posts"], 2u);
+
+    // Given for the batch, and kept for the next posts
+    EXPECT_EQ(agent.postXferReqBatch(reqs, status, &notif_params), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(agent)["backend.MOCK_DRAM.notif_posts"], 4u);
+    EXPECT_EQ(agent.postXferReqBatch(reqs, status), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(agent)["backend.MOCK_DRAM.notif_posts"], 6u);
+    EXPECT_EQ(agent.releaseXferReqBatch(reqs), NIXL_SUCCESS);
+
+    // Backends without notifications fail each request, without releasing it
+    nixlAgent plain_agent = createAgent();
+    nixl_opt_args_t plain_params = createExtraParams(createBackend(plain_agent));
+    registerMem(plain_agent, plain_params);
+    notif_params.backends = plain_params.backends;
+
+    reqs = {createXferReq(plain_agent, plain_params)};
+    EXPECT_EQ(plain_agent.postXferReqBatch(reqs, status, &notif_params), NIXL_ERR_BACKEND);
+    EXPECT_EQ(status[0], NIXL_ERR_BACKEND);
+    EXPECT_EQ(getStats(plain_agent)["backend.MOCK_DRAM.xfer_posts"], 0u);
+    EXPECT_EQ(plain_agent.releaseXferReqBatch(reqs), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, CompletionQueue) {
+    nixlAgent agent = createAgent();
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    nixlXferCQ* cq = nullptr;
+    int fd = -1;
+    ASSERT_EQ(agent.createXferCQ(cq), NIXL_SUCCESS);
+    ASSERT_EQ(agent.getXferCQFd(cq, fd), NIXL_SUCCESS);
+
+    nixl_opt_args_t cq_params = extra_params;
+    cq_params.xferCQ = cq;
+
+    const size_t reqs_count = 8;
+    std::vector<nixlXferReqH*> reqs;
+    for (size_t i = 0; i < reqs_count; ++i) {
+        reqs.push_back(createXferReq(agent, extra_params));
+        EXPECT_EQ(agent.postXferReq(reqs.back(), &cq_params), NIXL_SUCCESS);
+    }
+
+    // Reported requests can't be reposted or released before they're polled
+    EXPECT_EQ(agent.postXferReq(reqs[0]), NIXL_ERR_REPOST_ACTIVE);
+    EXPECT_EQ(agent.releaseXferReq(reqs[0]), NIXL_ERR_NOT_ALLOWED);
+    EXPECT_EQ(agent.releaseXferCQ(cq), NIXL_ERR_NOT_ALLOWED);
+
+    struct pollfd pfd = {fd, POLLIN, 0};
+    EXPECT_EQ(poll(&pfd, 1, 0), 1);
+
+    std::vector<nixlXferReqH*> done;
+    EXPECT_EQ(agent.pollXferCQ(cq, done, reqs_count / 2), NIXL_SUCCESS);
+    EXPECT_EQ(done.size(), reqs_count / 2);
+    EXPECT_EQ(poll(&pfd, 1, 0), 1);
+    EXPECT_EQ(agent.pollXferCQ(cq, done), NIXL_SUCCESS);
+    EXPECT_EQ(done.size(), reqs_count);
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+    EXPECT_EQ(agent.pollXferCQ(cq, done), NIXL_IN_PROG);
+
+    for (auto &req : done) {
+        EXPECT_EQ(agent.getXferStatus(req), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    }
+    EXPECT_EQ(agent.releaseXferCQ(cq), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, CompletionQueuePending) {
+    nixlAgent agent = createAgent();
+    const size_t checks = 3;
+    nixl_b_params_t params = {{"xfer_checks", std::to_string(checks)}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+    registerMem(agent, extra_params);
+
+    nixlXferCQ* cq = nullptr;
+    int fd = -1;
+    ASSERT_EQ(agent.createXferCQ(cq), NIXL_SUCCESS);
+    ASSERT_EQ(agent.getXferCQFd(cq, fd), NIXL_SUCCESS);
+
+    nixl_opt_args_t cq_params = extra_params;
+    cq_params.xferCQ = cq;
+
+    const size_t reqs_count = 4;
+    for (size_t i = 0; i < reqs_count; ++i)
+        EXPECT_EQ(agent.postXferReq(createXferReq(agent, extra_params), &cq_params),
+                  NIXL_IN_PROG);
+
+    // Requests checked by the polls don't make the queue readable until done
+    struct pollfd pfd = {fd, POLLIN, 0};
+    std::vector<nixlXferReqH*> done;
+    for (size_t i = 1; i < checks; ++i) {
+        EXPECT_EQ(poll(&pfd, 1, 0), 0);
+        EXPECT_EQ(agent.pollXferCQ(cq, done), NIXL_IN_PROG);
+    }
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+
+    // Found done by a poll that returns part of them, the rest signal the queue
+    EXPECT_EQ(agent.pollXferCQ(cq, done, reqs_count / 2), NIXL_SUCCESS);
+    EXPECT_EQ(done.size(), reqs_count / 2);
+    EXPECT_EQ(poll(&pfd, 1, 0), 1);
+    EXPECT_EQ(agent.pollXferCQ(cq, done), NIXL_SUCCESS);
+    EXPECT_EQ(done.size(), reqs_count);
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+
+    for (auto &req : done) {
+        EXPECT_EQ(agent.getXferStatus(req), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    }
+    EXPECT_EQ(agent.releaseXferCQ(cq), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, CompletionQueueBackendCb) {
+    nixlAgent agent = createAgent();
+    nixl_b_params_t params = {{"xfer_cb", "true"}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+    registerMem(agent, extra_params);
+
+    nixlXferCQ* cq = nullptr;
+    int fd = -1;
+    ASSERT_EQ(agent.createXferCQ(cq), NIXL_SUCCESS);
+    ASSERT_EQ(agent.getXferCQFd(cq, fd), NIXL_SUCCESS);
+
+    nixl_opt_args_t cq_params = extra_params;
+    cq_params.xferCQ = cq;
+
+    // Reported by the backend thread, possibly before the posts return
+    const size_t reqs_count = 64;
+    std::vector<nixlXferReqH*> reqs;
+    for (size_t i = 0; i < reqs_count; ++i) {
+        reqs.push_back(createXferReq(agent, extra_params));
+        EXPECT_EQ(agent.postXferReq(reqs.back(), &cq_params), NIXL_IN_PROG);
+    }
+
+    std::vector<nixlXferReqH*> done;
+    while (done.size() < reqs_count) {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        ASSERT_EQ(poll(&pfd, 1, 1000), 1);
+        EXPECT_EQ(agent.pollXferCQ(cq, done), NIXL_SUCCESS);
+    }
+    struct pollfd pfd = {fd, POLLIN, 0};
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+
+    // Reposted as soon as they're returned
+    for (auto &req : reqs)
+        EXPECT_EQ(agent.postXferReq(req, &cq_params), NIXL_IN_PROG);
+    done.clear();
+    while (done.size() < reqs_count)
+        agent.pollXferCQ(cq, done);
+
+    for (auto &req : done) {
+        EXPECT_EQ(agent.getXferStatus(req), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    }
+    EXPECT_EQ(agent.releaseXferCQ(cq), NIXL_SUCCESS);
+}
+
+namespace {
+
+// Might be called from a backend thread
+struct callbackCtx {
+    std::atomic<int> calls{0};
+    std::atomic<int> errors{0};
+};
+
+void countCb(nixlXferReqH* req_hndl, nixl_status_t status, void* ctx) {
+    callbackCtx* cb_ctx = (callbackCtx*) ctx;
+    if (status != NIXL_SUCCESS)
+        cb_ctx->errors++;
+    cb_ctx->calls++;
+}
+
+// Reposts the request from its callback until reposts is reached
+struct repostCtx {
+    nixlAgent*       agent    = nullptr;
+    nixl_opt_args_t* params   = nullptr;
+    int              reposts  = 0;
+    int              calls    = 0;
+    int              depth    = 0;
+    int              maxDepth = 0;
+};
+
+void repostCb(nixlXferReqH* req_hndl, nixl_status_t status, void* ctx) {
+    repostCtx* cb_ctx = (repostCtx*) ctx;
+    cb_ctx->maxDepth = std::max(cb_ctx->maxDepth, ++cb_ctx->depth);
+    if (++cb_ctx->calls < cb_ctx->reposts) {
+        EXPECT_EQ(cb_ctx->agent->postXferReq(req_hndl, cb_ctx->params), NIXL_SUCCESS);
+    }
+    cb_ctx->depth--;
+}
+
+} // anonymous namespace
+
+TEST_F(XferReqTestFixture, CompletionCallback) {
+    nixlAgent agent = createAgent();
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    callbackCtx cb_ctx;
+    nixl_opt_args_t cb_params = extra_params;
+    cb_params.completionCb  = countCb;
+    cb_params.completionCtx = &cb_ctx;
+
+    // Either a queue or a callback
+    nixlXferCQ* cq = nullptr;
+    ASSERT_EQ(agent.createXferCQ(cq), NIXL_SUCCESS);
+    nixl_opt_args_t bad_params = cb_params;
+    bad_params.xferCQ = cq;
+
+    nixlXferReqH* req = createXferReq(agent, extra_params);
+    EXPECT_EQ(agent.postXferReq(req, &bad_params), NIXL_ERR_INVALID_PARAM);
+    EXPECT_EQ(agent.releaseXferCQ(cq), NIXL_SUCCESS);
+
+    EXPECT_EQ(agent.postXferReq(req, &cb_params), NIXL_SUCCESS);
+    while (cb_ctx.calls == 0)
+        agent.progressXfers();
+    EXPECT_EQ(cb_ctx.calls, 1);
+    EXPECT_EQ(cb_ctx.errors, 0);
+
+    // The request is back to the user once the callback is called
+    EXPECT_EQ(agent.progressXfers(), NIXL_SUCCESS);
+    EXPECT_EQ(cb_ctx.calls, 1);
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, CompletionCallbackProgress) {
+    nixlAgent agent = createAgent();
+    const int checks = 3;
+    nixl_b_params_t params = {{"xfer_checks", std::to_string(checks)}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+    registerMem(agent, extra_params);
+
+    callbackCtx cb_ctx;
+    nixl_opt_args_t cb_params = extra_params;
+    cb_params.completionCb  = countCb;
+    cb_params.completionCtx = &cb_ctx;
+
+    const int reqs_count = 4;
+    std::vector<nixlXferReqH*> reqs;
+    for (int i = 0; i < reqs_count; ++i) {
+        reqs.push_back(createXferReq(agent, extra_params));
+        EXPECT_EQ(agent.postXferReq(reqs.back(), &cb_params), NIXL_IN_PROG);
+        EXPECT_EQ(agent.postXferReq(reqs.back(), &cb_params), NIXL_ERR_REPOST_ACTIVE);
+    }
+
+    // Each progress checks the pending requests once
+    for (int i = 1; i < checks; ++i) {
+        EXPECT_EQ(agent.progressXfers(), NIXL_IN_PROG);
+        EXPECT_EQ(cb_ctx.calls, 0);
+    }
+    EXPECT_EQ(agent.progressXfers(), NIXL_SUCCESS);
+    EXPECT_EQ(cb_ctx.calls, reqs_count);
+    EXPECT_EQ(cb_ctx.errors, 0);
+
+    EXPECT_EQ(agent.releaseXferReqBatch(reqs), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, CompletionCallbackReposts) {
+    nixlAgent agent = createAgent();
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    repostCtx cb_ctx;
+    nixl_opt_args_t cb_params = extra_params;
+    cb_params.completionCb  = repostCb;
+    cb_params.completionCtx = &cb_ctx;
+    cb_ctx.agent   = &agent;
+    cb_ctx.params  = &cb_params;
+    cb_ctx.reposts = 10000;
+
+    // Done within each post, the callbacks of the reposts don't nest
+    nixlXferReqH* req = createXferReq(agent, extra_params);
+    EXPECT_EQ(agent.postXferReq(req, &cb_params), NIXL_SUCCESS);
+    EXPECT_EQ(cb_ctx.calls, cb_ctx.reposts);
+    EXPECT_EQ(cb_ctx.maxDepth, 1);
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, CompletionCallbackFromBackend) {
+    nixlAgent agent = createAgent();
+    nixl_b_params_t params = {{"xfer_cb", "true"}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+    registerMem(agent, extra_params);
+
+    callbackCtx cb_ctx;
+    nixl_opt_args_t cb_params = extra_params;
+    cb_params.completionCb  = countCb;
+    cb_params.completionCtx = &cb_ctx;
+
+    // Called from the backend thread, without progressXfers
+    const int reqs_count = 64;
+    std::vector<nixlXferReqH*> reqs;
+    for (int i = 0; i < reqs_count; ++i) {
+        reqs.push_back(createXferReq(agent, extra_params));
+        EXPECT_EQ(agent.postXferReq(reqs.back(), &cb_params), NIXL_IN_PROG);
+    }
+    while (cb_ctx.calls < reqs_count)
+        std::this_thread::yield();
+    EXPECT_EQ(cb_ctx.errors, 0);
+
+    EXPECT_EQ(agent.progressXfers(), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReqBatch(reqs), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, RangeIndices) {
+    nixlAgent agent = createAgent();
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    const int blocks = 16;
+    const size_t block_len = len / blocks;
+
+    nixlDescList<nixlBasicDesc> block_list(DRAM_SEG);
+    for (int i = 0; i < blocks; ++i)
+        block_list.addDesc(nixlBasicDesc(addr + i * block_len, block_len, dev_id));
+
+    nixlDlistH* local_side = nullptr;
+    nixlDlistH* remote_side = nullptr;
+    ASSERT_EQ(agent.prepXferDlist(NIXL_INIT_AGENT, block_list, local_side, &extra_params),
+              NIXL_SUCCESS);
+    ASSERT_EQ(agent.prepXferDlist(agent_name, block_list, remote_side, &extra_params),
+              NIXL_SUCCESS);
+
+    // Even blocks to odd blocks, and a run of consecutive ones
+    nixlXferReqH* req = nullptr;
+    nixl_idx_ranges_t local_ranges  = {nixlIdxRange(0, blocks / 2, 2),
+                                       nixlIdxRange(0, blocks / 2)};
+    nixl_idx_ranges_t remote_ranges = {nixlIdxRange(1, blocks / 2, 2),
+                                       nixlIdxRange(blocks / 2, blocks / 2)};
+    EXPECT_EQ(agent.makeXferReq(NIXL_WRITE, local_side, local_ranges,
+                                remote_side, remote_ranges, req, &extra_params),
+              NIXL_SUCCESS);
+    EXPECT_EQ(agent.postXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(agent.getXferStatus(req), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+
+    // Bounds are checked on the last index of each range
+    nixl_idx_ranges_t bad_ranges = {nixlIdxRange(1, blocks / 2 + 1, 2)};
+    EXPECT_EQ(agent.makeXferReq(NIXL_WRITE, local_side, bad_ranges,
+                                remote_side, bad_ranges, req, &extra_params),
+              NIXL_ERR_INVALID_PARAM);
+    EXPECT_EQ(req, nullptr);
+
+    // Ranges only go forward
+    for (int stride : {0, -1}) {
+        nixl_idx_ranges_t stride_ranges = {nixlIdxRange(blocks - 1, 2, stride)};
+        EXPECT_EQ(agent.makeXferReq(NIXL_WRITE, local_side, stride_ranges,
+                                    remote_side, stride_ranges, req, &extra_params),
+                  NIXL_ERR_INVALID_PARAM);
+        EXPECT_EQ(req, nullptr);
+    }
+
+    EXPECT_EQ(agent.releasedDlistH(local_side), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releasedDlistH(remote_side), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, CachedPlans) {
+    nixlAgentConfig cfg = createConfig();
+    cfg.planCacheSize = 4;
+    nixlAgent agent(agent_name, cfg);
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    const size_t reqs_count = 16;
+    for (size_t i = 0; i < reqs_count; ++i) {
+        nixlXferReqH* req = createXferReq(agent, extra_params);
+        EXPECT_EQ(agent.postXferReq(req), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    }
+
+    nixl_stats_t stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_plan.misses"], 1u);
+    EXPECT_EQ(stats["xfer_plan.hits"], reqs_count - 1);
+    EXPECT_EQ(stats["xfer_plan.entries"], 1u);
+
+    // The plan must not outlive the registration it points to
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    reg_list.addDesc(nixlBlobDesc(addr, len, dev_id, ""));
+    EXPECT_EQ(agent.deregisterMem(reg_list, &extra_params), NIXL_SUCCESS);
+
+    stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_plan.entries"], 0u);
+    EXPECT_EQ(stats["xfer_plan.invalidations"], 1u);
+
+    nixlXferReqH* req = nullptr;
+    EXPECT_NE(agent.createXferReq(NIXL_WRITE, xferList(), xferList(), agent_name,
+                                  req, &extra_params), NIXL_SUCCESS);
+}
+
+TEST_F(XferReqTestFixture, DescOptimization) {
+    nixlAgent agent = createAgent();
+    nixl_b_params_t params = {{"chunk_size", std::to_string(len / 4)}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+    registerMem(agent, extra_params);
+
+    const int blocks = 8;
+    const size_t block_len = len / blocks;
+
+    // Consecutive blocks in reverse order, merged once sorted and then split in 4
+    nixlDescList<nixlBasicDesc> block_list(DRAM_SEG);
+    for (int i = blocks - 1; i >= 0; --i)
+        block_list.addDesc(nixlBasicDesc(addr + i * block_len, block_len, dev_id));
+
+    // Kept as given unless merging is asked for
+    nixl_opt_args_t sort_params = extra_params;
+    sort_params.sortDescs = true;
+
+    nixlXferReqH* req = nullptr;
+    EXPECT_EQ(agent.createXferReq(NIXL_WRITE, block_list, block_list, agent_name,
+                                  req, &sort_params), NIXL_SUCCESS);
+    EXPECT_EQ(agent.postXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+
+    nixl_stats_t stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_descs.merged"], 0u);
+    EXPECT_EQ(stats["xfer_descs.split"], 0u);
+
+    sort_params.mergeDescs = true;
+    EXPECT_EQ(agent.createXferReq(NIXL_WRITE, block_list, block_list, agent_name,
+                                  req, &sort_params), NIXL_SUCCESS);
+    EXPECT_EQ(agent.postXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+
+    stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_descs.merged"], (uint64_t) blocks - 1);
+    EXPECT_EQ(stats["xfer_descs.split"], 3u);
+}
+
+TEST_F(XferReqTestFixture, BackendStats) {
+    nixlAgent agent = createAgent();
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    const int posts = 4;
+    nixlXferReqH* req = createXferReq(agent, extra_params);
+    for (int i = 0; i < posts; ++i)
+        EXPECT_EQ(agent.postXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+
+    EXPECT_EQ(getStats(agent)["backend.MOCK_DRAM.xfer_posts"], (uint64_t) posts);
+}
+
+TEST_F(XferReqTestFixture, CompletionSemantics) {
+    nixlAgent agent = createAgent();
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    // Given to the backend when the request is prepared
+    for (auto completion : {nixl_xfer_compl_t::NIXL_XFER_COMPL_LOCAL,
+                            nixl_xfer_compl_t::NIXL_XFER_COMPL_REMOTE_ALL,
+                            nixl_xfer_compl_t::NIXL_XFER_COMPL_DEFAULT}) {
+        nixl_opt_args_t compl_params = extra_params;
+        compl_params.completion = completion;
+        nixlXferReqH* req = createXferReq(agent, compl_params);
+        EXPECT_EQ(agent.postXferReq(req), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    }
+
+    EXPECT_EQ(getStats(agent)["backend.MOCK_DRAM.local_compl_preps"], 1u);
+}
+
+TEST_F(XferReqTestFixture, Striping) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* light = createBackend(agent);
+    nixlBackendH* heavy = nullptr;
+    nixl_b_params_t params = {{"stripe_weight", "3"}, {"notif", "true"}};
+    ASSERT_EQ(agent.createBackend("MOCK_DRAM_2", params, heavy), NIXL_SUCCESS);
+
+    nixl_opt_args_t extra_params;
+    extra_params.backends = {light, heavy};
+    extra_params.striping = true;
+
+    const size_t stripe_len = 256 * 1024;
+    registerMem(agent, extra_params, 0, 4 * stripe_len);
+
+    // Too small for two stripes, the heaviest backend carries it all in a plain
+    // request, which unlike a striped one takes a notification
+    nixlXferReqH* req = nullptr;
+    nixlBackendH* backend = nullptr;
+    nixl_opt_args_t notif_params;
+    notif_params.hasNotif = true;
+    notif_params.notifMsg = "done";
+    EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xferList(0, stripe_len), xferList(0, stripe_len),
+                                  agent_name, req, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(agent.queryXferBackend(req, backend), NIXL_SUCCESS);
+    EXPECT_EQ(backend, heavy);
+    EXPECT_EQ(agent.postXferReq(req, &notif_params), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+
+    nixl_stats_t stats = getStats(agent);
+    EXPECT_EQ(stats["backend.MOCK_DRAM.xfer_bytes"], 0u);
+    EXPECT_EQ(stats["backend.MOCK_DRAM_2.xfer_bytes"], stripe_len);
+    EXPECT_EQ(stats["backend.MOCK_DRAM_2.notif_posts"], 1u);
+
+    // Split by their weights
+    req = nullptr;
+    EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xferList(0, 4 * stripe_len),
+                                  xferList(0, 4 * stripe_len), agent_name, req, &extra_params),
+              NIXL_SUCCESS);
+    EXPECT_EQ(agent.postXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+
+    stats = getStats(agent);
+    EXPECT_EQ(stats["backend.MOCK_DRAM.xfer_bytes"], stripe_len);
+    EXPECT_EQ(stats["backend.MOCK_DRAM_2.xfer_bytes"], 4 * stripe_len);
+}
+
+TEST_F(XferReqTestFixture, StripingPartialFailure) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* failing = nullptr;
+    nixlBackendH* slow    = nullptr;
+    nixl_b_params_t failing_params = {{"post_fail_at", "1"}};
+    nixl_b_params_t slow_params    = {{"xfer_checks", "3"}};
+    ASSERT_EQ(agent.createBackend("MOCK_DRAM", failing_params, failing), NIXL_SUCCESS);
+    ASSERT_EQ(agent.createBackend("MOCK_DRAM_2", slow_params, slow), NIXL_SUCCESS);
+
+    nixl_opt_args_t extra_params;
+    extra_params.backends = {failing, slow};
+    extra_params.striping = true;
+
+    const size_t stripe_len = 256 * 1024;
+    registerMem(agent, extra_params, 0, 2 * stripe_len);
+
+    nixlXferReqH* req = nullptr;
+    ASSERT_EQ(agent.createXferReq(NIXL_WRITE, xferList(0, 2 * stripe_len),
+                                  xferList(0, 2 * stripe_len), agent_name, req, &extra_params),
+              NIXL_SUCCESS);
+
+    // One stripe failed while the other is still in flight, so it can't be reposted yet
+    EXPECT_EQ(agent.postXferReq(req), NIXL_ERR_BACKEND);
+    EXPECT_EQ(agent.postXferReq(req), NIXL_ERR_REPOST_ACTIVE);
+    EXPECT_EQ(getStats(agent)["backend.MOCK_DRAM_2.xfer_posts"], 1u);
+
+    nixl_status_t ret;
+    while ((ret = agent.getXferStatus(req)) == NIXL_IN_PROG);
+    EXPECT_EQ(agent.postXferReq(req), NIXL_IN_PROG);
+    while ((ret = agent.getXferStatus(req)) == NIXL_IN_PROG);
+    EXPECT_EQ(ret, NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+}
+
+} // namespace xfer_req
+} // namespace gtest
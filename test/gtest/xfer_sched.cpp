@@ -0,0 +1,204 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <thread>
+#include "agent_fixture.h"
+
+namespace gtest {
+namespace xfer_sched {
+
+class XferSchedTestFixture : public AgentTestFixture {
+protected:
+    const std::string agent_name = "test_agent";
+
+    nixlXferReqH* createXferReq(nixlAgent &agent, const nixl_opt_args_t &extra_params) {
+        nixlXferReqH* req = nullptr;
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xferList(), xferList(), agent_name,
+                                      req, &extra_params), NIXL_SUCCESS);
+        return req;
+    }
+};
+
+namespace {
+
+// Order in which the completion callbacks are called
+void orderCb(nixlXferReqH* req_hndl, nixl_status_t status, void* ctx) {
+    EXPECT_EQ(status, NIXL_SUCCESS);
+    ((std::vector<nixlXferReqH*>*) ctx)->push_back(req_hndl);
+}
+
+} // anonymous namespace
+
+TEST_F(XferSchedTestFixture, PriorityClasses) {
+    nixlAgentConfig cfg = createConfig();
+    cfg.prioHoldBytes = len;
+    nixlAgent agent(agent_name, cfg);
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    const size_t reqs_count = 8;
+    for (auto prio : {nixl_xfer_prio_t::NIXL_XFER_PRIO_HIGH,
+                      nixl_xfer_prio_t::NIXL_XFER_PRIO_BULK}) {
+        nixl_opt_args_t prio_params = extra_params;
+        prio_params.priority = prio;
+
+        for (size_t i = 0; i < reqs_count; ++i) {
+            nixlXferReqH* req = createXferReq(agent, prio_params);
+            EXPECT_EQ(agent.postXferReq(req), NIXL_SUCCESS);
+            EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+        }
+    }
+
+    nixl_stats_t stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_sched.high.posts"], reqs_count);
+    EXPECT_EQ(stats["xfer_sched.bulk.posts"], reqs_count);
+    EXPECT_EQ(stats["xfer_sched.high.held"], 0u);
+    EXPECT_EQ(stats["xfer_sched.bulk.queued"], 0u);
+    EXPECT_EQ(stats["xfer_sched.bulk.inflight_bytes"], 0u);
+}
+
+TEST_F(XferSchedTestFixture, HeldBehindHigherClass) {
+    nixlAgentConfig cfg = createConfig();
+    cfg.prioHoldBytes = len / 2;
+    nixlAgent agent(agent_name, cfg);
+    nixl_b_params_t params = {{"xfer_checks", "1"}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+    registerMem(agent, extra_params);
+
+    std::vector<nixlXferReqH*> order;
+    auto post = [&](const nixl_xfer_prio_t prio) {
+        nixl_opt_args_t prio_params = extra_params;
+        prio_params.priority = prio;
+        nixlXferReqH* req = createXferReq(agent, prio_params);
+        prio_params.completionCb  = orderCb;
+        prio_params.completionCtx = &order;
+        EXPECT_EQ(agent.postXferReq(req, &prio_params), NIXL_IN_PROG);
+        return req;
+    };
+
+    // While the high one is in flight, the others are over the hold limit
+    nixlXferReqH* high  = post(nixl_xfer_prio_t::NIXL_XFER_PRIO_HIGH);
+    nixlXferReqH* bulk1 = post(nixl_xfer_prio_t::NIXL_XFER_PRIO_BULK);
+    nixlXferReqH* norm  = post(nixl_xfer_prio_t::NIXL_XFER_PRIO_NORMAL);
+    nixlXferReqH* bulk2 = post(nixl_xfer_prio_t::NIXL_XFER_PRIO_BULK);
+
+    nixl_stats_t stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_sched.high.inflight_reqs"], 1u);
+    EXPECT_EQ(stats["xfer_sched.normal.queued"], 1u);
+    EXPECT_EQ(stats["xfer_sched.bulk.queued"], 2u);
+
+    const uint64_t held_us = 2000;
+    std::this_thread::sleep_for(std::chrono::microseconds(held_us));
+
+    // Each class is issued once the higher ones are done
+    while (agent.progressXfers() == NIXL_IN_PROG);
+    EXPECT_EQ(order, (std::vector<nixlXferReqH*>{high, norm, bulk1, bulk2}));
+
+    stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_sched.high.held"], 0u);
+    EXPECT_EQ(stats["xfer_sched.normal.held"], 1u);
+    EXPECT_EQ(stats["xfer_sched.bulk.held"], 2u);
+    EXPECT_EQ(stats["xfer_sched.high.queue_delay_us"], 0u);
+    EXPECT_GE(stats["xfer_sched.normal.queue_delay_max_us"], held_us);
+    EXPECT_GE(stats["xfer_sched.bulk.queue_delay_max_us"], held_us);
+    EXPECT_GE(stats["xfer_sched.bulk.queue_delay_us"], 2 * held_us);
+    EXPECT_GE(stats["xfer_sched.bulk.queue_delay_max_us"],
+              stats["xfer_sched.normal.queue_delay_max_us"]);
+
+    EXPECT_EQ(agent.releaseXferReqBatch(order), NIXL_SUCCESS);
+}
+
+TEST_F(XferSchedTestFixture, InflightLimits) {
+    nixlAgentConfig cfg = createConfig();
+    cfg.remoteMaxReqs = 1;
+    cfg.totalMaxBytes = len;
+    nixlAgent agent(agent_name, cfg);
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent));
+    registerMem(agent, extra_params);
+
+    // Posts over the limits are held and issued from the status checks
+    const size_t reqs_count = 8;
+    std::vector<nixlXferReqH*> reqs;
+    std::vector<nixl_status_t> status;
+    for (size_t i = 0; i < reqs_count; ++i)
+        reqs.push_back(createXferReq(agent, extra_params));
+
+    EXPECT_GE(agent.postXferReqBatch(reqs, status), 0);
+    while (agent.getXferStatusBatch(reqs, status) == NIXL_IN_PROG);
+    EXPECT_EQ(agent.getXferStatusBatch(reqs, status), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReqBatch(reqs), NIXL_SUCCESS);
+
+    nixl_stats_t stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_sched.normal.posts"], reqs_count);
+    EXPECT_EQ(stats["xfer_sched.inflight_reqs"], 0u);
+    EXPECT_EQ(stats["xfer_sched.remote.test_agent.queued"], 0u);
+    // Only the ones held by the limits, not the ones queued behind them
+    EXPECT_GT(stats["xfer_sched.throttled"], 0u);
+    EXPECT_LT(stats["xfer_sched.throttled"], reqs_count);
+    EXPECT_GT(stats["xfer_sched.remote.test_agent.throttled"], 0u);
+}
+
+TEST_F(XferSchedTestFixture, HeldBehindHigherClassToOtherAgent) {
+    const std::string target_name = "target_agent";
+    nixlAgent target(target_name, createConfig());
+    registerMem(target, createExtraParams(createBackend(target)));
+
+    nixlAgentConfig cfg = createConfig();
+    cfg.remoteMaxReqs = 1;
+    nixlAgent agent(agent_name, cfg);
+    nixl_b_params_t params = {{"xfer_checks", "1"}};
+    nixl_opt_args_t extra_params = createExtraParams(createBackend(agent, params));
+    registerMem(agent, extra_params);
+
+    nixl_blob_t md;
+    std::string name;
+    EXPECT_EQ(target.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(agent.loadRemoteMD(md, name), NIXL_SUCCESS);
+
+    std::vector<nixlXferReqH*> order;
+    auto post = [&](const nixl_xfer_prio_t prio, const std::string &remote_name) {
+        nixl_opt_args_t prio_params = extra_params;
+        prio_params.priority = prio;
+        nixlXferReqH* req = nullptr;
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xferList(), xferList(), remote_name,
+                                      req, &prio_params), NIXL_SUCCESS);
+        prio_params.completionCb  = orderCb;
+        prio_params.completionCtx = &order;
+        EXPECT_EQ(agent.postXferReq(req, &prio_params), NIXL_IN_PROG);
+        return req;
+    };
+
+    // The second one is throttled by its agent, the bulk one is to an idle agent
+    nixlXferReqH* high1 = post(nixl_xfer_prio_t::NIXL_XFER_PRIO_HIGH, target_name);
+    nixlXferReqH* high2 = post(nixl_xfer_prio_t::NIXL_XFER_PRIO_HIGH, target_name);
+    nixlXferReqH* bulk  = post(nixl_xfer_prio_t::NIXL_XFER_PRIO_BULK, agent_name);
+
+    nixl_stats_t stats = getStats(agent);
+    EXPECT_EQ(stats["xfer_sched.high.queued"], 1u);
+    EXPECT_EQ(stats["xfer_sched.bulk.queued"], 1u);
+
+    while (agent.progressXfers() == NIXL_IN_PROG);
+    EXPECT_EQ(order, (std::vector<nixlXferReqH*>{high1, high2, bulk}));
+    EXPECT_EQ(agent.releaseXferReqBatch(order), NIXL_SUCCESS);
+
+    // Dropped with the metadata of the agent
+    EXPECT_EQ(getStats(agent).count("xfer_sched.remote.target_agent.inflight_reqs"), 1u);
+    EXPECT_EQ(agent.invalidateRemoteMD(target_name), NIXL_SUCCESS);
+    EXPECT_EQ(getStats(agent).count("xfer_sched.remote.target_agent.inflight_reqs"), 0u);
+}
+
+} // namespace xfer_sched
+} // namespace gtest
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "nixl.h"
+#include "mem_section.h"
+
+#include <sys/time.h>
+
+// Compares the section index against the sorted descriptor list it replaced,
+// for registering, looking up and deregistering many regions.
+
+static const size_t region_len = 64 * 1024;
+static const int    dev_count  = 4;
+
+static float elapsedUs(const struct timeval &start_time) {
+    struct timeval end_time, diff_time;
+    gettimeofday(&end_time, NULL);
+    timersub(&end_time, &start_time, &diff_time);
+    return (diff_time.tv_sec * 1000000) + diff_time.tv_usec;
+}
+
+// The sorted vector path, as nixlMemSection::populate did for unsorted queries
+static const nixlSectionDesc* vectorCover(const nixl_sec_dlist_t &base,
+                                          const nixlBasicDesc &query) {
+    auto itr = std::lower_bound(base.begin(), base.end(), query);
+    if ((itr != base.end()) && itr->covers(query))
+        return &(*itr);
+    if (itr != base.begin()) {
+        itr = std::prev(itr, 1);
+        if (itr->covers(query))
+            return &(*itr);
+    }
+    return nullptr;
+}
+
+void testPerf(const int region_count, const int query_count) {
+    std::mt19937 gen(region_count);
+    std::vector<nixlSectionDesc> regions(region_count);
+    for (int i = 0; i < region_count; ++i) {
+        regions[i].addr  = 0x10000000 + (uintptr_t) (i / dev_count) * region_len;
+        regions[i].len   = region_len;
+        regions[i].devId = i % dev_count;
+    }
+    std::shuffle(regions.begin(), regions.end(), gen);
+
+    std::vector<nixlBasicDesc> queries(query_count);
+    std::uniform_int_distribution<int> pick(0, region_count - 1);
+    for (auto &q : queries) {
+        const nixlSectionDesc &r = regions[pick(gen)];
+        q = nixlBasicDesc(r.addr + region_len / 4, region_len / 2, r.devId);
+    }
+
+    struct timeval start_time;
+    float add_us, query_us, rem_us;
+    int found;
+
+    std::cout << region_count << " regions, " << query_count << " queries\n";
+
+    nixl_sec_dlist_t dlist(DRAM_SEG, true);
+
+    gettimeofday(&start_time, NULL);
+    for (auto &r : regions)
+        dlist.addDesc(r);
+    add_us = elapsedUs(start_time);
+
+    gettimeofday(&start_time, NULL);
+    found = 0;
+    for (auto &q : queries)
+        found += (vectorCover(dlist, q) != nullptr);
+    query_us = elapsedUs(start_time);
+    assert(found == query_count);
+
+    gettimeofday(&start_time, NULL);
+    for (auto &r : regions)
+        dlist.remDesc(dlist.getIndex(r));
+    rem_us = elapsedUs(start_time);
+    assert(dlist.descCount() == 0);
+
+    std::cout << "  sorted list: add " << add_us << "us, query " << query_us
+              << "us, remove " << rem_us << "us\n";
+
+    nixlSectionIndex index(DRAM_SEG);
+
+    gettimeofday(&start_time, NULL);
+    for (auto &r : regions)
+        index.addDesc(r);
+    add_us = elapsedUs(start_time);
+
+    gettimeofday(&start_time, NULL);
+    found = 0;
+    for (auto &q : queries)
+        found += (index.cover(q) != nullptr);
+    query_us = elapsedUs(start_time);
+    assert(found == query_count);
+
+    gettimeofday(&start_time, NULL);
+    for (auto &r : regions)
+        index.remDesc(r);
+    rem_us = elapsedUs(start_time);
+    assert(index.isEmpty());
+
+    std::cout << "  index:       add " << add_us << "us, query " << query_us
+              << "us, remove " << rem_us << "us\n";
+}
+
+int main()
+{
+    for (int region_count : {1024, 16 * 1024, 64 * 1024})
+        testPerf(region_count, 256 * 1024);
+
+    return 0;
+}
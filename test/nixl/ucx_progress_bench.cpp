@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include "nixl.h"
+
+#include <time.h>
+
+// Compares the progress modes of the UCX backend: the CPU used by the progress
+// threads of two idle agents, and the latency for a notification to reach an
+// agent whose progress thread went idle.
+
+static const int  idle_ms    = 1000;
+static const int  iter_count = 200;
+static const auto sleep_time = std::chrono::milliseconds(5);
+
+// Checked also in release builds, where the results would be meaningless
+static void checkStatus(const nixl_status_t ret, const char *message) {
+    if (ret != NIXL_SUCCESS) {
+        std::cerr << message << ": " << nixlEnumStrings::statusStr(ret) << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+static double cpuUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+static double wallUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+void testMode(const std::string &mode) {
+    std::string agent1("Agent001");
+    std::string agent2("Agent002");
+    std::string ret_s;
+
+    nixlAgentConfig cfg(true);
+    nixlAgent A1(agent1, cfg);
+    nixlAgent A2(agent2, cfg);
+
+    nixl_b_params_t params;
+    nixl_mem_list_t mems;
+    checkStatus(A1.getPluginParams("UCX", mems, params), "Getting UCX params failed");
+    params["progress_mode"] = mode;
+
+    nixlBackendH *ucx1, *ucx2;
+    checkStatus(A1.createBackend("UCX", params, ucx1), "Creating UCX backend failed");
+    checkStatus(A2.createBackend("UCX", params, ucx2), "Creating UCX backend failed");
+
+    // Notifications need the metadata of the remote agent
+    std::vector<char> buf(4096);
+    nixl_reg_dlist_t dlist(DRAM_SEG);
+    dlist.addDesc(nixlBlobDesc((uintptr_t) buf.data(), buf.size(), 0));
+    checkStatus(A1.registerMem(dlist), "Registering memory failed");
+    checkStatus(A2.registerMem(dlist), "Registering memory failed");
+
+    std::string meta2;
+    checkStatus(A2.getLocalMD(meta2), "Getting metadata failed");
+    checkStatus(A1.loadRemoteMD(meta2, ret_s), "Loading metadata failed");
+
+    std::cout << "progress_mode=" << mode << "\n";
+
+    double cpu_start  = cpuUs();
+    double wall_start = wallUs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(idle_ms));
+    double cpu_pct = 100.0 * (cpuUs() - cpu_start) / (wallUs() - wall_start);
+
+    std::cout << "  idle CPU (2 agents): " << cpu_pct << "%\n";
+
+    std::vector<double> lat(iter_count);
+    nixl_notifs_t notif_map;
+    for (auto &l : lat) {
+        // Long enough for the progress thread to go idle
+        std::this_thread::sleep_for(sleep_time);
+
+        double start = wallUs();
+        checkStatus(A1.genNotif(agent2, "wakeup"), "Sending notification failed");
+
+        notif_map.clear();
+        while (notif_map.empty()) {
+            checkStatus(A2.getNotifs(notif_map), "Getting notifications failed");
+        }
+        l = wallUs() - start;
+    }
+    std::sort(lat.begin(), lat.end());
+
+    std::cout << "  notification latency after idle: min " << lat.front()
+              << "us, median " << lat[iter_count / 2]
+              << "us, p99 " << lat[iter_count * 99 / 100] << "us\n";
+
+    A1.invalidateRemoteMD(agent2);
+    A1.deregisterMem(dlist);
+    A2.deregisterMem(dlist);
+}
+
+int main()
+{
+    for (const std::string mode : {"poll", "adaptive"})
+        testMode(mode);
+
+    return 0;
+}
@@ -17,7 +17,12 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <cstring>
 #include <cassert>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
 
 #include "ucx_backend.h"
 
@@ -107,12 +112,14 @@ public:
 };
 
 
-nixlBackendEngine *createEngine(std::string name, bool p_thread)
+nixlBackendEngine *createEngine(std::string name, bool p_thread, int num_workers = 1)
 {
     nixlBackendEngine     *ucx;
     nixlBackendInitParams init;
     nixl_b_params_t       custom_params;
 
+    custom_params["num_workers"] = std::to_string(num_workers);
+
     init.enableProgTh = p_thread;
     init.pthrDelay    = 100;
     init.localAgent   = name;
@@ -671,6 +678,314 @@ void test_inter_agent_transfer(bool p_thread, bool reuse_hndl,
     //ucx2->disconnect(agent1);
 }
 
+uint64_t getStat(nixlBackendEngine *ucx, const std::string &key)
+{
+    nixl_stats_t stats;
+    ucx->getStats(stats);
+    return stats[key];
+}
+
+void test_pool_reuse(nixlBackendEngine *ucx1, nixlBackendEngine *ucx2)
+{
+    std::cout << std::endl << "Pool reuse test" << std::endl;
+
+    // Warm-up, after which the pools have what the same transfers use
+    test_inter_agent_transfer(false, false, ucx1, DRAM_SEG, 0, ucx2, DRAM_SEG, 0);
+
+    uint64_t req_hits     = getStat(ucx1, "req_h_pool.hits");
+    uint64_t req_misses   = getStat(ucx1, "req_h_pool.misses");
+    uint64_t notif_hits   = getStat(ucx1, "notif_buf_pool.hits");
+
+    test_inter_agent_transfer(false, false, ucx1, DRAM_SEG, 0, ucx2, DRAM_SEG, 0);
+
+    // A handle per transfer (2 ops, with and without notification, 10 iterations),
+    // and a notification buffer for half of them
+    uint64_t req_got   = getStat(ucx1, "req_h_pool.hits") - req_hits;
+    uint64_t notif_got = getStat(ucx1, "notif_buf_pool.hits") - notif_hits;
+    if ((getStat(ucx1, "req_h_pool.misses") != req_misses) ||
+        (req_got != 40) || (notif_got < 20)) {
+        std::cout << "Pools not reused after the warm-up: " << req_got << " handles, "
+                  << notif_got << " notification buffers" << std::endl;
+        exit(1);
+    }
+    std::cout << "Pools reused: " << req_got << " handles, "
+              << notif_got << " notification buffers" << std::endl;
+}
+
+nixl_status_t waitXfer(nixlBackendEngine *ucx1, nixlBackendEngine *ucx2,
+                       nixlBackendReqH *handle, nixl_status_t ret)
+{
+    while (ret == NIXL_IN_PROG) {
+        ret = ucx1->checkXfer(handle);
+        ucx2->progress();
+    }
+    return ret;
+}
+
+void test_xfer_completion(nixlBackendEngine *ucx1, nixlBackendEngine *ucx2)
+{
+    std::cout << std::endl << "Transfer completion test" << std::endl;
+
+    std::string agent2("Agent2");
+    std::string conn_info2;
+    nixl_status_t ret;
+
+    ret = ucx2->getConnInfo(conn_info2);
+    assert(ret == NIXL_SUCCESS);
+    ret = ucx1->loadRemoteConnInfo(agent2, conn_info2);
+    assert(ret == NIXL_SUCCESS);
+
+    int desc_cnt = 64;
+    size_t desc_size = 1 * 1024 * 1024;
+    size_t len = desc_cnt * desc_size;
+
+    void *addr1 = NULL, *addr2 = NULL;
+    nixlBackendMD *lmd1, *lmd2, *rmd1;
+    allocateAndRegister(ucx1, 0, DRAM_SEG, addr1, len, lmd1);
+    allocateAndRegister(ucx2, 0, DRAM_SEG, addr2, len, lmd2);
+    loadRemote(ucx1, 0, agent2, DRAM_SEG, addr2, len, lmd2, rmd1);
+
+    nixl_meta_dlist_t src_descs(DRAM_SEG), dst_descs(DRAM_SEG);
+    populateDescs(src_descs, 0, addr1, desc_cnt, desc_size, lmd1);
+    populateDescs(dst_descs, 0, addr2, desc_cnt, desc_size, rmd1);
+
+    // All the descs are done before the transfer is, also when the handle is reposted
+    nixlBackendReqH *handle = nullptr;
+    ret = ucx1->prepXfer(NIXL_WRITE, src_descs, dst_descs, agent2, handle);
+    assert(ret == NIXL_SUCCESS);
+    for (char byte : {(char) 0xbb, (char) 0xcc}) {
+        doMemset(DRAM_SEG, 0, addr1, byte, len);
+        doMemset(DRAM_SEG, 0, addr2, 0, len);
+        ret = ucx1->postXfer(NIXL_WRITE, src_descs, dst_descs, agent2, handle);
+        ret = waitXfer(ucx1, ucx2, handle, ret);
+        if (ret != NIXL_SUCCESS || memcmp(addr1, addr2, len) != 0) {
+            std::cout << "Multi-desc transfer failed: " << ret << std::endl;
+            exit(1);
+        }
+    }
+    ucx1->releaseReqH(handle);
+
+    // Released in flight, the operations are cancelled and the handle gets back
+    // to the pool once they completed
+    uint64_t free_cnt = getStat(ucx1, "req_h_pool.free");
+    ret = ucx1->prepXfer(NIXL_READ, src_descs, dst_descs, agent2, handle);
+    assert(ret == NIXL_SUCCESS);
+    ret = ucx1->postXfer(NIXL_READ, src_descs, dst_descs, agent2, handle);
+    if (ret != NIXL_SUCCESS && ret != NIXL_IN_PROG) {
+        std::cout << "Posting the transfer failed: " << ret << std::endl;
+        exit(1);
+    }
+    std::cout << "Released " << (ret == NIXL_IN_PROG ? "in flight" : "after completion")
+              << std::endl;
+    ucx1->releaseReqH(handle);
+    while (getStat(ucx1, "req_h_pool.free") != free_cnt) {
+        ucx1->progress();
+        ucx2->progress();
+    }
+
+    // The cancelled completions report an error, which the handle doesn't keep
+    // when reused from the pool
+    uint64_t hits = getStat(ucx1, "req_h_pool.hits");
+    ret = ucx1->prepXfer(NIXL_READ, src_descs, dst_descs, agent2, handle);
+    assert(ret == NIXL_SUCCESS);
+    ret = ucx1->postXfer(NIXL_READ, src_descs, dst_descs, agent2, handle);
+    ret = waitXfer(ucx1, ucx2, handle, ret);
+    if (ret != NIXL_SUCCESS || getStat(ucx1, "req_h_pool.hits") != hits + 1) {
+        std::cout << "Transfer on a reused handle failed: " << ret << std::endl;
+        exit(1);
+    }
+    ucx1->releaseReqH(handle);
+
+    ucx1->unloadMD(rmd1);
+    deallocateAndDeregister(ucx1, 0, DRAM_SEG, addr1, lmd1);
+    deallocateAndDeregister(ucx2, 0, DRAM_SEG, addr2, lmd2);
+    ucx1->disconnect(agent2);
+    std::cout << "OK" << std::endl;
+}
+
+void test_flush_selection(nixlBackendEngine *ucx1, nixlBackendEngine *ucx2)
+{
+    std::cout << std::endl << "Flush selection test" << std::endl;
+
+    struct {
+        nixl_xfer_compl_t completion;
+        nixl_xfer_op_t    op;
+        bool              use_notif;
+        uint64_t          ep_flushes;
+        uint64_t          worker_flushes;
+    } cases[] = {
+        // Local completion flushes only ahead of a notification
+        {nixl_xfer_compl_t::NIXL_XFER_COMPL_LOCAL,          NIXL_WRITE, false, 0, 0},
+        {nixl_xfer_compl_t::NIXL_XFER_COMPL_LOCAL,          NIXL_WRITE, true,  1, 0},
+        // The endpoint the transfer used, not needed by a read
+        {nixl_xfer_compl_t::NIXL_XFER_COMPL_REMOTE_TARGETS, NIXL_WRITE, false, 1, 0},
+        {nixl_xfer_compl_t::NIXL_XFER_COMPL_REMOTE_TARGETS, NIXL_READ,  false, 0, 0},
+        // The whole worker
+        {nixl_xfer_compl_t::NIXL_XFER_COMPL_REMOTE_ALL,     NIXL_WRITE, false, 0, 1},
+        {nixl_xfer_compl_t::NIXL_XFER_COMPL_REMOTE_ALL,     NIXL_READ,  true,  0, 1},
+    };
+
+    std::string agent2("Agent2");
+    std::string conn_info2;
+    nixl_status_t ret;
+
+    ret = ucx2->getConnInfo(conn_info2);
+    assert(ret == NIXL_SUCCESS);
+    ret = ucx1->loadRemoteConnInfo(agent2, conn_info2);
+    assert(ret == NIXL_SUCCESS);
+
+    int desc_cnt = 16;
+    size_t desc_size = 64 * 1024;
+    size_t len = desc_cnt * desc_size;
+
+    void *addr1 = NULL, *addr2 = NULL;
+    nixlBackendMD *lmd1, *lmd2, *rmd1;
+    allocateAndRegister(ucx1, 0, DRAM_SEG, addr1, len, lmd1);
+    allocateAndRegister(ucx2, 0, DRAM_SEG, addr2, len, lmd2);
+    loadRemote(ucx1, 0, agent2, DRAM_SEG, addr2, len, lmd2, rmd1);
+
+    nixl_meta_dlist_t src_descs(DRAM_SEG), dst_descs(DRAM_SEG);
+    populateDescs(src_descs, 0, addr1, desc_cnt, desc_size, lmd1);
+    populateDescs(dst_descs, 0, addr2, desc_cnt, desc_size, rmd1);
+
+    for (auto &c : cases) {
+        nixl_opt_b_args_t opt_args;
+        opt_args.completion = c.completion;
+        opt_args.hasNotif   = c.use_notif;
+        opt_args.notifMsg   = "flush";
+
+        std::cout << "\t" << op2string(c.op, c.use_notif) << ", completion "
+                  << (int) c.completion << ": " << flush;
+
+        doMemset(DRAM_SEG, 0, addr1, 0xbb, len);
+        doMemset(DRAM_SEG, 0, addr2, 0xda, len);
+
+        uint64_t ep_flushes     = getStat(ucx1, "flush.ep");
+        uint64_t worker_flushes = getStat(ucx1, "flush.worker");
+
+        nixlBackendReqH *handle = nullptr;
+        ret = ucx1->prepXfer(c.op, src_descs, dst_descs, agent2, handle, &opt_args);
+        assert(ret == NIXL_SUCCESS);
+        ret = ucx1->postXfer(c.op, src_descs, dst_descs, agent2, handle, &opt_args);
+        ret = waitXfer(ucx1, ucx2, handle, ret);
+        ucx1->releaseReqH(handle);
+
+        if (ret != NIXL_SUCCESS ||
+            getStat(ucx1, "flush.ep") - ep_flushes != c.ep_flushes ||
+            getStat(ucx1, "flush.worker") - worker_flushes != c.worker_flushes) {
+            std::cout << "FAILED (" << ret << ")" << std::endl;
+            exit(1);
+        }
+
+        if (c.use_notif) {
+            notif_list_t target_notifs;
+            while (target_notifs.empty()) {
+                ucx2->getNotifs(target_notifs);
+                ucx1->progress();
+            }
+        }
+
+        // Local completion of a write doesn't wait for the target, as the others do
+        if (c.completion == nixl_xfer_compl_t::NIXL_XFER_COMPL_LOCAL) {
+            while (memcmp(addr1, addr2, len) != 0) {
+                ucx1->progress();
+                ucx2->progress();
+            }
+        } else if (memcmp(addr1, addr2, len) != 0) {
+            std::cout << "FAILED (data)" << std::endl;
+            exit(1);
+        }
+        std::cout << "OK" << std::endl;
+    }
+
+    ucx1->unloadMD(rmd1);
+    deallocateAndDeregister(ucx1, 0, DRAM_SEG, addr1, lmd1);
+    deallocateAndDeregister(ucx2, 0, DRAM_SEG, addr2, lmd2);
+    ucx1->disconnect(agent2);
+}
+
+// Transfers of one thread on its own buffers, which count the bytes moved
+void multiWorkerThread(nixlBackendEngine *ucx1, nixlBackendEngine *ucx2,
+                       int iter, std::atomic<size_t> &bytes)
+{
+    std::string agent2("Agent2");
+    nixl_status_t ret;
+
+    int desc_cnt = 16;
+    size_t desc_size = 1 * 1024 * 1024;
+    size_t len = desc_cnt * desc_size;
+
+    void *addr1 = NULL, *addr2 = NULL;
+    nixlBackendMD *lmd1, *lmd2, *rmd1;
+    allocateAndRegister(ucx1, 0, DRAM_SEG, addr1, len, lmd1);
+    allocateAndRegister(ucx2, 0, DRAM_SEG, addr2, len, lmd2);
+    loadRemote(ucx1, 0, agent2, DRAM_SEG, addr2, len, lmd2, rmd1);
+
+    nixl_meta_dlist_t src_descs(DRAM_SEG), dst_descs(DRAM_SEG);
+    populateDescs(src_descs, 0, addr1, desc_cnt, desc_size, lmd1);
+    populateDescs(dst_descs, 0, addr2, desc_cnt, desc_size, rmd1);
+
+    doMemset(DRAM_SEG, 0, addr1, 0xbb, len);
+    doMemset(DRAM_SEG, 0, addr2, 0xda, len);
+
+    nixlBackendReqH *handle = nullptr;
+    ret = ucx1->prepXfer(NIXL_WRITE, src_descs, dst_descs, agent2, handle);
+    assert(ret == NIXL_SUCCESS);
+    for (int k = 0; k < iter; k++) {
+        ret = ucx1->postXfer(NIXL_WRITE, src_descs, dst_descs, agent2, handle);
+        ret = waitXfer(ucx1, ucx2, handle, ret);
+        if (ret != NIXL_SUCCESS) {
+            std::cout << "Transfer failed: " << ret << std::endl;
+            exit(1);
+        }
+        bytes += len;
+    }
+    ucx1->releaseReqH(handle);
+
+    if (memcmp(addr1, addr2, len) != 0) {
+        std::cout << "Data verification failed" << std::endl;
+        exit(1);
+    }
+
+    ucx1->unloadMD(rmd1);
+    deallocateAndDeregister(ucx1, 0, DRAM_SEG, addr1, lmd1);
+    deallocateAndDeregister(ucx2, 0, DRAM_SEG, addr2, lmd2);
+}
+
+void test_multi_worker_transfer(nixlBackendEngine *ucx1, nixlBackendEngine *ucx2,
+                                int n_threads)
+{
+    std::cout << std::endl << "Multi-worker transfer test: "
+              << n_threads << " threads" << std::endl;
+
+    std::string agent2("Agent2");
+    std::string conn_info2;
+    nixl_status_t ret;
+
+    ret = ucx2->getConnInfo(conn_info2);
+    assert(ret == NIXL_SUCCESS);
+    ret = ucx1->loadRemoteConnInfo(agent2, conn_info2);
+    assert(ret == NIXL_SUCCESS);
+
+    // All the threads run at once, each posting on the worker it is bound to
+    std::atomic<size_t> bytes{0};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n_threads; i++) {
+        threads.emplace_back(multiWorkerThread, ucx1, ucx2, 100, std::ref(bytes));
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "\t" << bytes / (1024 * 1024) << "MB in " << elapsed.count() * 1000
+              << "ms, " << bytes / elapsed.count() / (1024 * 1024 * 1024) << "GB/s"
+              << std::endl;
+
+    ucx1->disconnect(agent2);
+}
+
 int main()
 {
     bool thread_on[2] = {false, true};
@@ -733,6 +1048,22 @@ int main()
 #endif
     }
 
+    test_pool_reuse(ucx[0][0], ucx[0][1]);
+    test_xfer_completion(ucx[0][0], ucx[0][1]);
+    test_flush_selection(ucx[0][0], ucx[0][1]);
+
+    // Engines with several workers, and fewer workers on the remote side.
+    // Each thread posts on another worker.
+    nixlBackendEngine *ucx_mw[2];
+    ucx_mw[0] = createEngine("Agent1", false, 4);
+    ucx_mw[1] = createEngine("Agent2", false, 2);
+
+    test_multi_worker_transfer(ucx_mw[0], ucx_mw[1], 4);
+
+    for(int i = 0; i < 2; i++) {
+        releaseEngine(ucx_mw[i]);
+    }
+
 #ifdef HAVE_CUDA
     if (n_vram_dev > 1) {
 		//Test if registering on a different GPU fails correctly
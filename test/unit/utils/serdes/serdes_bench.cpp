@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include "nixl.h"
+#include "serdes/serdes.h"
+
+#include <sys/time.h>
+
+// Bytes and time per descriptor for a metadata sized descriptor list,
+// in the tagged string and the binary format.
+
+static const size_t meta_len = 64;
+static const int    reps     = 10;
+
+static float elapsedUs(const struct timeval &start_time) {
+    struct timeval end_time, diff_time;
+    gettimeofday(&end_time, NULL);
+    timersub(&end_time, &start_time, &diff_time);
+    return (diff_time.tv_sec * 1000000) + diff_time.tv_usec;
+}
+
+static void testFormat(const nixl_reg_dlist_t &dlist, const nixlSerDes::ser_fmt_t fmt,
+                       const std::string &name) {
+    struct timeval start_time;
+    float ser_us = 0, des_us = 0;
+    std::string blob;
+    const int n = dlist.descCount();
+
+    for (int r = 0; r < reps; ++r) {
+        gettimeofday(&start_time, NULL);
+        nixlSerDes sd(fmt);
+        nixl_status_t ret = dlist.serialize(&sd);
+        assert(ret == NIXL_SUCCESS);
+        blob = sd.exportStr();
+        ser_us += elapsedUs(start_time);
+
+        gettimeofday(&start_time, NULL);
+        nixlSerDes sd2;
+        ret = sd2.importStr(blob);
+        assert(ret == NIXL_SUCCESS);
+        nixl_reg_dlist_t out(&sd2);
+        des_us += elapsedUs(start_time);
+
+        assert(out.descCount() == n);
+        assert(out[n - 1] == dlist[n - 1]);
+        (void) ret;
+    }
+
+    std::cout << "  " << name << ": " << (float) blob.size() / n << " bytes/desc, serialize "
+              << ser_us / reps / n << " us/desc, deserialize "
+              << des_us / reps / n << " us/desc\n";
+}
+
+int main()
+{
+    for (int desc_count : {1024, 50 * 1024}) {
+        nixl_reg_dlist_t dlist(DRAM_SEG, true);
+        for (int i = 0; i < desc_count; ++i)
+            dlist.addDesc(nixlBlobDesc(0x10000000 + (uintptr_t) i * 4096, 4096, 0,
+                                       std::string(meta_len, 'a' + i % 26)));
+
+        std::cout << desc_count << " descriptors, " << meta_len << " bytes of meta info\n";
+        testFormat(dlist, nixlSerDes::TAGGED_STR, "tagged string");
+        testFormat(dlist, nixlSerDes::BINARY, "binary       ");
+    }
+
+    return 0;
+}
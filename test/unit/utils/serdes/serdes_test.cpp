@@ -15,9 +15,24 @@
  * limitations under the License.
  */
 #include "serdes/serdes.h"
+#include "nixl_descriptors.h"
 #include <cassert>
 #include <iostream>
 
+// Blob descriptor list through an exported blob in the given format
+static nixl_reg_dlist_t roundTrip(const nixl_reg_dlist_t &list,
+                                  const nixlSerDes::ser_fmt_t fmt) {
+    nixlSerDes ser(fmt);
+    int ret = list.serialize(&ser);
+    assert(ret == 0);
+
+    nixlSerDes des;
+    ret = des.importStr(ser.exportStr());
+    assert(ret == 0);
+    assert(des.getFormat() == fmt);
+    return nixl_reg_dlist_t(&des);
+}
+
 int main() {
 
     int i = 0xff;
@@ -61,5 +76,63 @@ int main() {
 
     free(ptr);
 
+    // Blobs in the tagged string format stay readable
+    nixlSerDes sd3(nixlSerDes::TAGGED_STR);
+    ret = sd3.addBuf(t1, &i, sizeof(i));
+    assert(ret == 0);
+    ret = sd3.addStr(t2, s);
+    assert(ret == 0);
+
+    nixlSerDes sd4;
+    ret = sd4.importStr(sd3.exportStr());
+    assert(ret == 0);
+    assert(sd4.getFormat() == nixlSerDes::TAGGED_STR);
+
+    int j = 0;
+    assert(sd4.getBufLen(t2) == -1);
+    ret = sd4.getBuf(t1, &j, sizeof(j));
+    assert(ret == 0);
+    assert(j == 0xff);
+    assert(sd4.getStrView(t2) == "testString");
+
+    // A reset object serializes from scratch, same as a new one
+    sd3.reset();
+    ret = sd3.addStr(t2, "other");
+    assert(ret == 0);
+    ret = sd4.importStr(std::string(sd3.exportView()));
+    assert(ret == 0);
+    assert(sd4.getStr(t2) == "other");
+
+    // Blob descriptors are packed in the binary format, with meta info of any
+    // length and content, and read back the same in both formats
+    nixl_reg_dlist_t blob_list(DRAM_SEG);
+    blob_list.addDesc(nixlBlobDesc(0x1000, 4096, 0, ""));
+    blob_list.addDesc(nixlBlobDesc(0x3000, 64, 1, std::string("a\0b|c", 5)));
+    blob_list.addDesc(nixlBlobDesc(0x8000, 1 << 20, 2, std::string(70000, 'm')));
+    blob_list.addDesc(nixlBlobDesc(0x2000, 1, 0, "meta"));
+
+    for (auto fmt : {nixlSerDes::BINARY, nixlSerDes::TAGGED_STR}) {
+        nixl_reg_dlist_t loaded = roundTrip(blob_list, fmt);
+        assert(loaded == blob_list);
+        for (int k = 0; k < blob_list.descCount(); ++k)
+            assert(loaded[k].metaInfo == blob_list[k].metaInfo);
+
+        nixl_reg_dlist_t empty(VRAM_SEG);
+        assert(roundTrip(empty, fmt) == empty);
+    }
+
+    // Meta info lengths past the end of the meta info are rejected
+    nixlSerDes packed;
+    ret = blob_list.serialize(&packed);
+    assert(ret == 0);
+    std::string blob = packed.exportStr();
+    blob.resize(blob.size() - 1);
+
+    nixlSerDes truncated;
+    ret = truncated.importStr(blob);
+    assert(ret == 0);
+    assert(nixl_reg_dlist_t(&truncated).descCount() == 0);
+
+    std::cout << "serdes tests passed\n";
     return 0;
 }